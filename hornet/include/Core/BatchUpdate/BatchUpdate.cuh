@@ -41,8 +41,13 @@
 #include <thrust/device_vector.h>
 #include <thrust/sort.h>
 #include <thrust/unique.h>
+#include <thrust/reduce.h>
+#include <thrust/count.h>
+#include <thrust/copy.h>
 #include <thrust/sequence.h>
 #include <thrust/gather.h>
+#include <thrust/transform.h>
+#include <thrust/functional.h>
 #include <thrust/execution_policy.h>
 #include <Device/Primitives/CubWrapper.cuh>
 #include <Device/Primitives/BinarySearchLB.cuh>
@@ -118,6 +123,34 @@ public:
 
 };
 
+/**
+ * @brief reductions of `Hornet::upsert`: new value of every metadata field
+ *        of an existing edge from its value in the graph and in the batch
+ */
+struct UpsertReplace {
+    template <typename T>
+    __host__ __device__ __forceinline__
+    T operator()(const T&, const T& batch_value) const {
+        return batch_value;
+    }
+};
+
+struct UpsertSum {
+    template <typename T>
+    __host__ __device__ __forceinline__
+    T operator()(const T& graph_value, const T& batch_value) const {
+        return graph_value + batch_value;
+    }
+};
+
+struct UpsertMax {
+    template <typename T>
+    __host__ __device__ __forceinline__
+    T operator()(const T& graph_value, const T& batch_value) const {
+        return graph_value < batch_value ? batch_value : graph_value;
+    }
+};
+
 namespace gpu {
 
 template <typename, typename = EMPTY, typename = int> class BatchUpdate;
@@ -189,6 +222,15 @@ class BatchUpdate<
     template <typename... VertexMetaTypes>
     void overWriteEdges(hornet::HornetDevice<TypeList<VertexMetaTypes...>, TypeList<EdgeMetaTypes...>, vid_t, degree_t>& hornet_device) noexcept;
 
+    template <typename... VertexMetaTypes>
+    void compactErasedEdges(hornet::HornetDevice<TypeList<VertexMetaTypes...>, TypeList<EdgeMetaTypes...>, vid_t, degree_t>& hornet_device) noexcept;
+
+    template <typename... VertexMetaTypes>
+    void mergeBatchEdges(hornet::HornetDevice<TypeList<VertexMetaTypes...>, TypeList<EdgeMetaTypes...>, vid_t, degree_t>& hornet_device) noexcept;
+
+    template <typename... VertexMetaTypes>
+    degree_t locateBatchEdges(hornet::HornetDevice<TypeList<VertexMetaTypes...>, TypeList<EdgeMetaTypes...>, vid_t, degree_t>& hornet_device) noexcept;
+
     public :
 
     using VertexAccessT = SoAPtr<degree_t, xlib::byte_t*, degree_t, degree_t>;
@@ -213,8 +255,32 @@ class BatchUpdate<
         bool removeBatchDuplicates,
         bool removeGraphDuplicates) noexcept;
 
+    /**
+     * @brief steps of `preprocess` which do not read the graph: sort and
+     *        removal of the batch duplicates
+     */
+    void preprocess_batch(bool removeBatchDuplicates) noexcept;
+
+    /**
+     * @brief steps of `preprocess` which read the graph, after
+     *        `preprocess_batch`
+     */
+    template <typename... VertexMetaTypes>
+    void preprocess_graph(
+        hornet::HornetDevice<TypeList<VertexMetaTypes...>, TypeList<EdgeMetaTypes...>, vid_t, degree_t>& hornet_device,
+        bool removeGraphDuplicates) noexcept;
+
     void remove_batch_duplicates(bool insert = true) noexcept;
 
+    /**
+     * @brief combine the metadata of the batch duplicates with `op`, in batch
+     *        order, and keep one occurrence of every edge
+     * @details after `preprocess_batch(false)`: the batch is sorted. `op`
+     *          must be associative
+     */
+    template <typename ReduceOp>
+    void reduce_batch_duplicates(const ReduceOp& op) noexcept;
+
     CSoAData<TypeList<vid_t, vid_t, EdgeMetaTypes...>, DeviceType::DEVICE>&
     in_edge(void) noexcept;
 
@@ -246,10 +312,15 @@ class BatchUpdate<
             const degree_t reallocated_vertices_count,
             const bool is_insert);
 
+    /**
+     * @param[in] keep_sorted merge the batch edges into the sorted adjacency
+     *            lists instead of appending them
+     */
     template <typename... VertexMetaTypes>
     void
     appendBatchEdges(
-            hornet::HornetDevice<TypeList<VertexMetaTypes...>, TypeList<EdgeMetaTypes...>, vid_t, degree_t>& hornet_device) noexcept;
+            hornet::HornetDevice<TypeList<VertexMetaTypes...>, TypeList<EdgeMetaTypes...>, vid_t, degree_t>& hornet_device,
+            bool keep_sorted = false) noexcept;
 
     void print(bool sort = false) noexcept;
 
@@ -258,6 +329,37 @@ class BatchUpdate<
         hornet::HornetDevice<TypeList<VertexMetaTypes...>, TypeList<EdgeMetaTypes...>, vid_t, degree_t>& hornet_device,
         bool removeBatchDuplicates) noexcept;
 
+    /**
+     * @brief steps of `preprocess_erase` which do not read the graph
+     */
+    void preprocess_batch_erase(bool removeBatchDuplicates) noexcept;
+
+    /**
+     * @brief steps of `preprocess_erase` which read the graph, after
+     *        `preprocess_batch_erase`
+     * @param[in] keep_sorted compact the adjacency lists preserving the order
+     *            of the remaining edges
+     */
+    template <typename... VertexMetaTypes>
+    void preprocess_graph_erase(
+        hornet::HornetDevice<TypeList<VertexMetaTypes...>, TypeList<EdgeMetaTypes...>, vid_t, degree_t>& hornet_device,
+        bool removeBatchDuplicates, bool keep_sorted = false) noexcept;
+
+    /**
+     * @brief combine the metadata of the batch edges already in the graph
+     *        with `op`, then keep in the batch only the new edges
+     * @details after `reduce_batch_duplicates`: the batch is sorted and
+     *          without duplicates. Only one occurrence of an edge
+     *          duplicated in the graph is updated. The updated edges are
+     *          copied in `updated_src` and `updated_dst`, sorted
+     */
+    template <typename ReduceOp, typename... VertexMetaTypes>
+    void upsertExistingEdges(
+        hornet::HornetDevice<TypeList<VertexMetaTypes...>, TypeList<EdgeMetaTypes...>, vid_t, degree_t>& hornet_device,
+        const ReduceOp& op,
+        rmm::device_vector<vid_t>& updated_src,
+        rmm::device_vector<vid_t>& updated_dst) noexcept;
+
     template <typename... VertexMetaTypes>
     void locateEdgesToBeErased(
         hornet::HornetDevice<TypeList<VertexMetaTypes...>, TypeList<EdgeMetaTypes...>, vid_t, degree_t>& hornet_device,
@@ -359,6 +359,54 @@ remove_batch_duplicates(bool insert) noexcept {
     flip_resource();
 }
 
+//reduces the metadata field N, and the following ones, of the edges of a
+//sorted batch with the same source and destination
+template <unsigned N, unsigned SIZE>
+struct ReduceDuplicateFields {
+    template <typename degree_t, typename ReduceOp, typename... EdgeTypes>
+    static void apply(CSoAPtr<EdgeTypes...> in_ptr,
+                      CSoAPtr<EdgeTypes...> out_ptr,
+                      degree_t nE, const ReduceOp& op) {
+        auto begin_in_tuple = thrust::make_zip_iterator(thrust::make_tuple(
+                    in_ptr.template get<0>(), in_ptr.template get<1>()));
+        auto begin_out_tuple = thrust::make_zip_iterator(thrust::make_tuple(
+                    out_ptr.template get<0>(), out_ptr.template get<1>()));
+        thrust::reduce_by_key(
+                rmm::exec_policy(0),
+                begin_in_tuple, begin_in_tuple + nE,
+                in_ptr.template get<N + 2>(),
+                begin_out_tuple,
+                out_ptr.template get<N + 2>(),
+                IsSrcDstEqual(), op);
+        ReduceDuplicateFields<N + 1, SIZE>::apply(in_ptr, out_ptr, nE, op);
+    }
+};
+
+template <unsigned SIZE>
+struct ReduceDuplicateFields<SIZE, SIZE> {
+    template <typename degree_t, typename ReduceOp, typename... EdgeTypes>
+    static void apply(CSoAPtr<EdgeTypes...>, CSoAPtr<EdgeTypes...>,
+                      degree_t, const ReduceOp&) {}
+};
+
+template <typename... EdgeMetaTypes,
+    typename vid_t, typename degree_t>
+template <typename ReduceOp>
+void
+BATCH_UPDATE::
+reduce_batch_duplicates(const ReduceOp& op) noexcept {
+    if (_nE == 0) { return; }
+    auto in_ptr = in_edge().get_soa_ptr();
+    auto out_ptr = out_edge().get_soa_ptr();
+    //the sort is stable: the duplicates are reduced in batch order
+    ReduceDuplicateFields<0, sizeof...(EdgeMetaTypes)>::apply(
+            in_ptr, out_ptr, _nE, op);
+    //same unique (src, dst) of the reduction
+    remove_duplicates_edges_only(in_ptr, out_ptr, _nE, in_range(), out_range());
+    flip_resource();
+    CHECK_CUDA_ERROR
+}
+
 template <typename... EdgeMetaTypes,
     typename vid_t, typename degree_t>
 template <typename... VertexMetaTypes>
@@ -501,10 +549,30 @@ preprocess(
         bool removeBatchDuplicates,
         bool removeGraphDuplicates) noexcept {
     if (_nE == 0) { return; }
+    preprocess_batch(removeBatchDuplicates);
+    preprocess_graph(hornet_device, removeGraphDuplicates);
+}
+
+template <typename... EdgeMetaTypes,
+    typename vid_t, typename degree_t>
+void
+BATCH_UPDATE::
+preprocess_batch(bool removeBatchDuplicates) noexcept {
+    if (_nE == 0) { return; }
     sort();
     if (removeBatchDuplicates) {
         remove_batch_duplicates();
     }
+}
+
+template <typename... EdgeMetaTypes,
+    typename vid_t, typename degree_t>
+template <typename... VertexMetaTypes>
+void
+BATCH_UPDATE::
+preprocess_graph(
+        hornet::HornetDevice<TypeList<VertexMetaTypes...>, TypeList<EdgeMetaTypes...>, vid_t, degree_t>& hornet_device,
+        bool removeGraphDuplicates) noexcept {
     if (removeGraphDuplicates) {
         remove_graph_duplicates(hornet_device);
     }
@@ -519,6 +587,16 @@ preprocess_erase(
         hornet::HornetDevice<TypeList<VertexMetaTypes...>, TypeList<EdgeMetaTypes...>, vid_t, degree_t>& hornet_device,
         bool removeBatchDuplicates) noexcept {
     if (_nE == 0) { return; }
+    preprocess_batch_erase(removeBatchDuplicates);
+    preprocess_graph_erase(hornet_device, removeBatchDuplicates);
+}
+
+template <typename... EdgeMetaTypes,
+    typename vid_t, typename degree_t>
+void
+BATCH_UPDATE::
+preprocess_batch_erase(bool removeBatchDuplicates) noexcept {
+    if (_nE == 0) { return; }
     auto in_ptr = in_edge().get_soa_ptr();
     sort_edges(in_ptr, _nE);
     CHECK_CUDA_ERROR
@@ -526,9 +604,99 @@ preprocess_erase(
         remove_batch_duplicates(false);
     CHECK_CUDA_ERROR
     }
+}
+
+template <typename... EdgeMetaTypes,
+    typename vid_t, typename degree_t>
+template <typename... VertexMetaTypes>
+void
+BATCH_UPDATE::
+preprocess_graph_erase(
+        hornet::HornetDevice<TypeList<VertexMetaTypes...>, TypeList<EdgeMetaTypes...>, vid_t, degree_t>& hornet_device,
+        bool removeBatchDuplicates, bool keep_sorted) noexcept {
+    if (_nE == 0) { return; }
     locateEdgesToBeErased(hornet_device, !removeBatchDuplicates);
     CHECK_CUDA_ERROR
-    overWriteEdges(hornet_device);
+    if (keep_sorted)
+        compactErasedEdges(hornet_device);
+    else
+        overWriteEdges(hornet_device);
+    CHECK_CUDA_ERROR
+}
+
+template <typename... EdgeMetaTypes,
+    typename vid_t, typename degree_t>
+template <typename... VertexMetaTypes>
+void
+BATCH_UPDATE::
+compactErasedEdges(hornet::HornetDevice<TypeList<VertexMetaTypes...>, TypeList<EdgeMetaTypes...>, vid_t, degree_t>& hornet_device) noexcept {
+    if (_nE == 0) { return; }
+    //range[1] -> erase locations, aligned with the in_edge batch
+    rmm::device_vector<degree_t>& erase_location = range[1];
+    rmm::device_vector<degree_t>& keep_flag = duplicate_flag;
+    rmm::device_vector<degree_t>& kept_offsets = range[0];
+    rmm::device_vector<degree_t>& new_offsets = unique_degrees;
+
+    vid_t * batch_src = in_edge().get_soa_ptr().template get<0>();
+    unique_sources.resize(_nE);
+    unique_degrees.resize(_nE + 1);
+    degree_t unique_sources_count = cub_runlength.run(batch_src, _nE,
+            unique_sources.data().get(), unique_degrees.data().get());
+    unique_sources.resize(unique_sources_count);
+    batch_offsets.resize(unique_sources_count + 1);
+    thrust::copy(unique_degrees.begin(), unique_degrees.begin() + unique_sources_count,
+            batch_offsets.begin());
+    cub_prefixsum.run(batch_offsets.data().get(), unique_sources_count + 1);
+
+    //old adjacency lists of the touched vertices
+    graph_offsets.resize(unique_sources_count + 1);
+    get_vertex_degrees(hornet_device, unique_sources, graph_offsets);
+    cub_prefixsum.run(graph_offsets.data().get(), unique_sources_count + 1);
+    degree_t total_work = graph_offsets[unique_sources_count];
+    CHECK_CUDA_ERROR
+
+    keep_flag.resize(total_work + 1);
+    thrust::fill(keep_flag.begin(), keep_flag.end(), 1);
+    const int BLOCK_SIZE = 256;
+    int smem = xlib::DeviceProperty::smem_per_block<degree_t>(BLOCK_SIZE);
+    markErasedEdgesKernel<BLOCK_SIZE>
+        <<< xlib::ceil_div(_nE, smem), BLOCK_SIZE >>>(
+                batch_offsets.data().get(),
+                batch_offsets.size(),
+                erase_location.data().get(),
+                graph_offsets.data().get(),
+                keep_flag.data().get());
+    CHECK_CUDA_ERROR
+
+    //stable compaction: the kept edges keep their relative order
+    kept_offsets.resize(total_work + 1);
+    cub_prefixsum.run(keep_flag.data().get(), total_work + 1,
+            kept_offsets.data().get());
+    SoAData<TypeList<vid_t, EdgeMetaTypes...>, DeviceType::DEVICE>
+        kept_edges(total_work - _nE);
+    compactKeptEdgesKernel<BLOCK_SIZE>
+        <<< xlib::ceil_div(total_work, smem), BLOCK_SIZE >>>(
+                hornet_device,
+                unique_sources.data().get(),
+                graph_offsets.data().get(),
+                graph_offsets.size(),
+                keep_flag.data().get(),
+                kept_offsets.data().get(),
+                kept_edges.get_soa_ptr());
+    CHECK_CUDA_ERROR
+
+    new_offsets.resize(unique_sources_count + 1);
+    thrust::gather(graph_offsets.begin(), graph_offsets.end(),
+            kept_offsets.begin(), new_offsets.begin());
+    if (total_work - _nE != 0) {
+        writeBackEdgesKernel<BLOCK_SIZE>
+            <<< xlib::ceil_div(total_work - _nE, smem), BLOCK_SIZE >>>(
+                    hornet_device,
+                    unique_sources.data().get(),
+                    new_offsets.data().get(),
+                    new_offsets.size(),
+                    kept_edges.get_soa_ptr());
+    }
     CHECK_CUDA_ERROR
 }
 
@@ -644,15 +812,16 @@ markOverwriteSrcDst(
     CHECK_CUDA_ERROR
 }
 
+//range[0] -> location of the batch edges in the adjacency lists
+//unique_degrees -> 1 if the batch edge is in the graph
+//(not written if the batch sources have no edges: returns 0)
 template <typename... EdgeMetaTypes,
     typename vid_t, typename degree_t>
 template <typename... VertexMetaTypes>
-void
+degree_t
 BATCH_UPDATE::
-locateEdgesToBeErased(
-        hornet::HornetDevice<TypeList<VertexMetaTypes...>, TypeList<EdgeMetaTypes...>, vid_t, degree_t>& hornet_device, bool duplicate_edges_present) noexcept {
-    _nE = in_edge().get_num_items();
-    if (_nE == 0) { return; }
+locateBatchEdges(
+        hornet::HornetDevice<TypeList<VertexMetaTypes...>, TypeList<EdgeMetaTypes...>, vid_t, degree_t>& hornet_device) noexcept {
     auto in_ptr = in_edge().get_soa_ptr();
     vid_t * batch_src = in_ptr.template get<0>();
     vid_t * batch_dst = in_ptr.template get<1>();
@@ -669,31 +838,110 @@ locateEdgesToBeErased(
                 batch_dst_degrees,
                 graph_offsets,
                 hornet_device);
-    if (total_work == 0) { return; }
+    if (total_work == 0) { return 0; }
 
-    rmm::device_vector<degree_t>& erase_edge_location = range[0];//reuse
-    rmm::device_vector<degree_t>& batch_erase_flag = unique_degrees;//reuse
+    rmm::device_vector<degree_t>& edge_location = range[0];//reuse
+    rmm::device_vector<degree_t>& found_flag = unique_degrees;//reuse
     locate_erased_edges(hornet_device,
             unique_sources,
             batch_dst,
             batch_src_offsets,
             batch_dst_degrees,
             graph_offsets,
-            batch_erase_flag,
-            erase_edge_location,
+            found_flag,
+            edge_location,
             total_work);
+    return total_work;
+}
+
+template <typename... EdgeMetaTypes,
+    typename vid_t, typename degree_t>
+template <typename ReduceOp, typename... VertexMetaTypes>
+void
+BATCH_UPDATE::
+upsertExistingEdges(
+        hornet::HornetDevice<TypeList<VertexMetaTypes...>, TypeList<EdgeMetaTypes...>, vid_t, degree_t>& hornet_device,
+        const ReduceOp& op,
+        rmm::device_vector<vid_t>& updated_src,
+        rmm::device_vector<vid_t>& updated_dst) noexcept {
+    updated_src.clear();
+    updated_dst.clear();
+    if (_nE == 0) { return; }
+    //no edge of the batch sources: all the edges are new
+    if (locateBatchEdges(hornet_device) == 0) { return; }
+    rmm::device_vector<degree_t>& edge_location = range[0];
+    rmm::device_vector<degree_t>& found_flag = unique_degrees;
+
+    const unsigned BLOCK_SIZE = 128;
+    upsertExistingEdgesKernel<sizeof...(EdgeMetaTypes)>
+        <<< xlib::ceil_div<BLOCK_SIZE>(_nE), BLOCK_SIZE >>>(
+                hornet_device,
+                in_edge().get_soa_ptr(),
+                found_flag.data().get(),
+                edge_location.data().get(),
+                _nE,
+                op);
+    CHECK_CUDA_ERROR
+
+    auto in_ptr = in_edge().get_soa_ptr();
+    auto begin_in_tuple = thrust::make_zip_iterator(thrust::make_tuple(
+                in_ptr.template get<0>(), in_ptr.template get<1>()));
+    degree_t num_updated = thrust::count_if(rmm::exec_policy(0),
+            found_flag.begin(), found_flag.begin() + _nE,
+            thrust::identity<degree_t>());
+    updated_src.resize(num_updated);
+    updated_dst.resize(num_updated);
+    thrust::copy_if(rmm::exec_policy(0),
+            begin_in_tuple, begin_in_tuple + _nE, found_flag.begin(),
+            thrust::make_zip_iterator(thrust::make_tuple(
+                    updated_src.begin(), updated_dst.begin())),
+            thrust::identity<degree_t>());
+
+    //the new edges are inserted by the caller
+    rmm::device_vector<degree_t>& new_offsets = duplicate_flag;
+    new_offsets.resize(_nE + 1);
+    thrust::transform(rmm::exec_policy(0),
+            found_flag.begin(), found_flag.begin() + _nE,
+            new_offsets.begin(), thrust::logical_not<degree_t>());
+    new_offsets[_nE] = 0;
+    cub_prefixsum.run(new_offsets.data().get(), _nE + 1);
+    _nE = new_offsets[_nE];
+    write_unique_edges(in_edge(), out_edge(), new_offsets);
+    flip_resource();
+    CHECK_CUDA_ERROR
+}
+
+template <typename... EdgeMetaTypes,
+    typename vid_t, typename degree_t>
+template <typename... VertexMetaTypes>
+void
+BATCH_UPDATE::
+locateEdgesToBeErased(
+        hornet::HornetDevice<TypeList<VertexMetaTypes...>, TypeList<EdgeMetaTypes...>, vid_t, degree_t>& hornet_device, bool duplicate_edges_present) noexcept {
+    _nE = in_edge().get_num_items();
+    if (_nE == 0) { return; }
+    degree_t total_work = locateBatchEdges(hornet_device);
+    if (total_work == 0) { return; }
+
+    auto in_ptr = in_edge().get_soa_ptr();
+    vid_t * batch_src = in_ptr.template get<0>();
+    vid_t * batch_dst = in_ptr.template get<1>();
+    rmm::device_vector<degree_t>& erase_edge_location = range[0];//reuse
+    rmm::device_vector<degree_t>& batch_erase_flag = unique_degrees;//reuse
 
     out_edge().resize(_nE);
     auto out_ptr = out_edge().get_soa_ptr();
     vid_t * batch_src_out = out_ptr.template get<0>();
+    vid_t * batch_dst_out = out_ptr.template get<1>();
 
     rmm::device_vector<degree_t>& destination_edges = range[1];//reuse
     //realloc_sources.resize(_nE);
     destination_edges.resize(_nE);
+    //the destinations are kept aligned for the change summary
     auto ptr_tuple = thrust::make_zip_iterator(thrust::make_tuple(
-                batch_src, erase_edge_location.begin()));
+                batch_src, batch_dst, erase_edge_location.begin()));
     auto out_ptr_tuple = thrust::make_zip_iterator(thrust::make_tuple(
-                batch_src_out, destination_edges.begin()));
+                batch_src_out, batch_dst_out, destination_edges.begin()));
                 //realloc_sources.begin(), destination_edges.begin()));
     cudaStream_t stream{nullptr};
     _nE = thrust::copy_if(rmm::exec_policy(stream),
@@ -843,7 +1091,8 @@ template <typename... EdgeMetaTypes,
 template <typename... VertexMetaTypes>
 void
 BATCH_UPDATE::
-appendBatchEdges(hornet::HornetDevice<TypeList<VertexMetaTypes...>, TypeList<EdgeMetaTypes...>, vid_t, degree_t>& hornet_device) noexcept {
+appendBatchEdges(hornet::HornetDevice<TypeList<VertexMetaTypes...>, TypeList<EdgeMetaTypes...>, vid_t, degree_t>& hornet_device,
+        bool keep_sorted) noexcept {
     if (_nE == 0) { return; }
     cub_prefixsum.run(unique_degrees.data().get(), unique_degrees.size());
     degree_t total_work = unique_degrees[unique_degrees.size() - 1];
@@ -860,6 +1109,53 @@ appendBatchEdges(hornet::HornetDevice<TypeList<VertexMetaTypes...>, TypeList<Edg
                 old_degree,
                 unique_degrees.size(),
                 in_edge().get_soa_ptr().get_tail());
+    if (keep_sorted)
+        mergeBatchEdges(hornet_device);
+}
+
+template <typename... EdgeMetaTypes,
+    typename vid_t, typename degree_t>
+template <typename... VertexMetaTypes>
+void
+BATCH_UPDATE::
+mergeBatchEdges(hornet::HornetDevice<TypeList<VertexMetaTypes...>, TypeList<EdgeMetaTypes...>, vid_t, degree_t>& hornet_device) noexcept {
+    //unique_degrees -> batch offsets, graph_offsets -> old degrees: the
+    //adjacency list of each touched vertex is its old sorted list followed by
+    //its sorted batch segment
+    degree_t unique_sources_count = unique_degrees.size() - 1;
+    rmm::device_vector<degree_t>& merged_offsets = range[0];
+    merged_offsets.resize(unique_sources_count + 1);
+    cub_prefixsum.run(graph_offsets.data().get(), unique_sources_count + 1,
+            merged_offsets.data().get());
+    thrust::transform(merged_offsets.begin(), merged_offsets.end(),
+            unique_degrees.begin(), merged_offsets.begin(),
+            thrust::plus<degree_t>());
+    degree_t total_work = merged_offsets[unique_sources_count];
+    CHECK_CUDA_ERROR
+
+    SoAData<TypeList<vid_t, EdgeMetaTypes...>, DeviceType::DEVICE>
+        merged_edges(total_work);
+    const int BLOCK_SIZE = 256;
+    int smem = xlib::DeviceProperty::smem_per_block<degree_t>(BLOCK_SIZE);
+    int num_blocks = xlib::ceil_div(total_work, smem);
+    mergeBatchEdgesKernel<BLOCK_SIZE>
+        <<<num_blocks, BLOCK_SIZE>>>(
+                hornet_device,
+                unique_sources.data().get(),
+                unique_degrees.data().get(),
+                graph_offsets.data().get(),
+                merged_offsets.data().get(),
+                merged_offsets.size(),
+                merged_edges.get_soa_ptr());
+    CHECK_CUDA_ERROR
+    writeBackEdgesKernel<BLOCK_SIZE>
+        <<<num_blocks, BLOCK_SIZE>>>(
+                hornet_device,
+                unique_sources.data().get(),
+                merged_offsets.data().get(),
+                merged_offsets.size(),
+                merged_edges.get_soa_ptr());
+    CHECK_CUDA_ERROR
 }
 
 template <typename... EdgeMetaTypes,
@@ -1,4 +1,5 @@
 #include "../Conf/EdgeOperations.cuh"
+#include "SortedMerge.hpp"
 
 #include <rmm/exec_policy.hpp>
 #include <rmm/device_vector.hpp>
@@ -266,6 +267,101 @@ void appendBatchEdgesKernel(
     xlib::binarySearchLB<BLOCK_SIZE>(batch_offsets, batch_offsets_count, smem, lambda);
 }
 
+//Writes the stable merge of the old adjacency list and of the appended batch
+//segment of each vertex to merged_edges
+template <int BLOCK_SIZE, typename HornetDeviceT, typename vid_t, typename degree_t, typename SoAPtrT>
+__global__
+void mergeBatchEdgesKernel(
+        HornetDeviceT hornet,
+        const vid_t    * __restrict__ unique_src_ids,
+        const degree_t * __restrict__ batch_offsets,
+        const degree_t * __restrict__ old_degree,
+        const degree_t * __restrict__ merged_offsets,
+        const size_t merged_offsets_count,
+        SoAPtrT                          merged_edges) {
+
+    const int ITEMS_PER_BLOCK = xlib::smem_per_block<degree_t, BLOCK_SIZE>();
+    __shared__ degree_t smem[ITEMS_PER_BLOCK];
+
+    const auto& lambda = [&] (int pos, degree_t offset) {
+        auto vertex = hornet.vertex(unique_src_ids[pos]);
+        degree_t old_len   = old_degree[pos];
+        degree_t batch_len = batch_offsets[pos + 1] - batch_offsets[pos];
+        const auto& old_dst = [&] (degree_t i) {
+            return vertex.edge(i).dst_id();
+        };
+        const auto& batch_dst = [&] (degree_t i) {
+            return vertex.edge(old_len + i).dst_id();
+        };
+        degree_t source = hornet::merge_source(old_dst, old_len,
+                batch_dst, batch_len, offset);
+        merged_edges[merged_offsets[pos] + offset] = vertex.edge(source);
+    };
+    xlib::binarySearchLB<BLOCK_SIZE>(merged_offsets, merged_offsets_count, smem, lambda);
+}
+
+template <int BLOCK_SIZE, typename HornetDeviceT, typename vid_t, typename degree_t, typename SoAPtrT>
+__global__
+void writeBackEdgesKernel(
+        HornetDeviceT hornet,
+        const vid_t    * __restrict__ unique_src_ids,
+        const degree_t * __restrict__ offsets,
+        const size_t offsets_count,
+        SoAPtrT                          edges) {
+
+    const int ITEMS_PER_BLOCK = xlib::smem_per_block<degree_t, BLOCK_SIZE>();
+    __shared__ degree_t smem[ITEMS_PER_BLOCK];
+
+    const auto& lambda = [&] (int pos, degree_t offset) {
+        auto vertex = hornet.vertex(unique_src_ids[pos]);
+        vertex.edge(offset) = edges[offsets[pos] + offset];
+    };
+    xlib::binarySearchLB<BLOCK_SIZE>(offsets, offsets_count, smem, lambda);
+}
+
+template <int BLOCK_SIZE, typename degree_t>
+__global__
+void markErasedEdgesKernel(
+        const degree_t * __restrict__ batch_offsets,
+        const size_t batch_offsets_count,
+        const degree_t * __restrict__ erase_location,
+        const degree_t * __restrict__ graph_offsets,
+        degree_t * __restrict__ keep_flag) {
+
+    const int ITEMS_PER_BLOCK = xlib::smem_per_block<degree_t, BLOCK_SIZE>();
+    __shared__ degree_t smem[ITEMS_PER_BLOCK];
+
+    const auto& lambda = [&] (int pos, degree_t offset) {
+        degree_t location = erase_location[batch_offsets[pos] + offset];
+        keep_flag[graph_offsets[pos] + location] = 0;
+    };
+    xlib::binarySearchLB<BLOCK_SIZE>(batch_offsets, batch_offsets_count, smem, lambda);
+}
+
+template <int BLOCK_SIZE, typename HornetDeviceT, typename vid_t, typename degree_t, typename SoAPtrT>
+__global__
+void compactKeptEdgesKernel(
+        HornetDeviceT hornet,
+        const vid_t    * __restrict__ unique_src_ids,
+        const degree_t * __restrict__ graph_offsets,
+        const size_t graph_offsets_count,
+        const degree_t * __restrict__ keep_flag,
+        const degree_t * __restrict__ kept_offsets,
+        SoAPtrT                          kept_edges) {
+
+    const int ITEMS_PER_BLOCK = xlib::smem_per_block<degree_t, BLOCK_SIZE>();
+    __shared__ degree_t smem[ITEMS_PER_BLOCK];
+
+    const auto& lambda = [&] (int pos, degree_t offset) {
+        degree_t index = graph_offsets[pos] + offset;
+        if (keep_flag[index]) {
+            auto vertex = hornet.vertex(unique_src_ids[pos]);
+            kept_edges[kept_offsets[index]] = vertex.edge(offset);
+        }
+    };
+    xlib::binarySearchLB<BLOCK_SIZE>(graph_offsets, graph_offsets_count, smem, lambda);
+}
+
 template <int BLOCK_SIZE, typename HornetDeviceT, typename vid_t, typename degree_t>
 __global__
 void locate_erased_edges_kernel(
@@ -338,6 +434,51 @@ void locate_erased_edges(
                 erase_edge_location.data().get());
 }
 
+//combines the metadata field N, and the following ones, of a graph edge with
+//the batch edge `i`
+template <unsigned N, unsigned SIZE>
+struct UpsertFields {
+    template <typename EdgeT, typename CSoAPtrT, typename degree_t,
+              typename ReduceOp>
+    __device__ __forceinline__
+    static void apply(EdgeT& edge, CSoAPtrT batch, degree_t i,
+                      const ReduceOp& op) {
+        edge.template field<N>() = op(edge.template field<N>(),
+                                      batch.template get<N + 2>()[i]);
+        UpsertFields<N + 1, SIZE>::apply(edge, batch, i, op);
+    }
+};
+
+template <unsigned SIZE>
+struct UpsertFields<SIZE, SIZE> {
+    template <typename EdgeT, typename CSoAPtrT, typename degree_t,
+              typename ReduceOp>
+    __device__ __forceinline__
+    static void apply(EdgeT&, CSoAPtrT, degree_t, const ReduceOp&) {}
+};
+
+template <unsigned NUM_META, typename HornetDeviceT, typename CSoAPtrT,
+          typename degree_t, typename ReduceOp>
+__global__
+void upsertExistingEdgesKernel(
+        HornetDeviceT hornet,
+        CSoAPtrT batch,
+        const degree_t * __restrict__ found_flag,
+        const degree_t * __restrict__ edge_location,
+        const degree_t nE,
+        ReduceOp op) {
+    degree_t     id = blockIdx.x * blockDim.x + threadIdx.x;
+    degree_t stride = gridDim.x * blockDim.x;
+
+    //the batch has no duplicates: every graph edge has one writer
+    for (degree_t i = id; i < nE; i += stride) {
+        if (!found_flag[i]) { continue; }
+        auto vertex = hornet.vertex(batch.template get<0>()[i]);
+        auto edge   = vertex.edge(edge_location[i]);
+        UpsertFields<0, NUM_META>::apply(edge, batch, i, op);
+    }
+}
+
 template <typename vid_t, typename degree_t>
 __global__
 void markUniqueOffsetsKernel(
@@ -0,0 +1,108 @@
+/*
+ * Copyright (c) 2019, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef SORTED_MERGE_HPP
+#define SORTED_MERGE_HPP
+
+#include <HostDevice.hpp>
+
+namespace hornet {
+
+/**
+ * @brief merge path search
+ * @details number of items of the first list among the first `diagonal` items
+ *          of the stable merge of two sorted lists: on ties the items of the
+ *          first list come first. The lists are accessed through `a(i)` and
+ *          `b(i)`, so the function works on any edge layout (device blocks,
+ *          host arrays)
+ */
+template <typename KeyA, typename KeyB, typename degree_t>
+HOST_DEVICE
+degree_t merge_path_search(const KeyA& a, const degree_t a_len,
+                           const KeyB& b, const degree_t b_len,
+                           const degree_t diagonal) {
+    degree_t low  = diagonal > b_len ? diagonal - b_len : 0;
+    degree_t high = diagonal < a_len ? diagonal : a_len;
+    while (low < high) {
+        degree_t mid = low + (high - low) / 2;
+        if (a(mid) <= b(diagonal - mid - 1))
+            low = mid + 1;
+        else
+            high = mid;
+    }
+    return low;
+}
+
+/**
+ * @brief position, in the concatenation `a ++ b`, of the item at `diagonal`
+ *        in the stable merge of `a` and `b`
+ */
+template <typename KeyA, typename KeyB, typename degree_t>
+HOST_DEVICE
+degree_t merge_source(const KeyA& a, const degree_t a_len,
+                      const KeyB& b, const degree_t b_len,
+                      const degree_t diagonal) {
+    degree_t i = merge_path_search(a, a_len, b, b_len, diagonal);
+    degree_t j = diagonal - i;
+    return (i < a_len && (j >= b_len || a(i) <= b(j))) ? i : a_len + j;
+}
+
+namespace host {
+
+/**
+ * @brief host equivalent of the keep-sorted insertion: merge the sorted
+ *        `batch` into the sorted adjacency list `list`
+ * @param[in,out] list adjacency list with room for `degree + batch_size`
+ *                items
+ * @return new degree
+ */
+template <typename vid_t, typename degree_t>
+degree_t merge_sorted_adjacency(vid_t* list, degree_t degree,
+                                const vid_t* batch, degree_t batch_size) {
+    //backward merge: the free slots are at the end of the list
+    degree_t i = degree, j = batch_size, k = degree + batch_size;
+    while (j > 0) {
+        if (i > 0 && list[i - 1] > batch[j - 1])
+            list[--k] = list[--i];
+        else
+            list[--k] = batch[--j];
+    }
+    return degree + batch_size;
+}
+
+/**
+ * @brief host equivalent of the keep-sorted erase: remove from the sorted
+ *        adjacency list `list` one occurrence of every item of the sorted
+ *        `batch`, keeping the order of the remaining items
+ * @return new degree
+ */
+template <typename vid_t, typename degree_t>
+degree_t erase_sorted_adjacency(vid_t* list, degree_t degree,
+                                const vid_t* batch, degree_t batch_size) {
+    degree_t j = 0, new_degree = 0;
+    for (degree_t i = 0; i < degree; i++) {
+        while (j < batch_size && batch[j] < list[i])
+            j++;
+        if (j < batch_size && batch[j] == list[i])
+            j++;
+        else
+            list[new_degree++] = list[i];
+    }
+    return new_degree;
+}
+
+} // namespace host
+} // namespace hornet
+#endif
@@ -35,6 +35,8 @@
  */
 #ifndef COMMON_CUH
 #define COMMON_CUH
+#include <atomic>
+#include <cstddef>
 #include <tuple>
 
 namespace hornet {
@@ -46,5 +48,13 @@ using EMPTY = std::tuple<>;
 
 enum class DeviceType {DEVICE = 0, HOST = 1};
 
+/**
+ * @brief new graph version, unique among all the graph instances
+ */
+inline size_t next_graph_version() noexcept {
+    static std::atomic<size_t> version { 0 };
+    return ++version;
+}
+
 }
 #endif
@@ -0,0 +1,124 @@
+/*
+ * Copyright (c) 2019, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef DIRTY_VERTEX_SET_CUH
+#define DIRTY_VERTEX_SET_CUH
+
+#include "Conf/Common.cuh"
+#include <algorithm>
+#include <type_traits>
+#include <thrust/copy.h>
+#include <thrust/fill.h>
+#include <thrust/functional.h>
+#include <thrust/host_vector.h>
+#include <thrust/scatter.h>
+#include <thrust/execution_policy.h>
+#include <thrust/iterator/constant_iterator.h>
+#include <thrust/iterator/counting_iterator.h>
+
+#include <rmm/exec_policy.hpp>
+#include <rmm/device_vector.hpp>
+
+namespace hornet {
+
+namespace detail {
+
+template <DeviceType device_t>
+struct DirtySetPolicy {
+    static auto get(void) { return rmm::exec_policy(0); }
+};
+
+template <>
+struct DirtySetPolicy<DeviceType::HOST> {
+    static auto get(void) { return thrust::host; }
+};
+
+} // namespace detail
+
+/**
+ * @brief Vertices whose adjacency list may be out of order
+ * @details The updates mark the touched sources, `sort` visits only the
+ *          marked vertices and then clears the set. A graph built from
+ *          unknown input starts with all the vertices marked.
+ *          `device_t` is the space of the flags and of the vertex ids passed
+ *          to `mark` and returned by `compact`
+ */
+template <typename vid_t, DeviceType device_t = DeviceType::DEVICE>
+class DirtyVertexSet {
+public:
+    template <typename T>
+    using Vector = typename
+    std::conditional<
+    (device_t == DeviceType::DEVICE),
+    typename rmm::device_vector<T>,
+    typename thrust::host_vector<T>>::type;
+
+    /**
+     * @brief mark the vertices `ids`, all smaller than `nV`
+     */
+    void mark(const vid_t* ids, vid_t count, vid_t nV) {
+        if (_all || count == 0) { return; }
+        if (static_cast<vid_t>(_flags.size()) < nV)
+            _flags.resize(nV, false);
+        thrust::scatter(detail::DirtySetPolicy<device_t>::get(),
+                thrust::make_constant_iterator(true),
+                thrust::make_constant_iterator(true) + count,
+                ids, _flags.begin());
+        _num_marks += count;
+    }
+
+    void mark_all(void) noexcept {
+        _all = true;
+    }
+
+    void clear(void) {
+        if (_num_marks != 0)
+            thrust::fill(_flags.begin(), _flags.end(), false);
+        _all       = false;
+        _num_marks = 0;
+    }
+
+    bool is_all(void) const noexcept {
+        return _all;
+    }
+
+    bool empty(void) const noexcept {
+        return !_all && _num_marks == 0;
+    }
+
+    /**
+     * @brief marked vertices smaller than `nV`, in increasing order
+     * @remark not valid if `is_all()`
+     */
+    Vector<vid_t> compact(vid_t nV) const {
+        vid_t size = std::min(nV, static_cast<vid_t>(_flags.size()));
+        Vector<vid_t> ids(size);
+        auto end = thrust::copy_if(detail::DirtySetPolicy<device_t>::get(),
+                thrust::make_counting_iterator<vid_t>(0),
+                thrust::make_counting_iterator<vid_t>(size),
+                _flags.begin(), ids.begin(), thrust::identity<bool>());
+        ids.resize(end - ids.begin());
+        return ids;
+    }
+
+private:
+    Vector<bool> _flags;
+    //marks since the last clear, duplicates included
+    size_t       _num_marks { 0 };
+    bool         _all       { true };
+};
+
+} // namespace hornet
+#endif
@@ -0,0 +1,78 @@
+/*
+ * Copyright (c) 2019, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef GRAPH_CHANGE_CUH
+#define GRAPH_CHANGE_CUH
+
+#include <cstddef>
+
+namespace hornet {
+
+enum class GraphChangeType { INSERT, ERASE, RESET,
+                             INSERT_VERTICES, ERASE_VERTICES, UPDATE };
+
+/**
+ * @brief Summary of a structural change of a graph
+ * @details The device arrays are owned by the graph and are valid until its
+ *          next update, except for the batch edges which belong to the
+ *          BatchUpdate and are valid only while the subscribers are notified.
+ *          A `RESET` change replaces the whole graph: the arrays are empty.
+ *          `INSERT_VERTICES` and `ERASE_VERTICES` list the vertices in
+ *          `d_sources`; the incident edges of the erased vertices are
+ *          reported before by an `ERASE` change. An `UPDATE` change lists the
+ *          edges whose metadata changed in place (`upsert`): the degree
+ *          deltas are zero, the new edges of the upsert are reported after
+ *          by an `INSERT` change.
+ */
+template <typename vid_t, typename degree_t>
+struct GraphChange {
+    GraphChangeType type            { GraphChangeType::RESET };
+    ///graph version after the change
+    size_t          version         { 0 };
+    ///inserted, erased or updated edges
+    degree_t        num_edges       { 0 };
+    ///distinct source vertices whose adjacency list changed
+    degree_t        num_sources     { 0 };
+    ///adjacency lists moved to a different block
+    degree_t        num_reallocated { 0 };
+    ///touched source vertices, in increasing order (device)
+    const vid_t*    d_sources       { nullptr };
+    ///degree change of each touched source, negative for `ERASE` (device)
+    const degree_t* d_degree_deltas { nullptr };
+    ///edges of the batch, sorted by source (device)
+    const vid_t*    d_batch_src     { nullptr };
+    const vid_t*    d_batch_dst     { nullptr };
+};
+
+/**
+ * @brief Interface of the objects notified after every structural change of
+ *        a graph (`insert`, `erase`, `upsert`, `reset`)
+ * @details `graphChanged` runs in the thread which applied the change, after
+ *          the graph released its update lock: it may take snapshots, update
+ *          the graph or (un)subscribe. An update invalidates the arrays of
+ *          `change`, also for the subscribers notified after this one: copy
+ *          what is needed first
+ * @remark the subscriber must unsubscribe before being destroyed
+ */
+template <typename vid_t, typename degree_t>
+class GraphSubscriber {
+public:
+    virtual ~GraphSubscriber() = default;
+
+    virtual void graphChanged(const GraphChange<vid_t, degree_t>& change) = 0;
+};
+
+}
+#endif
@@ -43,6 +43,22 @@
 #include "BatchUpdate/BatchUpdate.cuh"
 #include "MemoryManager/BlockArray/BlockArray.cuh"
 #include "Static/Static.cuh"
+#include "Static/HornetStatic.cuh"
+#include "GraphChange.cuh"
+#include "DirtyVertexSet.cuh"
+#include "UpdateTrace.cuh"
+#include "HornetSnapshot.cuh"
+#include "Subgraph.cuh"
+#include "UpdatePipeline.hpp"
+#include <algorithm>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <thrust/fill.h>
+#include <thrust/functional.h>
+#include <thrust/transform.h>
+#include <vector>
 
 namespace hornet {
 namespace gpu {
@@ -76,13 +92,33 @@ public:
 
     using FlatCOO = SoAData<TypeList<vid_t, vid_t, EdgeMetaTypes...>, DeviceType::DEVICE>;
 
+    using SnapshotT = HornetSnapshot<Hornet>;
+
+    using TraceWriterT = UpdateTraceWriter<vid_t, TypeList<EdgeMetaTypes...>, degree_t>;
+
+    using SubgraphT = Subgraph<vid_t, TypeList<EdgeMetaTypes...>, degree_t>;
+
+    using HornetStaticT = HornetStatic<vid_t, TypeList<VertexMetaTypes...>, TypeList<EdgeMetaTypes...>, degree_t>;
+
 private:
+    friend class HornetSnapshot<Hornet>;
+
+    //edge block released by the update to `version`, still visible to the
+    //snapshots of older versions
+    struct RetiredBlock {
+        size_t        version;
+        degree_t      degree;
+        xlib::byte_t* edge_block_ptr;
+        degree_t      vertex_offset;
+    };
 
     static int _instance_count;
 
     vid_t    _nV { 0 };
     degree_t _nE { 0 };
     int      _id { 0 };
+    //changed by every operation which modifies the graph structure
+    size_t   _version { next_graph_version() };
 
     SoAData<
         TypeList<degree_t, xlib::byte_t*, degree_t, degree_t, VertexMetaTypes...>,
@@ -90,12 +126,82 @@ private:
 
     BlockArrayManager<TypeList<vid_t, EdgeMetaTypes...>, DeviceType::DEVICE, degree_t> _ba_manager;
 
+    GraphChange<vid_t, degree_t>                 _last_change;
+    std::vector<GraphSubscriber<vid_t, degree_t>*> _subscribers;
+    rmm::device_vector<vid_t>                    _changed_sources;
+    rmm::device_vector<degree_t>                 _degree_deltas;
+    xlib::CubRunLengthEncode<vid_t>              _change_encoder;
+    //existing edges updated by the last upsert
+    rmm::device_vector<vid_t>                    _updated_src;
+    rmm::device_vector<vid_t>                    _updated_dst;
+    rmm::device_vector<vid_t>                    _updated_sources;
+    rmm::device_vector<degree_t>                 _updated_deltas;
+    //lock order: _update_mutex, _snapshot_mutex
+    std::mutex                                   _update_mutex;
+    mutable std::mutex                           _snapshot_mutex;
+    std::multiset<size_t>                        _snapshot_versions;
+    std::vector<RetiredBlock>                    _retired_blocks;
+    //erased vertex ids, reused by insert_vertices
+    std::set<vid_t>                              _free_vertices;
+    bool                                         _keep_sorted { false };
+    //adjacency lists changed since the last sort
+    DirtyVertexSet<vid_t>                        _dirty_vertices;
+    TraceWriterT*                                _trace_writer { nullptr };
+    //declared last: pending updates are applied before the graph is destroyed
+    std::unique_ptr<UpdatePipeline>              _update_pipeline;
+
     void initialize(HInitT& h_init) noexcept;
 
-    void reallocate_vertices(gpu::BatchUpdate<vid_t, TypeList<EdgeMetaTypes...>, degree_t>& batch, const bool is_insert);
+    void record_change(gpu::BatchUpdate<vid_t, TypeList<EdgeMetaTypes...>, degree_t>& batch, GraphChangeType type, degree_t num_reallocated);
+
+    GraphChange<vid_t, degree_t> record_update_change(void);
+
+    void notify_subscribers(const GraphChange<vid_t, degree_t>& change);
+
+    degree_t reallocate_vertices(gpu::BatchUpdate<vid_t, TypeList<EdgeMetaTypes...>, degree_t>& batch, const bool is_insert);
 
     void appendBatchEdges(gpu::BatchUpdate<vid_t, TypeList<EdgeMetaTypes...>, degree_t>& batch);
 
+    void apply_insert(gpu::BatchUpdate<vid_t, TypeList<EdgeMetaTypes...>, degree_t>& batch, bool removeGraphDuplicates);
+
+    void apply_erase(gpu::BatchUpdate<vid_t, TypeList<EdgeMetaTypes...>, degree_t>& batch, bool removeBatchDuplicates);
+
+    template <typename ReduceOp>
+    void apply_upsert(gpu::BatchUpdate<vid_t, TypeList<EdgeMetaTypes...>, degree_t>& batch, const ReduceOp& op);
+
+    template <typename PrepareFunction, typename ApplyFunction>
+    std::shared_future<size_t> submit_update(cudaStream_t stream, PrepareFunction prepare, ApplyFunction apply);
+
+    bool has_snapshots(void) const;
+
+    void release_snapshot(size_t version);
+
+    void retire_block(degree_t degree, xlib::byte_t* edge_block_ptr, degree_t vertex_offset);
+
+    void reclaim_blocks(void);
+
+    void copy_on_write(gpu::BatchUpdate<vid_t, TypeList<EdgeMetaTypes...>, degree_t>& batch);
+
+    void copy_on_write(vid_t* d_sources, degree_t num_sources);
+
+    template <typename Predicate>
+    degree_t apply_erase_if(const Predicate& pred);
+
+    degree_t shrink_vertices(vid_t* d_sources, degree_t* d_num_erased, degree_t num_sources);
+
+    template <typename Predicate>
+    SubgraphT extract_subgraph(const Predicate& erase_pred, const bool* d_member, bool relabel);
+
+    void resize_vertex_data(vid_t capacity);
+
+    void record_vertex_change(const std::vector<vid_t>& ids, GraphChangeType type);
+
+    void sort_all(void);
+
+    void record_update(gpu::BatchUpdate<vid_t, TypeList<EdgeMetaTypes...>, degree_t>& batch, TraceOp op, bool removeBatchDuplicates, bool removeGraphDuplicates);
+
+    void sort_dirty(void);
+
 public:
 
     Hornet(void) noexcept;
@@ -108,12 +214,193 @@ public:
 
     void erase(gpu::BatchUpdate<vid_t, TypeList<EdgeMetaTypes...>, degree_t>& batch, bool removeBatchDuplicates = false);
 
+    /**
+     * @brief insert the new edges of the batch and update the metadata of
+     *        the edges already in the graph in place
+     * @details every metadata field of an existing edge becomes
+     *          `op(graph value, batch value)` (`UpsertReplace`, `UpsertSum`,
+     *          `UpsertMax` or a user functor), without reallocating its
+     *          adjacency list. The batch duplicates are combined with `op` in
+     *          batch order, as consecutive upserts: `op` must be associative.
+     *          The subscribers are notified of an `UPDATE` change for the
+     *          existing edges, then of an `INSERT` change for the new ones
+     * @warning the upserts cannot be recorded: calling it while
+     *          `record_updates` is active is a fatal error
+     */
+    template <typename ReduceOp = UpsertReplace>
+    void upsert(gpu::BatchUpdate<vid_t, TypeList<EdgeMetaTypes...>, degree_t>& batch, const ReduceOp& op = ReduceOp());
+
+    /**
+     * @brief erase the edges whose timestamp, the edge metadata field `N`,
+     *        is smaller than `time` (sliding window)
+     * @details no erase batch: the adjacency lists are scanned and compacted
+     *          in place, keeping the order of the other edges, and the
+     *          vertices left with at most half of their block move to a
+     *          smaller one. The subscribers receive an `ERASE` change with
+     *          the expired edges
+     * @return number of erased edges
+     * @warning the expiry cannot be recorded: calling it while
+     *          `record_updates` is active is a fatal error
+     */
+    template <unsigned N = 0>
+    degree_t expire_before(typename xlib::SelectType<N, EdgeMetaTypes...>::type time);
+
+    /**
+     * @brief erase the edges for which `pred(vertex, edge)` is true
+     * @details `pred` is a device functor
+     *          `__device__ bool operator()(Vertex& vertex, Edge& edge)`,
+     *          captured by value as the operators of the algorithms. Same
+     *          in-place compaction and reallocation of `expire_before`
+     * @return number of erased edges
+     * @warning the erasure cannot be recorded: calling it while
+     *          `record_updates` is active is a fatal error
+     */
+    template <typename Predicate>
+    degree_t erase_if(const Predicate& pred);
+
+    /**
+     * @brief subgraph induced by the vertices `h_ids` (host array): the
+     *        edges with both endpoints in the set
+     * @param[in] relabel dense ids in increasing order of the original ids,
+     *            the original ids and `nV()` vertices otherwise
+     * @warning an id out of range is a fatal error; the duplicates are
+     *          ignored
+     */
+    SubgraphT induced_subgraph(const vid_t* h_ids, int count, bool relabel = true);
+
+    /**
+     * @brief subgraph with the edges for which `pred(vertex, edge)` is true,
+     *        same functor of `erase_if`
+     * @param[in] relabel dense ids for the vertices incident to the selected
+     *            edges
+     */
+    template <typename Predicate>
+    SubgraphT filter_edges(const Predicate& pred, bool relabel = false);
+
+    /**
+     * @brief asynchronous `insert`
+     * @details the update starts after the work already queued on `stream`
+     *          (e.g. the copy of the batch). The graph-independent
+     *          preprocessing of the batch (sort, batch duplicates) runs while
+     *          the previous update is applied; the updates are applied in
+     *          submission order. The future holds the graph version after the
+     *          update.
+     * @warning `batch` must stay alive until the future is ready. The graph
+     *          (nE, device(), traversals, ...) can be read only after
+     *          `wait_updates()`, or after the future of the last update
+     */
+    std::shared_future<size_t> insert_async(gpu::BatchUpdate<vid_t, TypeList<EdgeMetaTypes...>, degree_t>& batch, cudaStream_t stream = 0, bool removeBatchDuplicates = false, bool removeGraphDuplicates = false);
+
+    /**
+     * @brief asynchronous `erase`, same ordering as `insert_async`
+     */
+    std::shared_future<size_t> erase_async(gpu::BatchUpdate<vid_t, TypeList<EdgeMetaTypes...>, degree_t>& batch, cudaStream_t stream = 0, bool removeBatchDuplicates = false);
+
+    /**
+     * @brief consistency point: block until all asynchronous updates have
+     *        been applied
+     * @remark called by the synchronous `insert`, `erase` and `reset`
+     */
+    void wait_updates(void);
+
+    /**
+     * @brief number of asynchronous updates not yet applied
+     */
+    int pending_updates(void) const;
+
+    /**
+     * @brief read-only view of the current version of the graph
+     * @details the snapshot costs a copy of the vertex data; the edge blocks
+     *          are shared until an update would overwrite them. Algorithms
+     *          can run on the snapshot while `insert` and `erase` (also
+     *          asynchronous) modify the graph
+     * @warning `reset` and `sort` are not allowed while snapshots are alive
+     */
+    SnapshotT snapshot(void);
+
+    int num_snapshots(void) const;
+
+    /**
+     * @brief number of edge blocks kept alive by the snapshots
+     */
+    int num_retired_blocks(void) const;
+
+    /**
+     * @brief add `count` vertices without edges
+     * @details the ids of the erased vertices are reused first, in
+     *          increasing order; the other ids extend `nV()`. The vertex data
+     *          (including the metadata) grows geometrically and the new
+     *          vertices are zero
+     * @return the ids of the new vertices
+     */
+    std::vector<vid_t> insert_vertices(int count);
+
+    /**
+     * @brief erase the vertices `h_ids` (host array) and their incident edges
+     * @details the ids are reused by `insert_vertices`. `nV()` decreases only
+     *          when the erased ids are at the end of the id range, until then
+     *          the erased vertices are isolated
+     * @warning an id out of range or already erased is a fatal error; the
+     *          duplicates are ignored
+     */
+    void erase_vertices(const vid_t* h_ids, int count);
+
+    /**
+     * @brief allocate the vertex data for `capacity` vertices
+     */
+    void reserve_vertices(vid_t capacity);
+
+    vid_t vertex_capacity(void) noexcept;
+
+    int num_free_vertices(void) const noexcept;
+
     void print(void);
 
     degree_t nV(void) const noexcept;
 
     degree_t nE(void) const noexcept;
 
+    /**
+     * @brief device memory allocated for the vertices and the edges
+     */
+    size_t memory_bytes(void) noexcept;
+
+    /**
+     * @brief structural version of the graph
+     * @details increased by `insert`, `erase` and `reset`. Versions are
+     *          unique among all the graphs, so data derived from the adjacency
+     *          lists (e.g. degree prefix sums) and tagged with the version is
+     *          still valid while `version()` returns the same value
+     */
+    size_t version(void) const noexcept;
+
+    /**
+     * @brief summary of the last `insert`, `erase` or `reset`
+     */
+    const GraphChange<vid_t, degree_t>& last_change(void) const noexcept;
+
+    /**
+     * @brief `subscriber` is notified after every structural change, in
+     *        subscription order
+     * @details the notification runs outside the update lock (see
+     *          GraphSubscriber): the subscriber may update the graph, but the
+     *          subscribers of an asynchronous update run in the apply stage
+     *          and must not wait for the pending updates
+     */
+    void subscribe(GraphSubscriber<vid_t, degree_t>* subscriber);
+
+    void unsubscribe(GraphSubscriber<vid_t, degree_t>* subscriber);
+
+    /**
+     * @brief write every batch received by `insert` and `erase` (and the
+     *        asynchronous versions) to `writer`, in application order and
+     *        before the preprocessing. `nullptr` stops the recording
+     * @remark the vertex operations are not recorded, only the edges they
+     *         erase. `upsert`, `erase_if` and `expire_before` cannot be
+     *         recorded and are rejected while recording
+     */
+    void record_updates(TraceWriterT* writer);
+
     HornetDeviceT device(void) noexcept;
 
     vid_t max_degree_id(void) const noexcept;
@@ -126,9 +413,34 @@ public:
     COO<DeviceType::DEVICE, vid_t, TypeList<EdgeMetaTypes...>, degree_t>
     getCOO(bool sortAdjacencyList = false) ;
 
+    /**
+     * @brief compact immutable copy of the graph with the vertex metadata,
+     *        built on the device from the edge blocks (no host round trip)
+     * @param[in] sort sort the adjacency lists of the copy by destination,
+     *            skipped if no update changed their order since the last sort
+     */
+    HornetStaticT freeze(bool sort = false);
+
     void reset(HInitT& h_init) noexcept;
 
+    /**
+     * @brief sort the adjacency lists by destination
+     * @details only the adjacency lists changed by `insert` and `erase` since
+     *          the last sort are visited, all of them after the construction
+     *          and `reset`. Waits for the pending asynchronous updates
+     */
     void sort(void);
+
+    /**
+     * @brief keep the adjacency lists sorted by destination across updates
+     * @details enabling the mode sorts the graph once. Afterwards `insert`
+     *          merges the sorted batch into the touched adjacency lists
+     *          (merge path) and `erase` compacts them preserving the order,
+     *          so the cost depends on the touched vertices, not on `nE()`
+     */
+    void set_keep_sorted(bool keep_sorted);
+
+    bool is_keep_sorted(void) const noexcept;
 };
 
 #define HORNET Hornet<vid_t,\
@@ -150,5 +462,9 @@ class IsHornet<gpu::Hornet<V, VM, EM, D>> : public std::true_type {};
 #include "Core/HornetOperations/HornetInsert.i.cuh"
 #include "Core/HornetOperations/HornetQuery.i.cuh"
 #include "Core/HornetOperations/HornetSort.i.cuh"
+#include "Core/HornetOperations/HornetSnapshot.i.cuh"
+#include "Core/HornetOperations/HornetVertex.i.cuh"
+#include "Core/HornetOperations/HornetFilter.i.cuh"
+#include "Core/HornetOperations/HornetFreeze.i.cuh"
 
 #endif
@@ -33,6 +33,7 @@
  * POSSIBILITY OF SUCH DAMAGE.
  * </blockquote>}
  */
+#include <Host/Basic.hpp>   //ERROR
 #include "../SoA/SoAData.cuh"
 
 #include <rmm/exec_policy.hpp>
@@ -191,6 +192,52 @@ nE(void) const noexcept {
     return _nE;
 }
 
+template <typename... VertexMetaTypes, typename... EdgeMetaTypes,
+    typename vid_t, typename degree_t>
+size_t
+HORNET::
+memory_bytes(void) noexcept {
+    return static_cast<size_t>(vertex_capacity()) *
+           xlib::SizeSum<degree_t, xlib::byte_t*, degree_t, degree_t,
+                         VertexMetaTypes...>::value +
+           _ba_manager.mem_size();
+}
+
+template <typename... VertexMetaTypes, typename... EdgeMetaTypes,
+    typename vid_t, typename degree_t>
+size_t
+HORNET::
+version(void) const noexcept {
+    return _version;
+}
+
+template <typename... VertexMetaTypes, typename... EdgeMetaTypes,
+    typename vid_t, typename degree_t>
+const GraphChange<vid_t, degree_t>&
+HORNET::
+last_change(void) const noexcept {
+    return _last_change;
+}
+
+template <typename... VertexMetaTypes, typename... EdgeMetaTypes,
+    typename vid_t, typename degree_t>
+void
+HORNET::
+subscribe(GraphSubscriber<vid_t, degree_t>* subscriber) {
+    if (std::find(_subscribers.begin(), _subscribers.end(), subscriber) ==
+            _subscribers.end())
+        _subscribers.push_back(subscriber);
+}
+
+template <typename... VertexMetaTypes, typename... EdgeMetaTypes,
+    typename vid_t, typename degree_t>
+void
+HORNET::
+unsubscribe(GraphSubscriber<vid_t, degree_t>* subscriber) {
+    _subscribers.erase(std::remove(_subscribers.begin(), _subscribers.end(),
+                                   subscriber), _subscribers.end());
+}
+
 template <typename... VertexMetaTypes, typename... EdgeMetaTypes,
     typename vid_t, typename degree_t>
 void
@@ -199,14 +246,30 @@ reset(HornetInit<
     vid_t,
     TypeList<VertexMetaTypes...>,
     TypeList<EdgeMetaTypes...>, degree_t>& h_init) noexcept {
+  wait_updates();
+  //the snapshots read the blocks released by reset
+  if (has_snapshots())
+    ERROR("Hornet::reset() with live snapshots")
   _nV = h_init.nV();
   _nE = h_init.nE();
+  _version = next_graph_version();
   SoAData<
       TypeList<degree_t, xlib::byte_t*, degree_t, degree_t, VertexMetaTypes...>,
       DeviceType::DEVICE> new_vertex_data(h_init.nV());
   _vertex_data = std::move(new_vertex_data);
   _ba_manager.removeAll();
+  _free_vertices.clear();
   initialize(h_init);
+  _dirty_vertices.clear();
+  _dirty_vertices.mark_all();
+  if (_keep_sorted)
+    sort();
+
+  GraphChange<vid_t, degree_t> change;
+  change.type    = GraphChangeType::RESET;
+  change.version = _version;
+  _last_change = change;
+  notify_subscribers(change);
 }
 
 }
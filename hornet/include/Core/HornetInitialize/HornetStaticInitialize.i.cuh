@@ -24,6 +24,16 @@ HornetStatic(HORNETSTATIC::HInitT& h_init, DeviceType h_init_type) noexcept :
     initialize(h_init, h_init_type);
 }
 
+template <typename... VertexMetaTypes, typename... EdgeMetaTypes,
+    typename vid_t, typename degree_t>
+HORNETSTATIC::
+HornetStatic(vid_t nV, degree_t nE) noexcept :
+    _nV(nV),
+    _nE(nE),
+    _id(_instance_count++),
+    _vertex_data(nV),
+    _edge_data(xlib::upper_approx<512>(nE)) {}
+
 template <typename... VertexMetaTypes, typename... EdgeMetaTypes,
     typename vid_t, typename degree_t>
 void
@@ -84,6 +94,14 @@ nE(void) const noexcept {
     return _nE;
 }
 
+template <typename... VertexMetaTypes, typename... EdgeMetaTypes,
+    typename vid_t, typename degree_t>
+size_t
+HORNETSTATIC::
+version(void) const noexcept {
+    return _version;
+}
+
 template <typename... VertexMetaTypes, typename... EdgeMetaTypes,
     typename vid_t, typename degree_t>
 HORNETSTATIC::HornetDeviceT
@@ -0,0 +1,538 @@
+/*
+ * Copyright (c) 2019, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <Host/Basic.hpp>   //ERROR
+#include <thrust/copy.h>
+#include <thrust/gather.h>
+#include <thrust/scan.h>
+#include <thrust/scatter.h>
+#include <thrust/iterator/constant_iterator.h>
+#include <thrust/iterator/counting_iterator.h>
+#include <thrust/iterator/permutation_iterator.h>
+#include <thrust/iterator/zip_iterator.h>
+#include "../SoA/SoAData.cuh"
+
+#include <rmm/exec_policy.hpp>
+#include <rmm/device_vector.hpp>
+
+namespace hornet {
+
+///edge metadata field `N` (timestamp) smaller than `time`
+template <unsigned N, typename T>
+struct ExpiredEdge {
+    T time;
+
+    template <typename Vertex, typename Edge>
+    __device__ __forceinline__
+    bool operator()(Vertex& vertex, Edge& edge) const {
+        return edge.template field<N>() < time;
+    }
+};
+
+namespace gpu {
+
+//erase predicates of the subgraph extraction
+
+template <typename Predicate>
+struct NotSelected {
+    Predicate pred;
+
+    template <typename Vertex, typename Edge>
+    __device__ __forceinline__
+    bool operator()(Vertex& vertex, Edge& edge) {
+        return !pred(vertex, edge);
+    }
+};
+
+struct OutsideVertexSet {
+    const bool* d_member;
+
+    template <typename Vertex, typename Edge>
+    __device__ __forceinline__
+    bool operator()(Vertex& vertex, Edge& edge) const {
+        return !d_member[vertex.id()] || !d_member[edge.dst_id()];
+    }
+};
+
+template <int BLOCK_SIZE, typename HornetDeviceT, typename degree_t,
+          typename Predicate>
+__global__
+void markKeptEdgesKernel(
+        HornetDeviceT hornet,
+        const degree_t* __restrict__ offsets,
+        Predicate pred,
+        degree_t* __restrict__ keep_flag) {
+    const int ITEMS_PER_BLOCK = xlib::smem_per_block<degree_t, BLOCK_SIZE>();
+    __shared__ degree_t smem[ITEMS_PER_BLOCK];
+
+    const auto& lambda = [&] (int pos, degree_t eOffset) {
+        auto vertex = hornet.vertex(pos);
+        auto edge   = vertex.edge(eOffset);
+        keep_flag[offsets[pos] + eOffset] = !pred(vertex, edge);
+    };
+    xlib::binarySearchLB<BLOCK_SIZE>(offsets, hornet.nV() + 1, smem, lambda);
+}
+
+template <typename vid_t, typename degree_t>
+__global__
+void countErasedEdgesKernel(
+        const degree_t* __restrict__ offsets,
+        const degree_t* __restrict__ kept_offsets,
+        const vid_t nV,
+        degree_t* __restrict__ num_erased) {
+    int     id = blockIdx.x * blockDim.x + threadIdx.x;
+    int stride = gridDim.x * blockDim.x;
+
+    for (auto v = id; v < nV; v += stride) {
+        degree_t degree = offsets[v + 1] - offsets[v];
+        num_erased[v]   = degree - (kept_offsets[offsets[v + 1]] -
+                                    kept_offsets[offsets[v]]);
+    }
+}
+
+template <typename vid_t, typename degree_t>
+__global__
+void touchedDegreesKernel(
+        const vid_t* __restrict__ sources,
+        const degree_t* __restrict__ num_erased,
+        const degree_t num_sources,
+        const degree_t* __restrict__ offsets,
+        degree_t* __restrict__ old_degrees,
+        degree_t* __restrict__ new_degrees) {
+    int     id = blockIdx.x * blockDim.x + threadIdx.x;
+    int stride = gridDim.x * blockDim.x;
+
+    for (auto i = id; i < num_sources; i += stride) {
+        vid_t src      = sources[i];
+        old_degrees[i] = offsets[src + 1] - offsets[src];
+        new_degrees[i] = old_degrees[i] - num_erased[i];
+    }
+}
+
+//kept edges of the touched vertices -> kept_edges (stable),
+//erased edges -> erased_src, erased_dst (sorted by source)
+template <int BLOCK_SIZE, typename HornetDeviceT, typename vid_t,
+          typename degree_t, typename SoAPtrT>
+__global__
+void compactFilteredEdgesKernel(
+        HornetDeviceT hornet,
+        const vid_t* __restrict__ sources,
+        const degree_t* __restrict__ old_offsets,
+        const size_t old_offsets_count,
+        const degree_t* __restrict__ new_offsets,
+        const degree_t* __restrict__ erased_offsets,
+        const degree_t* __restrict__ offsets,
+        const degree_t* __restrict__ keep_flag,
+        const degree_t* __restrict__ kept_offsets,
+        SoAPtrT kept_edges,
+        vid_t* __restrict__ erased_src,
+        vid_t* __restrict__ erased_dst) {
+    const int ITEMS_PER_BLOCK = xlib::smem_per_block<degree_t, BLOCK_SIZE>();
+    __shared__ degree_t smem[ITEMS_PER_BLOCK];
+
+    const auto& lambda = [&] (int pos, degree_t eOffset) {
+        vid_t    src   = sources[pos];
+        degree_t first = offsets[src];
+        degree_t kept  = kept_offsets[first + eOffset] - kept_offsets[first];
+        auto vertex = hornet.vertex(src);
+        if (keep_flag[first + eOffset]) {
+            kept_edges[new_offsets[pos] + kept] = vertex.edge(eOffset);
+        } else {
+            degree_t index = erased_offsets[pos] + eOffset - kept;
+            erased_src[index] = src;
+            erased_dst[index] = vertex.edge(eOffset).dst_id();
+        }
+    };
+    xlib::binarySearchLB<BLOCK_SIZE>(old_offsets, old_offsets_count, smem,
+                                     lambda);
+}
+
+template <int BLOCK_SIZE, typename HornetDeviceT, typename vid_t,
+          typename degree_t>
+__global__
+void markIncidentVerticesKernel(
+        HornetDeviceT hornet,
+        const degree_t* __restrict__ offsets,
+        const degree_t* __restrict__ keep_flag,
+        vid_t* __restrict__ is_incident) {
+    const int ITEMS_PER_BLOCK = xlib::smem_per_block<degree_t, BLOCK_SIZE>();
+    __shared__ degree_t smem[ITEMS_PER_BLOCK];
+
+    const auto& lambda = [&] (int pos, degree_t eOffset) {
+        if (!keep_flag[offsets[pos] + eOffset])
+            return;
+        is_incident[pos] = 1;
+        is_incident[hornet.vertex(pos).edge(eOffset).dst_id()] = 1;
+    };
+    xlib::binarySearchLB<BLOCK_SIZE>(offsets, hornet.nV() + 1, smem, lambda);
+}
+
+//kept edges -> edges[kept_offsets], destinations relabeled with new_ids
+//(if not nullptr)
+template <int BLOCK_SIZE, typename HornetDeviceT, typename vid_t,
+          typename degree_t, typename SoAPtrT>
+__global__
+void extractEdgesKernel(
+        HornetDeviceT hornet,
+        const degree_t* __restrict__ offsets,
+        const degree_t* __restrict__ keep_flag,
+        const degree_t* __restrict__ kept_offsets,
+        const vid_t* __restrict__ new_ids,
+        SoAPtrT edges) {
+    const int ITEMS_PER_BLOCK = xlib::smem_per_block<degree_t, BLOCK_SIZE>();
+    __shared__ degree_t smem[ITEMS_PER_BLOCK];
+
+    const auto& lambda = [&] (int pos, degree_t eOffset) {
+        degree_t index = offsets[pos] + eOffset;
+        if (!keep_flag[index])
+            return;
+        auto edge = hornet.vertex(pos).edge(eOffset);
+        edges[kept_offsets[index]] = edge;
+        if (new_ids != nullptr) {
+            edges.template get<0>()[kept_offsets[index]] =
+                new_ids[edge.dst_id()];
+        }
+    };
+    xlib::binarySearchLB<BLOCK_SIZE>(offsets, hornet.nV() + 1, smem, lambda);
+}
+
+template <typename... VertexMetaTypes, typename... EdgeMetaTypes,
+    typename vid_t, typename degree_t>
+template <unsigned N>
+degree_t
+HORNET::
+expire_before(typename xlib::SelectType<N, EdgeMetaTypes...>::type time) {
+    using T = typename xlib::SelectType<N, EdgeMetaTypes...>::type;
+    return erase_if(ExpiredEdge<N, T> { time });
+}
+
+template <typename... VertexMetaTypes, typename... EdgeMetaTypes,
+    typename vid_t, typename degree_t>
+template <typename Predicate>
+degree_t
+HORNET::
+erase_if(const Predicate& pred) {
+    //the trace has no record for the predicate: the replay would diverge
+    if (_trace_writer != nullptr)
+        ERROR("Hornet::erase_if() while recording the updates")
+    wait_updates();
+    return apply_erase_if(pred);
+}
+
+template <typename... VertexMetaTypes, typename... EdgeMetaTypes,
+    typename vid_t, typename degree_t>
+template <typename Predicate>
+degree_t
+HORNET::
+apply_erase_if(const Predicate& pred) {
+    std::unique_lock<std::mutex> lock(_update_mutex);
+    if (_nE == 0) { return 0; }
+    const int BLOCK_SIZE = 256;
+    int smem = xlib::DeviceProperty::smem_per_block<degree_t>(BLOCK_SIZE);
+
+    //offsets of the adjacency lists in the flat edge order
+    rmm::device_vector<degree_t> offsets(_nV + 1, 0);
+    auto degree_ptr = _vertex_data.get_soa_ptr().template get<0>();
+    thrust::copy(rmm::exec_policy(0), degree_ptr, degree_ptr + _nV,
+            offsets.begin());
+    thrust::exclusive_scan(rmm::exec_policy(0), offsets.begin(),
+            offsets.end(), offsets.begin());
+
+    rmm::device_vector<degree_t> keep_flag(_nE + 1, 0);
+    markKeptEdgesKernel<BLOCK_SIZE>
+        <<< xlib::ceil_div(_nE, smem), BLOCK_SIZE >>>
+        (device(), offsets.data().get(), pred, keep_flag.data().get());
+    CHECK_CUDA_ERROR
+    rmm::device_vector<degree_t> kept_offsets(_nE + 1);
+    thrust::exclusive_scan(rmm::exec_policy(0), keep_flag.begin(),
+            keep_flag.end(), kept_offsets.begin());
+    degree_t num_erased = _nE - kept_offsets[_nE];
+    if (num_erased == 0) { return 0; }
+
+    //touched vertices: the adjacency lists with at least one erased edge
+    rmm::device_vector<degree_t> vertex_erased(_nV);
+    countErasedEdgesKernel
+        <<< xlib::ceil_div<BLOCK_SIZE>(_nV), BLOCK_SIZE >>>
+        (offsets.data().get(), kept_offsets.data().get(), _nV,
+         vertex_erased.data().get());
+    _changed_sources.resize(_nV);
+    _degree_deltas.resize(_nV);
+    rmm::device_vector<degree_t> touched_erased(_nV);
+    auto in_tuple  = thrust::make_zip_iterator(thrust::make_tuple(
+                thrust::make_counting_iterator<vid_t>(0),
+                vertex_erased.begin()));
+    auto out_tuple = thrust::make_zip_iterator(thrust::make_tuple(
+                _changed_sources.begin(), touched_erased.begin()));
+    degree_t num_sources = thrust::copy_if(rmm::exec_policy(0),
+            in_tuple, in_tuple + _nV, vertex_erased.begin(), out_tuple,
+            thrust::identity<degree_t>()) - out_tuple;
+    vid_t* sources = _changed_sources.data().get();
+    CHECK_CUDA_ERROR
+
+    _version = next_graph_version();
+    //the adjacency lists are compacted in place: the snapshots keep the
+    //old blocks
+    if (has_snapshots())
+        copy_on_write(sources, num_sources);
+
+    rmm::device_vector<degree_t> old_offsets(num_sources + 1, 0);
+    rmm::device_vector<degree_t> new_offsets(num_sources + 1, 0);
+    touchedDegreesKernel
+        <<< xlib::ceil_div<BLOCK_SIZE>(num_sources), BLOCK_SIZE >>>
+        (sources, touched_erased.data().get(), num_sources,
+         offsets.data().get(), old_offsets.data().get(),
+         new_offsets.data().get());
+    thrust::transform(rmm::exec_policy(0), touched_erased.begin(),
+            touched_erased.begin() + num_sources, _degree_deltas.begin(),
+            thrust::negate<degree_t>());
+    rmm::device_vector<degree_t> erased_offsets(num_sources + 1, 0);
+    thrust::copy(rmm::exec_policy(0), touched_erased.begin(),
+            touched_erased.begin() + num_sources, erased_offsets.begin());
+    thrust::exclusive_scan(rmm::exec_policy(0), erased_offsets.begin(),
+            erased_offsets.end(), erased_offsets.begin());
+    thrust::exclusive_scan(rmm::exec_policy(0), old_offsets.begin(),
+            old_offsets.end(), old_offsets.begin());
+    thrust::exclusive_scan(rmm::exec_policy(0), new_offsets.begin(),
+            new_offsets.end(), new_offsets.begin());
+    degree_t total_work = old_offsets[num_sources];
+    degree_t total_kept = total_work - num_erased;
+
+    //stable compaction: the kept edges keep their relative order
+    SoAData<TypeList<vid_t, EdgeMetaTypes...>, DeviceType::DEVICE>
+        kept_edges(total_kept);
+    rmm::device_vector<vid_t> erased_src(num_erased);
+    rmm::device_vector<vid_t> erased_dst(num_erased);
+    compactFilteredEdgesKernel<BLOCK_SIZE>
+        <<< xlib::ceil_div(total_work, smem), BLOCK_SIZE >>>
+        (device(), sources, old_offsets.data().get(), old_offsets.size(),
+         new_offsets.data().get(), erased_offsets.data().get(),
+         offsets.data().get(), keep_flag.data().get(),
+         kept_offsets.data().get(), kept_edges.get_soa_ptr(),
+         erased_src.data().get(), erased_dst.data().get());
+    CHECK_CUDA_ERROR
+    if (total_kept != 0) {
+        writeBackEdgesKernel<BLOCK_SIZE>
+            <<< xlib::ceil_div(total_kept, smem), BLOCK_SIZE >>>
+            (device(), sources, new_offsets.data().get(), new_offsets.size(),
+             kept_edges.get_soa_ptr());
+        CHECK_CUDA_ERROR
+    }
+
+    auto num_reallocated = shrink_vertices(sources,
+            touched_erased.data().get(), num_sources);
+    _nE -= num_erased;
+
+    _last_change = GraphChange<vid_t, degree_t>();
+    _last_change.type            = GraphChangeType::ERASE;
+    _last_change.version         = _version;
+    _last_change.num_edges       = num_erased;
+    _last_change.num_sources     = num_sources;
+    _last_change.num_reallocated = num_reallocated;
+    _last_change.d_sources       = sources;
+    _last_change.d_degree_deltas = _degree_deltas.data().get();
+    _last_change.d_batch_src     = erased_src.data().get();
+    _last_change.d_batch_dst     = erased_dst.data().get();
+    //the order of the adjacency lists is preserved: not marked as dirty
+    reclaim_blocks();
+    auto change = _last_change;
+    lock.unlock();
+    notify_subscribers(change);
+    return num_erased;
+}
+
+template <typename... VertexMetaTypes, typename... EdgeMetaTypes,
+    typename vid_t, typename degree_t>
+degree_t
+HORNET::
+shrink_vertices(vid_t* d_sources, degree_t* d_num_erased,
+        degree_t num_sources) {
+    using AccessTypes = TypeList<degree_t, xlib::byte_t*, degree_t, degree_t>;
+    SoAData<AccessTypes, DeviceType::DEVICE> d_old_access(num_sources);
+    SoAData<AccessTypes, DeviceType::DEVICE> d_new_access(num_sources);
+    SoAData<AccessTypes, DeviceType::HOST>   h_old_access(num_sources);
+    SoAData<AccessTypes, DeviceType::HOST>   h_new_access(num_sources);
+    rmm::device_vector<vid_t>    realloc_sources(num_sources);
+    rmm::device_vector<degree_t> realloc_count(1, 0);
+
+    //the degrees of the vertices which keep their block are set here
+    const int BLOCK_SIZE = 256;
+    buildReallocateVerticesQueue
+        <<< xlib::ceil_div<BLOCK_SIZE>(num_sources), BLOCK_SIZE >>>
+        (device(), d_sources, d_num_erased, num_sources,
+         realloc_sources.data().get(), d_old_access.get_soa_ptr(),
+         d_new_access.get_soa_ptr(), realloc_count.data().get(), false,
+         static_cast<degree_t*>(nullptr));
+    CHECK_CUDA_ERROR
+    degree_t num_reallocated = realloc_count[0];
+    if (num_reallocated == 0) { return 0; }
+    h_old_access.copy(d_old_access);
+    h_new_access.copy(d_new_access);
+
+    auto h_old = h_old_access.get_soa_ptr();
+    auto h_new = h_new_access.get_soa_ptr();
+    for (degree_t i = 0; i < num_reallocated; i++) {
+        auto new_ref = h_new[i];
+        auto access_data = _ba_manager.insert(new_ref.template get<0>());
+        new_ref.template get<1>() = access_data.edge_block_ptr;
+        new_ref.template get<2>() = access_data.vertex_offset;
+        new_ref.template get<3>() = access_data.edges_per_block;
+    }
+    d_new_access.copy(h_new_access);
+
+    rmm::device_vector<degree_t> offsets(num_reallocated + 1, 0);
+    degree_t* new_degrees = d_new_access.get_soa_ptr().template get<0>();
+    thrust::copy(rmm::exec_policy(0), new_degrees,
+            new_degrees + num_reallocated, offsets.begin());
+    thrust::exclusive_scan(rmm::exec_policy(0), offsets.begin(), offsets.end(),
+            offsets.begin());
+    degree_t total_work = offsets[num_reallocated];
+    if (total_work != 0) {
+        int smem = xlib::DeviceProperty::smem_per_block<degree_t>(BLOCK_SIZE);
+        move_adjacency_lists_kernel<BLOCK_SIZE>
+            <<< xlib::ceil_div(total_work, smem), BLOCK_SIZE >>>
+            (device(), d_old_access.get_soa_ptr(), d_new_access.get_soa_ptr(),
+             offsets.data().get(), offsets.size());
+        CHECK_CUDA_ERROR
+    }
+    set_vertex_meta_data
+        <<< xlib::ceil_div<BLOCK_SIZE>(num_reallocated), BLOCK_SIZE >>>
+        (realloc_sources.data().get(), _vertex_data.get_soa_ptr(),
+         d_new_access.get_soa_ptr(), num_reallocated);
+    CHECK_CUDA_ERROR
+
+    for (degree_t i = 0; i < num_reallocated; i++) {
+        auto old_ref = h_old[i];
+        retire_block(old_ref.template get<0>(), old_ref.template get<1>(),
+                old_ref.template get<2>());
+    }
+    return num_reallocated;
+}
+
+template <typename... VertexMetaTypes, typename... EdgeMetaTypes,
+    typename vid_t, typename degree_t>
+typename HORNET::SubgraphT
+HORNET::
+induced_subgraph(const vid_t* h_ids, int count, bool relabel) {
+    wait_updates();
+    for (int i = 0; i < count; i++) {
+        if (h_ids[i] < 0 || h_ids[i] >= _nV)
+            ERROR("induced_subgraph: vertex id out of range: ", h_ids[i])
+    }
+    rmm::device_vector<vid_t> d_ids(h_ids, h_ids + count);
+    rmm::device_vector<bool>  is_member(_nV, false);
+    thrust::scatter(rmm::exec_policy(0),
+            thrust::make_constant_iterator(true),
+            thrust::make_constant_iterator(true) + count,
+            d_ids.begin(), is_member.begin());
+    return extract_subgraph(OutsideVertexSet { is_member.data().get() },
+            is_member.data().get(), relabel);
+}
+
+template <typename... VertexMetaTypes, typename... EdgeMetaTypes,
+    typename vid_t, typename degree_t>
+template <typename Predicate>
+typename HORNET::SubgraphT
+HORNET::
+filter_edges(const Predicate& pred, bool relabel) {
+    wait_updates();
+    return extract_subgraph(NotSelected<Predicate> { pred }, nullptr, relabel);
+}
+
+template <typename... VertexMetaTypes, typename... EdgeMetaTypes,
+    typename vid_t, typename degree_t>
+template <typename Predicate>
+typename HORNET::SubgraphT
+HORNET::
+extract_subgraph(const Predicate& erase_pred, const bool* d_member,
+        bool relabel) {
+    std::lock_guard<std::mutex> lock(_update_mutex);
+    const int BLOCK_SIZE = 256;
+    int smem = xlib::DeviceProperty::smem_per_block<degree_t>(BLOCK_SIZE);
+
+    //same flags and positions of the in-place compaction of erase_if
+    rmm::device_vector<degree_t> offsets(_nV + 1, 0);
+    auto degree_ptr = _vertex_data.get_soa_ptr().template get<0>();
+    thrust::copy(rmm::exec_policy(0), degree_ptr, degree_ptr + _nV,
+            offsets.begin());
+    thrust::exclusive_scan(rmm::exec_policy(0), offsets.begin(),
+            offsets.end(), offsets.begin());
+    rmm::device_vector<degree_t> keep_flag(_nE + 1, 0);
+    if (_nE != 0) {
+        markKeptEdgesKernel<BLOCK_SIZE>
+            <<< xlib::ceil_div(_nE, smem), BLOCK_SIZE >>>
+            (device(), offsets.data().get(), erase_pred,
+             keep_flag.data().get());
+        CHECK_CUDA_ERROR
+    }
+    rmm::device_vector<degree_t> kept_offsets(_nE + 1);
+    thrust::exclusive_scan(rmm::exec_policy(0), keep_flag.begin(),
+            keep_flag.end(), kept_offsets.begin());
+    degree_t num_kept = kept_offsets[_nE];
+
+    //dense ids: the selected vertices in increasing order
+    rmm::device_vector<vid_t> new_ids;
+    rmm::device_vector<vid_t> id_map;
+    vid_t sub_nV = _nV;
+    if (relabel) {
+        new_ids.resize(_nV + 1, 0);
+        if (d_member != nullptr) {
+            thrust::copy(rmm::exec_policy(0), d_member, d_member + _nV,
+                    new_ids.begin());
+        } else if (_nE != 0) {
+            markIncidentVerticesKernel<BLOCK_SIZE>
+                <<< xlib::ceil_div(_nE, smem), BLOCK_SIZE >>>
+                (device(), offsets.data().get(), keep_flag.data().get(),
+                 new_ids.data().get());
+            CHECK_CUDA_ERROR
+        }
+        id_map.resize(_nV);
+        sub_nV = thrust::copy_if(rmm::exec_policy(0),
+                thrust::make_counting_iterator<vid_t>(0),
+                thrust::make_counting_iterator<vid_t>(_nV),
+                new_ids.begin(), id_map.begin(),
+                thrust::identity<vid_t>()) - id_map.begin();
+        id_map.resize(sub_nV);
+        thrust::exclusive_scan(rmm::exec_policy(0), new_ids.begin(),
+                new_ids.end(), new_ids.begin());
+    }
+
+    SubgraphT subgraph(sub_nV, num_kept);
+    auto sub_offsets = thrust::device_pointer_cast(subgraph.csr_offsets());
+    if (relabel) {
+        //the other vertices have no selected edges
+        thrust::gather(rmm::exec_policy(0), id_map.begin(), id_map.end(),
+                thrust::make_permutation_iterator(kept_offsets.begin(),
+                                                  offsets.begin()),
+                sub_offsets);
+        sub_offsets[sub_nV] = num_kept;
+        subgraph.id_map() = std::move(id_map);
+    } else {
+        thrust::gather(rmm::exec_policy(0), offsets.begin(), offsets.end(),
+                kept_offsets.begin(), sub_offsets);
+    }
+    if (num_kept != 0) {
+        extractEdgesKernel<BLOCK_SIZE>
+            <<< xlib::ceil_div(_nE, smem), BLOCK_SIZE >>>
+            (device(), offsets.data().get(), keep_flag.data().get(),
+             kept_offsets.data().get(),
+             relabel ? new_ids.data().get() : nullptr,
+             subgraph.edge_data_ptr());
+        CHECK_CUDA_ERROR
+    }
+    return subgraph;
+}
+
+}
+}
@@ -0,0 +1,127 @@
+/*
+ * Copyright (c) 2019, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <thrust/copy.h>
+#include <thrust/fill.h>
+#include <thrust/scan.h>
+
+#include <rmm/device_vector.hpp>
+
+namespace hornet {
+namespace gpu {
+
+//edges of every adjacency list -> edges[offsets[v]], position in the list
+//-> index (if not nullptr)
+template <int BLOCK_SIZE, typename HornetDeviceT, typename degree_t,
+          typename CSoAPtrT>
+__global__
+void flattenEdgesKernel(
+        HornetDeviceT hornet,
+        const degree_t* __restrict__ offsets,
+        CSoAPtrT edges,
+        degree_t* __restrict__ index) {
+    const int ITEMS_PER_BLOCK = xlib::smem_per_block<degree_t, BLOCK_SIZE>();
+    __shared__ degree_t smem[ITEMS_PER_BLOCK];
+
+    const auto& lambda = [&] (int pos, degree_t eOffset) {
+        edges[offsets[pos] + eOffset] = hornet.vertex(pos).edge(eOffset);
+        if (index != nullptr)
+            index[offsets[pos] + eOffset] = eOffset;
+    };
+    xlib::binarySearchLB<BLOCK_SIZE>(offsets, hornet.nV() + 1, smem, lambda);
+}
+
+template <int BLOCK_SIZE, typename degree_t, typename CSoAPtrT>
+__global__
+void permuteEdgesKernel(
+        const degree_t* __restrict__ offsets,
+        int offsets_count,
+        CSoAPtrT edges,
+        const degree_t* __restrict__ sorted_index,
+        CSoAPtrT sorted_edges) {
+    const int ITEMS_PER_BLOCK = xlib::smem_per_block<degree_t, BLOCK_SIZE>();
+    __shared__ degree_t smem[ITEMS_PER_BLOCK];
+
+    const auto& lambda = [&] (int pos, degree_t eOffset) {
+        degree_t begin = offsets[pos];
+        sorted_edges[begin + eOffset] =
+            edges[begin + sorted_index[begin + eOffset]];
+    };
+    xlib::binarySearchLB<BLOCK_SIZE>(offsets, offsets_count, smem, lambda);
+}
+
+template <typename... VertexMetaTypes, typename... EdgeMetaTypes,
+    typename vid_t, typename degree_t>
+typename HORNET::HornetStaticT
+HORNET::
+freeze(bool sort) {
+    wait_updates();
+    std::lock_guard<std::mutex> lock(_update_mutex);
+    const int BLOCK_SIZE = 256;
+    int smem = xlib::DeviceProperty::smem_per_block<degree_t>(BLOCK_SIZE);
+
+    HornetStaticT static_graph(_nV, _nE);
+    auto& edge_data = static_graph._edge_data;
+
+    rmm::device_vector<degree_t> offsets(_nV + 1, 0);
+    auto degree_ptr = _vertex_data.get_soa_ptr().template get<0>();
+    thrust::copy(rmm::exec_policy(0), degree_ptr, degree_ptr + _nV,
+            offsets.begin());
+    thrust::exclusive_scan(rmm::exec_policy(0), offsets.begin(),
+            offsets.end(), offsets.begin());
+
+    //the lists are sorted if no update changed their order
+    bool sort_lists = sort && _nE != 0 && !_dirty_vertices.empty();
+    rmm::device_vector<degree_t> index(sort_lists ? _nE : 0);
+    if (_nE != 0) {
+        flattenEdgesKernel<BLOCK_SIZE>
+            <<< xlib::ceil_div(_nE, smem), BLOCK_SIZE >>>
+            (device(), offsets.data().get(), edge_data.get_soa_ptr(),
+             sort_lists ? index.data().get() : nullptr);
+        CHECK_CUDA_ERROR
+    }
+    if (sort_lists) {
+        rmm::device_vector<degree_t> sorted_index(_nE);
+        sortAdjacencyListIndex(edge_data.get_soa_ptr().template get<0>(),
+                offsets.data().get(), degree_ptr, _nV, _nE,
+                index.data().get(), sorted_index.data().get());
+
+        decltype(static_graph._edge_data)
+            sorted_edges(edge_data.get_num_items());
+        permuteEdgesKernel<BLOCK_SIZE>
+            <<< xlib::ceil_div(_nE, smem), BLOCK_SIZE >>>
+            (offsets.data().get(), _nV + 1, edge_data.get_soa_ptr(),
+             sorted_index.data().get(), sorted_edges.get_soa_ptr());
+        CHECK_CUDA_ERROR
+        edge_data = std::move(sorted_edges);
+    }
+
+    //degrees and vertex metadata, then the CSR layout of HornetStatic
+    auto& vertex_data = static_graph._vertex_data;
+    vertex_data.copy(_vertex_data);
+    auto vertex_ptr     = vertex_data.get_soa_ptr();
+    auto edge_block_ptr = reinterpret_cast<xlib::byte_t*>(
+            edge_data.get_soa_ptr().template get<0>());
+    thrust::fill(rmm::exec_policy(0), vertex_ptr.template get<1>(),
+            vertex_ptr.template get<1>() + _nV, edge_block_ptr);
+    thrust::copy(rmm::exec_policy(0), offsets.begin(), offsets.end() - 1,
+            vertex_ptr.template get<2>());
+    thrust::fill(rmm::exec_policy(0), vertex_ptr.template get<3>(),
+            vertex_ptr.template get<3>() + _nV, edge_data.get_num_items());
+    return static_graph;
+}
+
+}
+}
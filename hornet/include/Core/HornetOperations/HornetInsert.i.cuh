@@ -14,25 +14,51 @@ template <typename... VertexMetaTypes, typename... EdgeMetaTypes,
 void
 HORNET::
 insert(BatchUpdate<vid_t, TypeList<EdgeMetaTypes...>, degree_t>& batch, bool removeBatchDuplicates, bool removeGraphDuplicates) {
+    wait_updates();
+    record_update(batch, TraceOp::INSERT, removeBatchDuplicates,
+            removeGraphDuplicates);
+    batch.preprocess_batch(removeBatchDuplicates);
+    apply_insert(batch, removeGraphDuplicates);
+}
+
+template <typename... VertexMetaTypes, typename... EdgeMetaTypes,
+    typename vid_t, typename degree_t>
+void
+HORNET::
+apply_insert(BatchUpdate<vid_t, TypeList<EdgeMetaTypes...>, degree_t>& batch, bool removeGraphDuplicates) {
+    std::unique_lock<std::mutex> lock(_update_mutex);
     auto hornet_device = device();
     //Preprocess batch according to user preference
-    batch.preprocess(
-            hornet_device, removeBatchDuplicates, removeGraphDuplicates);
+    batch.preprocess_graph(hornet_device, removeGraphDuplicates);
 
     _nE = _nE + batch.nE();
+    _version = next_graph_version();
+    //the sorted merge rewrites the adjacency lists in place: the snapshots
+    //keep the old blocks
+    if (_keep_sorted && has_snapshots())
+        copy_on_write(batch);
 
-    reallocate_vertices(batch, true);
+    auto num_reallocated = reallocate_vertices(batch, true);
 
-    batch.appendBatchEdges(hornet_device);
+    batch.appendBatchEdges(hornet_device, _keep_sorted);
+
+    record_change(batch, GraphChangeType::INSERT, num_reallocated);
+    if (!_keep_sorted)
+        _dirty_vertices.mark(_last_change.d_sources, _last_change.num_sources,
+                _nV);
+    reclaim_blocks();
+    auto change = _last_change;
+    lock.unlock();
+    notify_subscribers(change);
 }
 
 template <typename... VertexMetaTypes, typename... EdgeMetaTypes,
     typename vid_t, typename degree_t>
-void
+degree_t
 HORNET::
 reallocate_vertices(gpu::BatchUpdate<vid_t, TypeList<EdgeMetaTypes...>, degree_t>& batch,
         const bool is_insert) {
-    if (batch.nE() == 0) { return; }
+    if (batch.nE() == 0) { return 0; }
     SoAPtr<degree_t, xlib::byte_t*, degree_t, degree_t> h_realloc_v_data;
     SoAPtr<degree_t, xlib::byte_t*, degree_t, degree_t> h_new_v_data;
     SoAPtr<degree_t, xlib::byte_t*, degree_t, degree_t> d_realloc_v_data;
@@ -63,11 +89,11 @@ reallocate_vertices(gpu::BatchUpdate<vid_t, TypeList<EdgeMetaTypes...>, degree_t
     for (degree_t i = 0; i < reallocated_vertices_count; i++) {
         auto ref = h_realloc_v_data[i];
         if (ref.template get<0>() != 0) {
-          _ba_manager.remove(ref.template get<0>(), ref.template get<1>(), ref.template get<2>());
+          retire_block(ref.template get<0>(), ref.template get<1>(), ref.template get<2>());
         }
     }
     PEEK_LAST_STATUS()
-
+    return reallocated_vertices_count;
 }
 
 template <typename... VertexMetaTypes, typename... EdgeMetaTypes,
@@ -75,19 +101,282 @@ template <typename... VertexMetaTypes, typename... EdgeMetaTypes,
 void
 HORNET::
 erase(gpu::BatchUpdate<vid_t, TypeList<EdgeMetaTypes...>, degree_t>& batch, bool removeBatchDuplicates) {
+    wait_updates();
+    record_update(batch, TraceOp::ERASE, removeBatchDuplicates, false);
+    batch.preprocess_batch_erase(removeBatchDuplicates);
+    apply_erase(batch, removeBatchDuplicates);
+}
+
+template <typename... VertexMetaTypes, typename... EdgeMetaTypes,
+    typename vid_t, typename degree_t>
+void
+HORNET::
+apply_erase(gpu::BatchUpdate<vid_t, TypeList<EdgeMetaTypes...>, degree_t>& batch, bool removeBatchDuplicates) {
+    std::unique_lock<std::mutex> lock(_update_mutex);
+    _version = next_graph_version();
+    //the adjacency lists are compacted in place: the snapshots keep the
+    //old blocks
+    if (has_snapshots())
+        copy_on_write(batch);
     auto hornet_device = device();
     //Preprocess batch according to user preference
     //std::cout<<"\nBEFORE DELETE\n";
     //print();
-    batch.preprocess_erase(hornet_device, removeBatchDuplicates);
+    batch.preprocess_graph_erase(hornet_device, removeBatchDuplicates,
+            _keep_sorted);
     CHECK_CUDA_ERROR
     _nE = _nE - batch.nE();
     //std::cout<<"\nBEFORE REALLOCATE\n";
     //print();
-    reallocate_vertices(batch, false);
+    auto num_reallocated = reallocate_vertices(batch, false);
     CHECK_CUDA_ERROR
     //std::cout<<"\nAFTER REALLOCATE\n";
     //print();
+    record_change(batch, GraphChangeType::ERASE, num_reallocated);
+    if (!_keep_sorted)
+        _dirty_vertices.mark(_last_change.d_sources, _last_change.num_sources,
+                _nV);
+    reclaim_blocks();
+    auto change = _last_change;
+    lock.unlock();
+    notify_subscribers(change);
+}
+
+template <typename... VertexMetaTypes, typename... EdgeMetaTypes,
+    typename vid_t, typename degree_t>
+template <typename ReduceOp>
+void
+HORNET::
+upsert(gpu::BatchUpdate<vid_t, TypeList<EdgeMetaTypes...>, degree_t>& batch, const ReduceOp& op) {
+    //the trace has no record for the reduction: the replay would diverge
+    if (_trace_writer != nullptr)
+        ERROR("Hornet::upsert() while recording the updates")
+    wait_updates();
+    batch.preprocess_batch(false);
+    batch.reduce_batch_duplicates(op);
+    apply_upsert(batch, op);
+}
+
+template <typename... VertexMetaTypes, typename... EdgeMetaTypes,
+    typename vid_t, typename degree_t>
+template <typename ReduceOp>
+void
+HORNET::
+apply_upsert(gpu::BatchUpdate<vid_t, TypeList<EdgeMetaTypes...>, degree_t>& batch, const ReduceOp& op) {
+    std::unique_lock<std::mutex> lock(_update_mutex);
+    _version = next_graph_version();
+    //the existing edges are updated in place: the snapshots keep the old
+    //blocks
+    if (has_snapshots())
+        copy_on_write(batch);
+    auto hornet_device = device();
+    batch.upsertExistingEdges(hornet_device, op, _updated_src, _updated_dst);
+    CHECK_CUDA_ERROR
+    GraphChange<vid_t, degree_t> update_change;
+    if (!_updated_src.empty()) {
+        update_change = record_update_change();
+        //the new edges are a second change
+        _version = next_graph_version();
+    }
+
+    //same steps of apply_insert for the new edges
+    _nE = _nE + batch.nE();
+    auto num_reallocated = reallocate_vertices(batch, true);
+    batch.appendBatchEdges(hornet_device, _keep_sorted);
+
+    record_change(batch, GraphChangeType::INSERT, num_reallocated);
+    if (!_keep_sorted)
+        _dirty_vertices.mark(_last_change.d_sources, _last_change.num_sources,
+                _nV);
+    reclaim_blocks();
+    auto change = _last_change;
+    lock.unlock();
+    if (update_change.num_edges != 0)
+        notify_subscribers(update_change);
+    notify_subscribers(change);
+}
+
+template <typename... VertexMetaTypes, typename... EdgeMetaTypes,
+    typename vid_t, typename degree_t>
+template <typename PrepareFunction, typename ApplyFunction>
+std::shared_future<size_t>
+HORNET::
+submit_update(cudaStream_t stream, PrepareFunction prepare, ApplyFunction apply) {
+    if (!_update_pipeline)
+        _update_pipeline.reset(new UpdatePipeline());
+    int device_id;
+    cudaGetDevice(&device_id);
+    //batch_ready: the batch is complete on the stream of the caller
+    //prepared:    the preprocessing of the prepare thread is complete
+    cudaEvent_t batch_ready, prepared;
+    cudaEventCreateWithFlags(&batch_ready, cudaEventDisableTiming);
+    cudaEventCreateWithFlags(&prepared, cudaEventDisableTiming);
+    cudaEventRecord(batch_ready, stream);
+    CHECK_CUDA_ERROR
+
+    return _update_pipeline->submit(
+        [=]() {
+            cudaSetDevice(device_id);
+            cudaStreamWaitEvent(0, batch_ready, 0);
+            prepare();
+            cudaEventRecord(prepared, 0);
+            cudaEventDestroy(batch_ready);
+        },
+        [=]() {
+            cudaSetDevice(device_id);
+            cudaStreamWaitEvent(0, prepared, 0);
+            apply();
+            cudaEventDestroy(prepared);
+            CHECK_CUDA_ERROR
+            return _version;
+        });
+}
+
+template <typename... VertexMetaTypes, typename... EdgeMetaTypes,
+    typename vid_t, typename degree_t>
+std::shared_future<size_t>
+HORNET::
+insert_async(BatchUpdate<vid_t, TypeList<EdgeMetaTypes...>, degree_t>& batch, cudaStream_t stream, bool removeBatchDuplicates, bool removeGraphDuplicates) {
+    auto batch_ptr = &batch;
+    return submit_update(stream,
+            [=]() {
+                record_update(*batch_ptr, TraceOp::INSERT,
+                        removeBatchDuplicates, removeGraphDuplicates);
+                batch_ptr->preprocess_batch(removeBatchDuplicates);
+            },
+            [=]() { apply_insert(*batch_ptr, removeGraphDuplicates); });
+}
+
+template <typename... VertexMetaTypes, typename... EdgeMetaTypes,
+    typename vid_t, typename degree_t>
+std::shared_future<size_t>
+HORNET::
+erase_async(BatchUpdate<vid_t, TypeList<EdgeMetaTypes...>, degree_t>& batch, cudaStream_t stream, bool removeBatchDuplicates) {
+    auto batch_ptr = &batch;
+    return submit_update(stream,
+            [=]() {
+                record_update(*batch_ptr, TraceOp::ERASE,
+                        removeBatchDuplicates, false);
+                batch_ptr->preprocess_batch_erase(removeBatchDuplicates);
+            },
+            [=]() { apply_erase(*batch_ptr, removeBatchDuplicates); });
+}
+
+template <typename... VertexMetaTypes, typename... EdgeMetaTypes,
+    typename vid_t, typename degree_t>
+void
+HORNET::
+record_updates(TraceWriterT* writer) {
+    wait_updates();
+    _trace_writer = writer;
+}
+
+template <typename... VertexMetaTypes, typename... EdgeMetaTypes,
+    typename vid_t, typename degree_t>
+void
+HORNET::
+record_update(gpu::BatchUpdate<vid_t, TypeList<EdgeMetaTypes...>, degree_t>& batch,
+        TraceOp op, bool removeBatchDuplicates, bool removeGraphDuplicates) {
+    //called by the caller thread or by the prepare stage: never concurrently
+    if (_trace_writer == nullptr) { return; }
+    _trace_writer->write(op, removeBatchDuplicates, removeGraphDuplicates,
+            batch.in_edge().get_soa_ptr(), DeviceType::DEVICE, batch.nE());
+}
+
+template <typename... VertexMetaTypes, typename... EdgeMetaTypes,
+    typename vid_t, typename degree_t>
+void
+HORNET::
+wait_updates(void) {
+    //a subscriber notified by the apply stage must not wait for itself
+    if (_update_pipeline && !_update_pipeline->is_stage_thread())
+        _update_pipeline->wait();
+}
+
+template <typename... VertexMetaTypes, typename... EdgeMetaTypes,
+    typename vid_t, typename degree_t>
+int
+HORNET::
+pending_updates(void) const {
+    return _update_pipeline ? _update_pipeline->pending() : 0;
+}
+
+template <typename... VertexMetaTypes, typename... EdgeMetaTypes,
+    typename vid_t, typename degree_t>
+void
+HORNET::
+record_change(gpu::BatchUpdate<vid_t, TypeList<EdgeMetaTypes...>, degree_t>& batch,
+        GraphChangeType type, degree_t num_reallocated) {
+    auto in_ptr = batch.in_edge().get_soa_ptr();
+    degree_t num_edges = batch.nE();
+
+    _last_change = GraphChange<vid_t, degree_t>();
+    _last_change.type            = type;
+    _last_change.version         = _version;
+    _last_change.num_edges       = num_edges;
+    _last_change.num_reallocated = num_reallocated;
+    _last_change.d_batch_src     = in_ptr.template get<0>();
+    _last_change.d_batch_dst     = in_ptr.template get<1>();
+    if (num_edges == 0) { return; }
+
+    //the batch is sorted by source: one run for each touched vertex
+    _changed_sources.resize(num_edges);
+    _degree_deltas.resize(num_edges);
+    _change_encoder.resize(num_edges);
+    degree_t num_sources = _change_encoder.run(in_ptr.template get<0>(),
+            num_edges, _changed_sources.data().get(),
+            _degree_deltas.data().get());
+    if (type == GraphChangeType::ERASE) {
+        thrust::transform(_degree_deltas.begin(),
+                _degree_deltas.begin() + num_sources,
+                _degree_deltas.begin(), thrust::negate<degree_t>());
+    }
+    _last_change.num_sources     = num_sources;
+    _last_change.d_sources       = _changed_sources.data().get();
+    _last_change.d_degree_deltas = _degree_deltas.data().get();
+}
+
+template <typename... VertexMetaTypes, typename... EdgeMetaTypes,
+    typename vid_t, typename degree_t>
+GraphChange<vid_t, degree_t>
+HORNET::
+record_update_change(void) {
+    degree_t num_edges = _updated_src.size();
+
+    GraphChange<vid_t, degree_t> change;
+    change.type        = GraphChangeType::UPDATE;
+    change.version     = _version;
+    change.num_edges   = num_edges;
+    change.d_batch_src = _updated_src.data().get();
+    change.d_batch_dst = _updated_dst.data().get();
+
+    //the updated edges are sorted by source: one run for each touched vertex.
+    //Own arrays: the INSERT change of the same upsert is notified after
+    _updated_sources.resize(num_edges);
+    _updated_deltas.resize(num_edges);
+    _change_encoder.resize(num_edges);
+    degree_t num_sources = _change_encoder.run(_updated_src.data().get(),
+            num_edges, _updated_sources.data().get(),
+            _updated_deltas.data().get());
+    //the metadata changed in place: the degrees do not change
+    thrust::fill(_updated_deltas.begin(),
+            _updated_deltas.begin() + num_sources, 0);
+    change.num_sources     = num_sources;
+    change.d_sources       = _updated_sources.data().get();
+    change.d_degree_deltas = _updated_deltas.data().get();
+    return change;
+}
+
+template <typename... VertexMetaTypes, typename... EdgeMetaTypes,
+    typename vid_t, typename degree_t>
+void
+HORNET::
+notify_subscribers(const GraphChange<vid_t, degree_t>& change) {
+    //called without the update lock: a subscriber may update the graph or
+    //(un)subscribe, the list is copied
+    auto subscribers = _subscribers;
+    for (auto subscriber : subscribers)
+        subscriber->graphChanged(change);
 }
 
 }
@@ -0,0 +1,300 @@
+/*
+ * Copyright (c) 2019, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <algorithm>
+#include <limits>
+#include <thrust/copy.h>
+#include <thrust/scan.h>
+#include "../SoA/SoAData.cuh"
+
+#include <rmm/exec_policy.hpp>
+#include <rmm/device_vector.hpp>
+
+namespace hornet {
+namespace gpu {
+
+template <typename HornetDeviceT, typename vid_t, typename degree_t,
+          typename SoAPtrT>
+__global__
+void gather_vertex_access_kernel(
+        HornetDeviceT hornet,
+        const vid_t * __restrict__ vertex_ids,
+        const degree_t vertex_count,
+        SoAPtrT vertex_access) {
+    size_t     id = blockIdx.x * blockDim.x + threadIdx.x;
+    size_t stride = gridDim.x * blockDim.x;
+
+    for (auto i = id; i < vertex_count; i += stride) {
+        auto vertex = hornet.vertex(vertex_ids[i]);
+        auto ref    = vertex_access[i];
+        ref.template get<0>() = vertex.degree();
+        ref.template get<1>() = vertex.edge_block_ptr();
+        ref.template get<2>() = vertex.vertex_offset();
+        ref.template get<3>() = vertex.edges_per_block();
+    }
+}
+
+//==============================================================================
+////////////////////
+// HornetSnapshot //
+////////////////////
+
+template <typename HornetT>
+HornetSnapshot<HornetT>::
+HornetSnapshot(HornetT& hornet) noexcept :
+    _hornet(&hornet),
+    _vertex_data(hornet._nV),
+    _nV(hornet._nV),
+    _nE(hornet._nE),
+    _version(hornet._version) {
+    _vertex_data.copy(hornet._vertex_data);
+    std::lock_guard<std::mutex> lock(hornet._snapshot_mutex);
+    hornet._snapshot_versions.insert(_version);
+}
+
+template <typename HornetT>
+HornetSnapshot<HornetT>::
+HornetSnapshot(HornetSnapshot&& other) noexcept :
+    _hornet(other._hornet),
+    _vertex_data(std::move(other._vertex_data)),
+    _nV(other._nV),
+    _nE(other._nE),
+    _version(other._version) {
+    other._hornet = nullptr;
+}
+
+template <typename HornetT>
+HornetSnapshot<HornetT>::
+~HornetSnapshot(void) noexcept {
+    release();
+}
+
+template <typename HornetT>
+void
+HornetSnapshot<HornetT>::
+release(void) noexcept {
+    if (_hornet == nullptr) { return; }
+    _hornet->release_snapshot(_version);
+    _hornet = nullptr;
+}
+
+template <typename HornetT>
+typename HornetSnapshot<HornetT>::DegreeType
+HornetSnapshot<HornetT>::
+nV(void) const noexcept {
+    return _nV;
+}
+
+template <typename HornetT>
+typename HornetSnapshot<HornetT>::DegreeType
+HornetSnapshot<HornetT>::
+nE(void) const noexcept {
+    return _nE;
+}
+
+template <typename HornetT>
+size_t
+HornetSnapshot<HornetT>::
+version(void) const noexcept {
+    return _version;
+}
+
+template <typename HornetT>
+typename HornetSnapshot<HornetT>::HornetDeviceT
+HornetSnapshot<HornetT>::
+device(void) noexcept {
+    return HornetDeviceT(_nV, _nE, _vertex_data.get_soa_ptr());
+}
+
+//==============================================================================
+////////////
+// Hornet //
+////////////
+
+template <typename... VertexMetaTypes, typename... EdgeMetaTypes,
+    typename vid_t, typename degree_t>
+typename HORNET::SnapshotT
+HORNET::
+snapshot(void) {
+    //a snapshot is never taken in the middle of an update
+    std::lock_guard<std::mutex> lock(_update_mutex);
+    return SnapshotT(*this);
+}
+
+template <typename... VertexMetaTypes, typename... EdgeMetaTypes,
+    typename vid_t, typename degree_t>
+int
+HORNET::
+num_snapshots(void) const {
+    std::lock_guard<std::mutex> lock(_snapshot_mutex);
+    return _snapshot_versions.size();
+}
+
+template <typename... VertexMetaTypes, typename... EdgeMetaTypes,
+    typename vid_t, typename degree_t>
+int
+HORNET::
+num_retired_blocks(void) const {
+    std::lock_guard<std::mutex> lock(_snapshot_mutex);
+    return _retired_blocks.size();
+}
+
+template <typename... VertexMetaTypes, typename... EdgeMetaTypes,
+    typename vid_t, typename degree_t>
+bool
+HORNET::
+has_snapshots(void) const {
+    std::lock_guard<std::mutex> lock(_snapshot_mutex);
+    return !_snapshot_versions.empty();
+}
+
+template <typename... VertexMetaTypes, typename... EdgeMetaTypes,
+    typename vid_t, typename degree_t>
+void
+HORNET::
+release_snapshot(size_t version) {
+    {
+        std::lock_guard<std::mutex> lock(_snapshot_mutex);
+        _snapshot_versions.erase(_snapshot_versions.find(version));
+    }
+    //the block array manager belongs to the writer: if an update is running
+    //the blocks are reclaimed at its end
+    std::unique_lock<std::mutex> lock(_update_mutex, std::try_to_lock);
+    if (lock.owns_lock())
+        reclaim_blocks();
+}
+
+template <typename... VertexMetaTypes, typename... EdgeMetaTypes,
+    typename vid_t, typename degree_t>
+void
+HORNET::
+retire_block(degree_t degree, xlib::byte_t* edge_block_ptr,
+        degree_t vertex_offset) {
+    {
+        std::lock_guard<std::mutex> lock(_snapshot_mutex);
+        if (!_snapshot_versions.empty()) {
+            _retired_blocks.push_back(
+                    RetiredBlock { _version, degree, edge_block_ptr, vertex_offset });
+            return;
+        }
+    }
+    _ba_manager.remove(degree, edge_block_ptr, vertex_offset);
+}
+
+template <typename... VertexMetaTypes, typename... EdgeMetaTypes,
+    typename vid_t, typename degree_t>
+void
+HORNET::
+reclaim_blocks(void) {
+    std::lock_guard<std::mutex> lock(_snapshot_mutex);
+    if (_retired_blocks.empty()) { return; }
+    //a block retired by the update to version v is visible only to the
+    //snapshots older than v
+    size_t oldest = _snapshot_versions.empty() ?
+        std::numeric_limits<size_t>::max() : *_snapshot_versions.begin();
+    auto it = std::partition(_retired_blocks.begin(), _retired_blocks.end(),
+            [oldest](const RetiredBlock& block) {
+                return block.version > oldest;
+            });
+    for (auto jt = it; jt != _retired_blocks.end(); ++jt)
+        _ba_manager.remove(jt->degree, jt->edge_block_ptr, jt->vertex_offset);
+    _retired_blocks.erase(it, _retired_blocks.end());
+}
+
+template <typename... VertexMetaTypes, typename... EdgeMetaTypes,
+    typename vid_t, typename degree_t>
+void
+HORNET::
+copy_on_write(gpu::BatchUpdate<vid_t, TypeList<EdgeMetaTypes...>, degree_t>& batch) {
+    degree_t num_edges = batch.nE();
+    if (num_edges == 0) { return; }
+    //the batch is sorted by source: one run for each touched vertex
+    vid_t* batch_src = batch.in_edge().get_soa_ptr().template get<0>();
+    _changed_sources.resize(num_edges);
+    _degree_deltas.resize(num_edges);
+    _change_encoder.resize(num_edges);
+    degree_t num_sources = _change_encoder.run(batch_src, num_edges,
+            _changed_sources.data().get(), _degree_deltas.data().get());
+    copy_on_write(_changed_sources.data().get(), num_sources);
+}
+
+template <typename... VertexMetaTypes, typename... EdgeMetaTypes,
+    typename vid_t, typename degree_t>
+void
+HORNET::
+copy_on_write(vid_t* d_sources, degree_t num_sources) {
+    if (num_sources == 0) { return; }
+    using AccessTypes = TypeList<degree_t, xlib::byte_t*, degree_t, degree_t>;
+    SoAData<AccessTypes, DeviceType::DEVICE> d_old_access(num_sources);
+    SoAData<AccessTypes, DeviceType::DEVICE> d_new_access(num_sources);
+    SoAData<AccessTypes, DeviceType::HOST>   h_old_access(num_sources);
+    SoAData<AccessTypes, DeviceType::HOST>   h_new_access(num_sources);
+
+    const int BLOCK_SIZE = 256;
+    gather_vertex_access_kernel
+        <<< xlib::ceil_div<BLOCK_SIZE>(num_sources), BLOCK_SIZE >>>
+        (device(), d_sources, num_sources, d_old_access.get_soa_ptr());
+    CHECK_CUDA_ERROR
+    h_old_access.copy(d_old_access);
+
+    auto h_old = h_old_access.get_soa_ptr();
+    auto h_new = h_new_access.get_soa_ptr();
+    for (degree_t i = 0; i < num_sources; i++) {
+        auto old_ref = h_old[i];
+        auto new_ref = h_new[i];
+        degree_t degree = old_ref.template get<0>();
+        if (degree == 0) {
+            //nothing to erase: the vertex keeps its block
+            new_ref.template get<0>() = 0;
+            new_ref.template get<1>() = old_ref.template get<1>();
+            new_ref.template get<2>() = old_ref.template get<2>();
+            new_ref.template get<3>() = old_ref.template get<3>();
+            continue;
+        }
+        auto access_data = _ba_manager.insert(degree);
+        new_ref.template get<0>() = degree;
+        new_ref.template get<1>() = access_data.edge_block_ptr;
+        new_ref.template get<2>() = access_data.vertex_offset;
+        new_ref.template get<3>() = access_data.edges_per_block;
+        retire_block(degree, old_ref.template get<1>(),
+                old_ref.template get<2>());
+    }
+    d_new_access.copy(h_new_access);
+
+    rmm::device_vector<degree_t> offsets(num_sources + 1, 0);
+    degree_t* old_degrees = d_old_access.get_soa_ptr().template get<0>();
+    thrust::copy(rmm::exec_policy(0), old_degrees, old_degrees + num_sources,
+            offsets.begin());
+    thrust::exclusive_scan(rmm::exec_policy(0), offsets.begin(), offsets.end(),
+            offsets.begin());
+    degree_t total_work = offsets[num_sources];
+    if (total_work != 0) {
+        int smem = xlib::DeviceProperty::smem_per_block<degree_t>(BLOCK_SIZE);
+        int num_blocks = xlib::ceil_div(total_work, smem);
+        move_adjacency_lists_kernel<BLOCK_SIZE>
+            <<< num_blocks, BLOCK_SIZE >>>
+            (device(), d_old_access.get_soa_ptr(), d_new_access.get_soa_ptr(),
+             offsets.data().get(), offsets.size());
+        CHECK_CUDA_ERROR
+    }
+    set_vertex_meta_data
+        <<< xlib::ceil_div<BLOCK_SIZE>(num_sources), BLOCK_SIZE >>>
+        (d_sources, _vertex_data.get_soa_ptr(), d_new_access.get_soa_ptr(),
+         num_sources);
+    CHECK_CUDA_ERROR
+}
+
+}
+}
@@ -13,8 +13,14 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include <Host/Basic.hpp>   //ERROR
 #include <limits>
+#include <cub/cub.cuh>
+#include <thrust/copy.h>
+#include <thrust/gather.h>
+#include <thrust/scan.h>
 
+#include <rmm/device_buffer.hpp>
 #include <rmm/device_vector.hpp>
 
 namespace hornet {
@@ -52,11 +58,206 @@ void invalidateEdges(
 
 }
 
+//adjacency lists up to this length are sorted by a single thread
+const int SMALL_ADJACENCY_LIST = 32;
+
+template <typename degree_t>
+struct IsLargeAdjacencyList {
+  __device__
+  bool operator()(degree_t deg) {
+    return deg > SMALL_ADJACENCY_LIST;
+  }
+};
+
+template <int BLOCK_SIZE, typename HornetDeviceT, typename vid_t,
+          typename degree_t, typename SoAPtrT>
+__global__
+void gatherAdjacencyLists(
+    HornetDeviceT hornet,
+    const vid_t * __restrict__ vertex_ids,
+    const degree_t * __restrict__ offsets,
+    size_t offsets_count,
+    SoAPtrT edges,
+    degree_t * __restrict__ index) {
+  const int ITEMS_PER_BLOCK = xlib::smem_per_block<degree_t, BLOCK_SIZE>();
+  __shared__ degree_t smem[ITEMS_PER_BLOCK];
+  const auto& lambda = [&] (int pos, degree_t edge_offset) {
+    auto vertex = hornet.vertex(vertex_ids[pos]);
+    edges[offsets[pos] + edge_offset] = vertex.edge(edge_offset);
+    index[offsets[pos] + edge_offset] = edge_offset;
+  };
+  xlib::binarySearchLB<BLOCK_SIZE>(offsets, offsets_count, smem, lambda);
+}
+
+//one thread for each small adjacency list: insertion sort of the
+//destinations, the permutation is written to sorted_index
+template <typename vid_t, typename degree_t>
+__global__
+void sortSmallAdjacencyLists(
+    const vid_t * __restrict__ dst,
+    const degree_t * __restrict__ offsets,
+    degree_t num_lists,
+    degree_t * __restrict__ sorted_index) {
+  int     id = blockIdx.x * blockDim.x + threadIdx.x;
+  int stride = gridDim.x * blockDim.x;
+
+  for (auto i = id; i < num_lists; i += stride) {
+    degree_t begin  = offsets[i];
+    degree_t degree = offsets[i + 1] - begin;
+    if (degree > SMALL_ADJACENCY_LIST) { continue; }
+    vid_t    keys[SMALL_ADJACENCY_LIST];
+    degree_t index[SMALL_ADJACENCY_LIST];
+    for (degree_t j = 0; j < degree; j++) {
+      vid_t key = dst[begin + j];
+      degree_t k = j;
+      for (; k > 0 && keys[k - 1] > key; k--) {
+        keys[k]  = keys[k - 1];
+        index[k] = index[k - 1];
+      }
+      keys[k]  = key;
+      index[k] = j;
+    }
+    for (degree_t j = 0; j < degree; j++)
+      sorted_index[begin + j] = index[j];
+  }
+}
+
+template <int BLOCK_SIZE, typename HornetDeviceT, typename vid_t,
+          typename degree_t, typename SoAPtrT>
+__global__
+void scatterSortedAdjacencyLists(
+    HornetDeviceT hornet,
+    const vid_t * __restrict__ vertex_ids,
+    const degree_t * __restrict__ offsets,
+    size_t offsets_count,
+    SoAPtrT edges,
+    const degree_t * __restrict__ sorted_index) {
+  const int ITEMS_PER_BLOCK = xlib::smem_per_block<degree_t, BLOCK_SIZE>();
+  __shared__ degree_t smem[ITEMS_PER_BLOCK];
+  const auto& lambda = [&] (int pos, degree_t edge_offset) {
+    auto vertex = hornet.vertex(vertex_ids[pos]);
+    degree_t begin = offsets[pos];
+    vertex.edge(edge_offset) = edges[begin + sorted_index[begin + edge_offset]];
+  };
+  xlib::binarySearchLB<BLOCK_SIZE>(offsets, offsets_count, smem, lambda);
+}
+
+//sorted_index[offsets[i] + j]: position in the list i of its j-th smallest
+//destination. index holds the positions 0, 1, ... of every list
+template <typename vid_t, typename degree_t>
+void sortAdjacencyListIndex(
+    const vid_t * dst,
+    const degree_t * offsets,
+    const degree_t * degrees,
+    degree_t num_lists,
+    degree_t number_of_edges,
+    const degree_t * index,
+    degree_t * sorted_index) {
+  cudaStream_t stream{nullptr};
+  const int BLOCK_SIZE = 256;
+  sortSmallAdjacencyLists
+    <<<xlib::ceil_div<BLOCK_SIZE>(num_lists), BLOCK_SIZE>>>(dst,
+      offsets, num_lists, sorted_index);
+  CHECK_CUDA_ERROR
+
+  //the large adjacency lists are sorted by a device segmented sort
+  rmm::device_vector<degree_t> begin_offsets(num_lists);
+  rmm::device_vector<degree_t> end_offsets(num_lists);
+  auto begin_end = thrust::copy_if(rmm::exec_policy(stream),
+      offsets, offsets + num_lists, degrees,
+      begin_offsets.begin(), IsLargeAdjacencyList<degree_t>());
+  thrust::copy_if(rmm::exec_policy(stream),
+      offsets + 1, offsets + num_lists + 1, degrees,
+      end_offsets.begin(), IsLargeAdjacencyList<degree_t>());
+  int num_large_lists = begin_end - begin_offsets.begin();
+  if (num_large_lists != 0) {
+    rmm::device_vector<vid_t> sorted_dst(number_of_edges);
+    size_t tempStorageBytes = 0;
+    cub::DeviceSegmentedRadixSort::SortPairs(
+        NULL, tempStorageBytes, dst, sorted_dst.data().get(),
+        index, sorted_index, number_of_edges,
+        num_large_lists, begin_offsets.data().get(), end_offsets.data().get());
+    rmm::device_buffer tempStorage(tempStorageBytes, cuda_stream_view{});
+    cub::DeviceSegmentedRadixSort::SortPairs(
+        tempStorage.data(), tempStorageBytes, dst, sorted_dst.data().get(),
+        index, sorted_index, number_of_edges,
+        num_large_lists, begin_offsets.data().get(), end_offsets.data().get());
+    CHECK_CUDA_ERROR
+  }
+}
+
 template <typename... VertexMetaTypes, typename... EdgeMetaTypes,
     typename vid_t, typename degree_t>
 void
 HORNET::
 sort(void) {
+  //the pending asynchronous updates write the same blocks
+  wait_updates();
+  std::lock_guard<std::mutex> lock(_update_mutex);
+  //the adjacency lists are sorted in place: the snapshots share the blocks
+  if (has_snapshots())
+    ERROR("Hornet::sort() with live snapshots")
+  if (_dirty_vertices.empty()) { return; }
+  if (_dirty_vertices.is_all())
+    sort_all();
+  else
+    sort_dirty();
+  _dirty_vertices.clear();
+}
+
+template <typename... VertexMetaTypes, typename... EdgeMetaTypes,
+    typename vid_t, typename degree_t>
+void
+HORNET::
+sort_dirty(void) {
+  //the updated adjacency lists are gathered in a contiguous buffer, sorted
+  //by a segmented sort and scattered back
+  auto vertex_ids = _dirty_vertices.compact(_nV);
+  degree_t num_lists = vertex_ids.size();
+  if (num_lists == 0) { return; }
+  cudaStream_t stream{nullptr};
+
+  rmm::device_vector<degree_t> degrees(num_lists);
+  rmm::device_vector<degree_t> offsets(num_lists + 1, 0);
+  degree_t * vertex_degrees = _vertex_data.get_soa_ptr().template get<0>();
+  thrust::gather(rmm::exec_policy(stream),
+      vertex_ids.begin(), vertex_ids.end(),
+      vertex_degrees, degrees.begin());
+  thrust::copy(rmm::exec_policy(stream),
+      degrees.begin(), degrees.end(), offsets.begin());
+  thrust::exclusive_scan(rmm::exec_policy(stream),
+      offsets.begin(), offsets.end(), offsets.begin());
+  degree_t number_of_edges = offsets[num_lists];
+  if (number_of_edges == 0) { return; }
+
+  SoAData<TypeList<vid_t, EdgeMetaTypes...>, DeviceType::DEVICE>
+    edges(number_of_edges);
+  rmm::device_vector<degree_t> index(number_of_edges);
+  rmm::device_vector<degree_t> sorted_index(number_of_edges);
+  HornetDeviceT hornet_device = device();
+  const int BLOCK_SIZE = 256;
+  int smem = xlib::DeviceProperty::smem_per_block<degree_t>(BLOCK_SIZE);
+  int num_blocks = xlib::ceil_div(number_of_edges, smem);
+  gatherAdjacencyLists<BLOCK_SIZE><<<num_blocks, BLOCK_SIZE>>>(hornet_device,
+      vertex_ids.data().get(), offsets.data().get(), offsets.size(),
+      edges.get_soa_ptr(), index.data().get());
+  CHECK_CUDA_ERROR
+
+  sortAdjacencyListIndex(edges.get_soa_ptr().template get<0>(),
+      offsets.data().get(), degrees.data().get(), num_lists, number_of_edges,
+      index.data().get(), sorted_index.data().get());
+
+  scatterSortedAdjacencyLists<BLOCK_SIZE><<<num_blocks, BLOCK_SIZE>>>(
+      hornet_device, vertex_ids.data().get(), offsets.data().get(),
+      offsets.size(), edges.get_soa_ptr(), sorted_index.data().get());
+  CHECK_CUDA_ERROR
+}
+
+template <typename... VertexMetaTypes, typename... EdgeMetaTypes,
+    typename vid_t, typename degree_t>
+void
+HORNET::
+sort_all(void) {
   if (_nE == 0) { return; }
   cudaStream_t stream{nullptr};
 
@@ -90,6 +291,25 @@ sort(void) {
   CHECK_CUDA_ERROR
 }
 
+template <typename... VertexMetaTypes, typename... EdgeMetaTypes,
+    typename vid_t, typename degree_t>
+void
+HORNET::
+set_keep_sorted(bool keep_sorted) {
+  wait_updates();
+  if (keep_sorted && !_keep_sorted)
+    sort();
+  _keep_sorted = keep_sorted;
+}
+
+template <typename... VertexMetaTypes, typename... EdgeMetaTypes,
+    typename vid_t, typename degree_t>
+bool
+HORNET::
+is_keep_sorted(void) const noexcept {
+  return _keep_sorted;
+}
+
 }//namespace gpu
 
 }//namespace hornet
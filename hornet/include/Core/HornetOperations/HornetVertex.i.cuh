@@ -0,0 +1,240 @@
+/*
+ * Copyright (c) 2019, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <algorithm>
+#include <Host/Basic.hpp>   //ERROR
+#include <iterator>
+#include <thrust/copy.h>
+#include <thrust/scan.h>
+#include <thrust/scatter.h>
+#include <thrust/iterator/constant_iterator.h>
+#include "../SoA/SoAData.cuh"
+
+#include <rmm/exec_policy.hpp>
+#include <rmm/device_vector.hpp>
+
+namespace hornet {
+namespace gpu {
+
+template <int BLOCK_SIZE, typename HornetDeviceT, typename degree_t,
+          typename SoAPtrT>
+__global__
+void collectIncidentEdgesKernel(
+        HornetDeviceT hornet,
+        const degree_t* __restrict__ offsets,
+        const bool* __restrict__ is_erased,
+        SoAPtrT ptr,
+        degree_t* __restrict__ num_edges) {
+    const int ITEMS_PER_BLOCK = xlib::smem_per_block<degree_t, BLOCK_SIZE>();
+    __shared__ degree_t smem[ITEMS_PER_BLOCK];
+
+    const auto& lambda = [&] (int pos, degree_t eOffset) {
+        auto vertex = hornet.vertex(pos);
+        auto edge   = vertex.edge(eOffset);
+        if (!is_erased[pos] && !is_erased[edge.dst_id()])
+            return;
+        degree_t index = atomicAdd(num_edges, 1);
+        auto *src = ptr.template get<0>();
+        auto e = ptr.get_tail();
+        e[index] = edge;
+        src[index] = pos;
+    };
+    xlib::binarySearchLB<BLOCK_SIZE>(offsets, hornet.nV() + 1, smem, lambda);
+}
+
+template <typename vid_t, typename SoAPtrT>
+__global__
+void clearVerticesKernel(
+        const vid_t* __restrict__ vertex_ids,
+        const int vertex_count,
+        SoAPtrT vertex_data,
+        SoAPtrT empty_vertex) {
+    int     id = blockIdx.x * blockDim.x + threadIdx.x;
+    int stride = gridDim.x * blockDim.x;
+
+    for (auto i = id; i < vertex_count; i += stride)
+        vertex_data[vertex_ids[i]] = empty_vertex[0];
+}
+
+template <typename... VertexMetaTypes, typename... EdgeMetaTypes,
+    typename vid_t, typename degree_t>
+vid_t
+HORNET::
+vertex_capacity(void) noexcept {
+    return _vertex_data.get_num_items();
+}
+
+template <typename... VertexMetaTypes, typename... EdgeMetaTypes,
+    typename vid_t, typename degree_t>
+int
+HORNET::
+num_free_vertices(void) const noexcept {
+    return _free_vertices.size();
+}
+
+template <typename... VertexMetaTypes, typename... EdgeMetaTypes,
+    typename vid_t, typename degree_t>
+void
+HORNET::
+reserve_vertices(vid_t capacity) {
+    wait_updates();
+    std::lock_guard<std::mutex> lock(_update_mutex);
+    if (capacity > vertex_capacity())
+        resize_vertex_data(capacity);
+}
+
+template <typename... VertexMetaTypes, typename... EdgeMetaTypes,
+    typename vid_t, typename degree_t>
+void
+HORNET::
+resize_vertex_data(vid_t capacity) {
+    //the new vertices are zero: no edges and empty metadata
+    SoAData<VertexTypes, DeviceType::DEVICE> new_vertex_data(capacity, true);
+    new_vertex_data.copy(_vertex_data);
+    _vertex_data = std::move(new_vertex_data);
+}
+
+template <typename... VertexMetaTypes, typename... EdgeMetaTypes,
+    typename vid_t, typename degree_t>
+std::vector<vid_t>
+HORNET::
+insert_vertices(int count) {
+    wait_updates();
+    std::unique_lock<std::mutex> lock(_update_mutex);
+    std::vector<vid_t> ids;
+    ids.reserve(count);
+    //the smallest free ids first: the id range stays compact
+    while (static_cast<int>(ids.size()) < count && !_free_vertices.empty()) {
+        ids.push_back(*_free_vertices.begin());
+        _free_vertices.erase(_free_vertices.begin());
+    }
+    vid_t num_new = static_cast<vid_t>(count - ids.size());
+    if (_nV + num_new > vertex_capacity())
+        resize_vertex_data(std::max(_nV + num_new, 2 * vertex_capacity()));
+    for (vid_t i = 0; i < num_new; i++)
+        ids.push_back(_nV + i);
+    _nV += num_new;
+
+    _version = next_graph_version();
+    record_vertex_change(ids, GraphChangeType::INSERT_VERTICES);
+    auto change = _last_change;
+    lock.unlock();
+    notify_subscribers(change);
+    return ids;
+}
+
+template <typename... VertexMetaTypes, typename... EdgeMetaTypes,
+    typename vid_t, typename degree_t>
+void
+HORNET::
+erase_vertices(const vid_t* h_ids, int count) {
+    wait_updates();
+    std::vector<vid_t> ids(h_ids, h_ids + count);
+    std::sort(ids.begin(), ids.end());
+    ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
+    if (ids.empty()) { return; }
+    //sorted: the range check is on the first and last id
+    if (ids.front() < 0 || ids.back() >= _nV)
+        ERROR("erase_vertices: vertex id out of range: ",
+              ids.front() < 0 ? ids.front() : ids.back())
+    for (auto id : ids) {
+        if (_free_vertices.count(id) != 0)
+            ERROR("erase_vertices: vertex already erased: ", id)
+    }
+    rmm::device_vector<vid_t> d_ids(ids);
+
+    //incident edges: out-edges of the erased vertices and in-edges from the
+    //other vertices, removed with a single erase batch
+    if (_nE != 0) {
+        rmm::device_vector<bool> is_erased(_nV, false);
+        thrust::scatter(rmm::exec_policy(0),
+                thrust::make_constant_iterator(true),
+                thrust::make_constant_iterator(true) + d_ids.size(),
+                d_ids.begin(), is_erased.begin());
+
+        rmm::device_vector<degree_t> offsets(_nV + 1, 0);
+        auto degree_ptr = _vertex_data.get_soa_ptr().template get<0>();
+        thrust::copy(rmm::exec_policy(0), degree_ptr, degree_ptr + _nV,
+                offsets.begin());
+        thrust::exclusive_scan(rmm::exec_policy(0), offsets.begin(),
+                offsets.end(), offsets.begin());
+
+        SoAData<TypeList<vid_t, vid_t, EdgeMetaTypes...>, DeviceType::DEVICE>
+            edges(_nE);
+        rmm::device_vector<degree_t> num_edges(1, 0);
+        const int BLOCK_SIZE = 256;
+        int smem = xlib::DeviceProperty::smem_per_block<degree_t>(BLOCK_SIZE);
+        int num_blocks = xlib::ceil_div(_nE, smem);
+        collectIncidentEdgesKernel<BLOCK_SIZE>
+            <<< num_blocks, BLOCK_SIZE >>>
+            (device(), offsets.data().get(), is_erased.data().get(),
+             edges.get_soa_ptr(), num_edges.data().get());
+        CHECK_CUDA_ERROR
+
+        degree_t h_num_edges = num_edges[0];
+        if (h_num_edges != 0) {
+            BatchUpdatePtr<vid_t, TypeList<EdgeMetaTypes...>,
+                DeviceType::DEVICE, degree_t> ptr(h_num_edges,
+                        edges.get_soa_ptr());
+            gpu::BatchUpdate<vid_t, TypeList<EdgeMetaTypes...>, degree_t>
+                batch(ptr);
+            erase(batch);
+        }
+    }
+
+    std::unique_lock<std::mutex> lock(_update_mutex);
+    //the adjacency lists are empty: clear the metadata for the reuse
+    SoAData<VertexTypes, DeviceType::DEVICE> empty_vertex(1, true);
+    const int BLOCK_SIZE = 256;
+    clearVerticesKernel
+        <<< xlib::ceil_div<BLOCK_SIZE>(ids.size()), BLOCK_SIZE >>>
+        (d_ids.data().get(), static_cast<int>(ids.size()),
+         _vertex_data.get_soa_ptr(), empty_vertex.get_soa_ptr());
+    CHECK_CUDA_ERROR
+
+    _free_vertices.insert(ids.begin(), ids.end());
+    //the free ids at the end of the range are dropped
+    while (!_free_vertices.empty() && *_free_vertices.rbegin() == _nV - 1) {
+        _free_vertices.erase(std::prev(_free_vertices.end()));
+        _nV--;
+    }
+    if (_nV <= vertex_capacity() / 4)
+        resize_vertex_data(std::max(2 * _nV, vid_t(1)));
+
+    _version = next_graph_version();
+    record_vertex_change(ids, GraphChangeType::ERASE_VERTICES);
+    auto change = _last_change;
+    lock.unlock();
+    notify_subscribers(change);
+}
+
+template <typename... VertexMetaTypes, typename... EdgeMetaTypes,
+    typename vid_t, typename degree_t>
+void
+HORNET::
+record_vertex_change(const std::vector<vid_t>& ids, GraphChangeType type) {
+    //the degrees do not change: the erased edges have their own change
+    _changed_sources.assign(ids.begin(), ids.end());
+    _degree_deltas.assign(ids.size(), 0);
+    _last_change = GraphChange<vid_t, degree_t>();
+    _last_change.type            = type;
+    _last_change.version         = _version;
+    _last_change.num_sources     = ids.size();
+    _last_change.d_sources       = _changed_sources.data().get();
+    _last_change.d_degree_deltas = _degree_deltas.data().get();
+}
+
+}
+}
@@ -0,0 +1,90 @@
+/*
+ * Copyright (c) 2019, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef HORNET_SNAPSHOT_CUH
+#define HORNET_SNAPSHOT_CUH
+
+#include "SoA/SoAData.cuh"
+#include <cstddef>
+
+namespace hornet {
+namespace gpu {
+
+/**
+ * @brief Read-only view of a `Hornet` graph at a given version
+ * @details The snapshot owns a copy of the vertex data (degrees and edge block
+ *          pointers) and shares the edge blocks with the graph. While a
+ *          snapshot is alive the graph never modifies the first `degree`
+ *          edges of a block visible to it:
+ *          - `insert` appends after the degree, or moves the vertex to a new
+ *            block;
+ *          - `erase` copies the touched vertices to new blocks before
+ *            compacting them (copy-on-write);
+ *          - the blocks released by the updates are reclaimed only when all
+ *            the snapshots older than the update are released.
+ *          The snapshot exposes the interface used by the operators and the
+ *          load balancing (`nV()`, `nE()`, `version()`, `device()`), so the
+ *          algorithms can run on it while the graph is updated.
+ * @warning the snapshot must be released before the graph is destroyed, and
+ *          after the kernels which read it are complete
+ * @tparam HornetT graph type
+ */
+template <typename HornetT>
+class HornetSnapshot {
+    friend HornetT;
+
+public:
+    using HornetDeviceT = typename HornetT::HornetDeviceT;
+    using VertexType    = typename HornetT::VertexType;
+    using DegreeType    = typename HornetT::DegreeType;
+    using VertexTypes   = typename HornetT::VertexTypes;
+
+    HornetSnapshot(HornetSnapshot&& other) noexcept;
+
+    HornetSnapshot(const HornetSnapshot&) = delete;
+
+    HornetSnapshot& operator=(const HornetSnapshot&) = delete;
+
+    ~HornetSnapshot(void) noexcept;
+
+    DegreeType nV(void) const noexcept;
+
+    DegreeType nE(void) const noexcept;
+
+    /**
+     * @brief version of the graph when the snapshot was taken
+     */
+    size_t version(void) const noexcept;
+
+    HornetDeviceT device(void) noexcept;
+
+    /**
+     * @brief release the snapshot before its destruction
+     */
+    void release(void) noexcept;
+
+private:
+    HornetT*                               _hornet;
+    SoAData<VertexTypes, DeviceType::DEVICE> _vertex_data;
+    VertexType                             _nV;
+    DegreeType                             _nE;
+    size_t                                 _version;
+
+    HornetSnapshot(HornetT& hornet) noexcept;
+};
+
+} // namespace gpu
+} // namespace hornet
+#endif
@@ -0,0 +1,334 @@
+/*
+ * Copyright (c) 2019, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef HOST_GRAPH_CUH
+#define HOST_GRAPH_CUH
+
+#include "Conf/HornetConf.cuh"
+#include "HornetInitialize/HornetInit.cuh"
+#include "BatchUpdate/BatchUpdate.cuh"
+#include <algorithm>
+#include <numeric>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace hornet {
+namespace host {
+
+template <typename, typename = EMPTY, typename = DEGREE_T>
+class HostGraph;
+
+template <typename, typename = EMPTY, typename = DEGREE_T>
+class HostCSR;
+
+/**
+ * @brief CSR in host memory of a `HostGraph` (`HostGraph::freeze`)
+ * @details the edge fields are stored by column, `init()` for
+ *          `gpu::HornetStatic`, `gpu::Hornet` and `HostGraph`
+ */
+template <typename... EdgeMetaTypes, typename vid_t, typename degree_t>
+class HostCSR<vid_t, TypeList<EdgeMetaTypes...>, degree_t> {
+public:
+    using HInitT = HornetInit<vid_t, EMPTY, TypeList<EdgeMetaTypes...>,
+                              degree_t>;
+
+    HostCSR(vid_t nV, degree_t nE) :
+            _offsets(nV + 1, 0),
+            _edges(std::vector<vid_t>(nE), std::vector<EdgeMetaTypes>(nE)...) {}
+
+    vid_t nV(void) const noexcept {
+        return static_cast<vid_t>(_offsets.size()) - 1;
+    }
+
+    degree_t nE(void) const noexcept {
+        return static_cast<degree_t>(std::get<0>(_edges).size());
+    }
+
+    degree_t* csr_offsets(void) noexcept {
+        return _offsets.data();
+    }
+
+    ///column `N` of the edges: 0 destinations, 1.. metadata
+    template <unsigned N>
+    typename xlib::SelectType<N, vid_t, EdgeMetaTypes...>::type*
+    edge_field(void) noexcept {
+        return std::get<N>(_edges).data();
+    }
+
+    ///@warning valid while the CSR is alive
+    HInitT init(void) noexcept {
+        return init(Indices());
+    }
+
+private:
+    using Indices = std::make_index_sequence<sizeof...(EdgeMetaTypes)>;
+    using Fields  = std::make_index_sequence<sizeof...(EdgeMetaTypes) + 1>;
+
+    std::vector<degree_t>                                      _offsets;
+    std::tuple<std::vector<vid_t>, std::vector<EdgeMetaTypes>...> _edges;
+
+    template <size_t... I>
+    HInitT init(std::index_sequence<I...>) noexcept {
+        HInitT h_init(nV(), nE(), csr_offsets(), edge_field<0>());
+        h_init.insertEdgeData(edge_field<I + 1>()...);
+        return h_init;
+    }
+};
+
+/**
+ * @brief Dynamic graph in host memory with the update semantics of
+ *        `gpu::Hornet`
+ * @details reference for the tests and host backend of the benchmarks.
+ *          `insert` appends, `erase` removes one occurrence of every batch
+ *          edge and moves the last edge of the adjacency list in the hole,
+ *          `erase_if` keeps the order of the adjacency lists.
+ *          The updates run in parallel over the batch sources (OpenMP)
+ */
+template <typename... EdgeMetaTypes, typename vid_t, typename degree_t>
+class HostGraph<vid_t, TypeList<EdgeMetaTypes...>, degree_t> {
+public:
+    using EdgeT     = std::tuple<vid_t, EdgeMetaTypes...>;
+    using BatchPtrT = BatchUpdatePtr<vid_t, TypeList<EdgeMetaTypes...>,
+                                     DeviceType::HOST, degree_t>;
+    using HostCSRT  = HostCSR<vid_t, TypeList<EdgeMetaTypes...>, degree_t>;
+
+    explicit HostGraph(vid_t nV = 0) : _adjacency(nV) {}
+
+    template <typename... VertexMetaTypes>
+    explicit HostGraph(HornetInit<vid_t, TypeList<VertexMetaTypes...>,
+                                  TypeList<EdgeMetaTypes...>, degree_t>& init) :
+            _adjacency(init.nV()), _nE(init.nE()) {
+        auto offsets = init.csr_offsets();
+        auto ptr     = init.edge_data_ptr();
+        #pragma omp parallel for schedule(dynamic, 1024)
+        for (vid_t v = 0; v < init.nV(); v++) {
+            _adjacency[v].reserve(offsets[v + 1] - offsets[v]);
+            for (auto i = offsets[v]; i < offsets[v + 1]; i++)
+                _adjacency[v].push_back(make_edge<0>(ptr, i, Indices()));
+        }
+    }
+
+    void insert(const BatchPtrT& batch, bool removeBatchDuplicates = false,
+                bool removeGraphDuplicates = false) {
+        auto ptr   = batch.get_ptr();
+        auto order = sort_batch(batch, removeBatchDuplicates);
+        auto runs  = source_runs(ptr, order);
+        degree_t num_inserted = 0;
+        #pragma omp parallel for schedule(dynamic) reduction(+:num_inserted)
+        for (size_t r = 0; r < runs.size() - 1; r++) {
+            auto& list = _adjacency[src(ptr, order[runs[r]])];
+            auto  old_degree = list.size();
+            for (auto k = runs[r]; k < runs[r + 1]; k++) {
+                auto i = order[k];
+                if (removeGraphDuplicates &&
+                        find(list, old_degree, dst(ptr, i)) != old_degree)
+                    continue;
+                list.push_back(make_edge<1>(ptr, i, Indices()));
+                num_inserted++;
+            }
+        }
+        _nE += num_inserted;
+    }
+
+    void erase(const BatchPtrT& batch, bool removeBatchDuplicates = false) {
+        auto ptr   = batch.get_ptr();
+        auto order = sort_batch(batch, removeBatchDuplicates);
+        auto runs  = source_runs(ptr, order);
+        degree_t num_erased = 0;
+        #pragma omp parallel for schedule(dynamic) reduction(+:num_erased)
+        for (size_t r = 0; r < runs.size() - 1; r++) {
+            auto& list = _adjacency[src(ptr, order[runs[r]])];
+            for (auto k = runs[r]; k < runs[r + 1]; k++) {
+                auto pos = find(list, list.size(), dst(ptr, order[k]));
+                if (pos == list.size())
+                    continue;
+                list[pos] = list.back();
+                list.pop_back();
+                num_erased++;
+            }
+        }
+        _nE -= num_erased;
+    }
+
+    /**
+     * @brief erase the edges for which `pred(src, edge)` is true, keeping the
+     *        order of the other edges
+     * @return number of erased edges
+     */
+    template <typename Predicate>
+    degree_t erase_if(const Predicate& pred) {
+        degree_t num_erased = 0;
+        #pragma omp parallel for schedule(dynamic, 1024) reduction(+:num_erased)
+        for (vid_t v = 0; v < nV(); v++) {
+            auto& list = _adjacency[v];
+            auto  last = std::remove_if(list.begin(), list.end(),
+                    [&](const EdgeT& edge) { return pred(v, edge); });
+            num_erased += static_cast<degree_t>(list.end() - last);
+            list.erase(last, list.end());
+        }
+        _nE -= num_erased;
+        return num_erased;
+    }
+
+    ///`erase_if` on the edges whose metadata field `N` is smaller than `time`
+    template <unsigned N = 0>
+    degree_t expire_before(
+            typename xlib::SelectType<N, EdgeMetaTypes...>::type time) {
+        return erase_if([time](vid_t, const EdgeT& edge) {
+                            return std::get<N + 1>(edge) < time;
+                        });
+    }
+
+    ///sort every adjacency list by destination
+    void sort(void) {
+        #pragma omp parallel for schedule(dynamic, 1024)
+        for (vid_t v = 0; v < nV(); v++) {
+            std::stable_sort(_adjacency[v].begin(), _adjacency[v].end(),
+                    [](const EdgeT& a, const EdgeT& b) {
+                        return std::get<0>(a) < std::get<0>(b);
+                    });
+        }
+    }
+
+    /**
+     * @brief compact CSR copy of the graph
+     * @param[in] sort sort the adjacency lists of the copy by destination
+     *            (stable), the graph is not changed
+     */
+    HostCSRT freeze(bool sort = false) const {
+        HostCSRT csr(nV(), _nE);
+        auto offsets = csr.csr_offsets();
+        for (vid_t v = 0; v < nV(); v++)
+            offsets[v + 1] = offsets[v] + degree(v);
+
+        #pragma omp parallel for schedule(dynamic, 1024)
+        for (vid_t v = 0; v < nV(); v++) {
+            const auto& list = _adjacency[v];
+            std::vector<degree_t> order(list.size());
+            std::iota(order.begin(), order.end(), 0);
+            if (sort) {
+                std::stable_sort(order.begin(), order.end(),
+                        [&](degree_t a, degree_t b) {
+                            return std::get<0>(list[a]) < std::get<0>(list[b]);
+                        });
+            }
+            for (size_t j = 0; j < order.size(); j++)
+                set_edge(csr, offsets[v] + j, list[order[j]], Fields());
+        }
+        return csr;
+    }
+
+    vid_t nV(void) const noexcept {
+        return static_cast<vid_t>(_adjacency.size());
+    }
+
+    degree_t nE(void) const noexcept {
+        return _nE;
+    }
+
+    degree_t degree(vid_t v) const noexcept {
+        return static_cast<degree_t>(_adjacency[v].size());
+    }
+
+    const std::vector<EdgeT>& adjacency(vid_t v) const noexcept {
+        return _adjacency[v];
+    }
+
+    ///bytes allocated for the adjacency lists
+    size_t memory_bytes(void) const noexcept {
+        size_t bytes = _adjacency.capacity() * sizeof(std::vector<EdgeT>);
+        for (const auto& list : _adjacency)
+            bytes += list.capacity() * sizeof(EdgeT);
+        return bytes;
+    }
+
+private:
+    using Indices = std::make_index_sequence<sizeof...(EdgeMetaTypes)>;
+    using Fields  = std::make_index_sequence<sizeof...(EdgeMetaTypes) + 1>;
+
+    std::vector<std::vector<EdgeT>> _adjacency;
+    degree_t                        _nE { 0 };
+
+    //edge `i` of a SoA whose destination is the column `OFFSET`
+    template <int OFFSET, typename SoAPtrT, size_t... I>
+    static EdgeT make_edge(SoAPtrT& ptr, degree_t i,
+                           std::index_sequence<I...>) {
+        return EdgeT(ptr.template get<OFFSET>()[i],
+                     ptr.template get<OFFSET + 1 + I>()[i]...);
+    }
+
+    template <size_t... I>
+    static void set_edge(HostCSRT& csr, degree_t i, const EdgeT& edge,
+                         std::index_sequence<I...>) {
+        int dummy[] = { (csr.template edge_field<I>()[i] = std::get<I>(edge),
+                         0)... };
+        (void) dummy;
+    }
+
+    template <typename SoAPtrT>
+    static vid_t src(SoAPtrT& ptr, degree_t i) {
+        return ptr.template get<0>()[i];
+    }
+
+    template <typename SoAPtrT>
+    static vid_t dst(SoAPtrT& ptr, degree_t i) {
+        return ptr.template get<1>()[i];
+    }
+
+    static size_t find(const std::vector<EdgeT>& list, size_t size, vid_t dst) {
+        for (size_t j = 0; j < size; j++) {
+            if (std::get<0>(list[j]) == dst)
+                return j;
+        }
+        return size;
+    }
+
+    //batch indices sorted by (src, dst), the first of the duplicates kept
+    std::vector<degree_t> sort_batch(const BatchPtrT& batch,
+                                     bool removeBatchDuplicates) const {
+        auto ptr = batch.get_ptr();
+        std::vector<degree_t> order(batch.nE());
+        std::iota(order.begin(), order.end(), 0);
+        auto key = [&](degree_t i) {
+            return std::make_pair(src(ptr, i), dst(ptr, i));
+        };
+        std::stable_sort(order.begin(), order.end(),
+                [&](degree_t a, degree_t b) { return key(a) < key(b); });
+        if (removeBatchDuplicates) {
+            order.erase(std::unique(order.begin(), order.end(),
+                    [&](degree_t a, degree_t b) { return key(a) == key(b); }),
+                    order.end());
+        }
+        return order;
+    }
+
+    //boundaries of the runs with the same source in `order`
+    template <typename SoAPtrT>
+    static std::vector<size_t> source_runs(SoAPtrT& ptr,
+                                           const std::vector<degree_t>& order) {
+        std::vector<size_t> runs { 0 };
+        for (size_t k = 1; k <= order.size(); k++) {
+            if (k == order.size() ||
+                    src(ptr, order[k]) != src(ptr, order[k - 1]))
+                runs.push_back(k);
+        }
+        return runs;
+    }
+};
+
+} // namespace host
+} // namespace hornet
+#endif
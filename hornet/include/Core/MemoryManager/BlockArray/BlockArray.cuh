@@ -121,6 +121,9 @@ class BlockArrayManager<TypeList<Ts...>, device_t, degree_t> {
 
     degree_t largest_edge_block_size(void) noexcept;
 
+    ///bytes allocated by all the block arrays
+    size_t mem_size(void) noexcept;
+
     void removeAll(void) noexcept;
 
     void sort(void);
@@ -190,6 +190,17 @@ largest_edge_block_size(void) noexcept {
     return _largest_eb_size;
 }
 
+template<typename... Ts, DeviceType device_t, typename degree_t>
+size_t
+B_A_MANAGER::
+mem_size(void) noexcept {
+    size_t bytes = 0;
+    for (auto &b : _ba_map) {
+        for (auto &ba : b) { bytes += ba.second.mem_size(); }
+    }
+    return bytes;
+}
+
 template<typename... Ts, DeviceType device_t, typename degree_t>
 void
 B_A_MANAGER::
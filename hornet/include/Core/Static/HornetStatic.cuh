@@ -36,11 +36,14 @@ public:
 
 private:
 
+    template <typename, typename, typename, typename> friend class Hornet;
+
     static int _instance_count;
 
     vid_t    _nV { 0 };
     degree_t _nE { 0 };
     int      _id { 0 };
+    size_t   _version { next_graph_version() };
 
     SoAData<
         TypeList<degree_t, xlib::byte_t*, degree_t, degree_t, VertexMetaTypes...>,
@@ -52,6 +55,9 @@ private:
 
     void initialize(HInitT& h_init, DeviceType h_init_type) noexcept;
 
+    //uninitialized storage, filled on the device by `Hornet::freeze`
+    HornetStatic(vid_t nV, degree_t nE) noexcept;
+
 public:
 
     HornetStatic(HInitT& h_init, DeviceType h_init_type = DeviceType::HOST) noexcept;
@@ -62,6 +68,11 @@ public:
 
     degree_t nE(void) const noexcept;
 
+    /**
+     * @brief the graph is immutable: the version never changes
+     */
+    size_t version(void) const noexcept;
+
     HornetDeviceT device(void) noexcept;
 
     vid_t max_degree_id(void) const noexcept;
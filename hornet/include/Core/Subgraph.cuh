@@ -0,0 +1,103 @@
+/*
+ * Copyright (c) 2019, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef SUBGRAPH_CUH
+#define SUBGRAPH_CUH
+
+#include "Conf/Common.cuh"
+#include "Conf/HornetConf.cuh"
+#include "HornetInitialize/HornetInit.cuh"
+#include "SoA/SoAData.cuh"
+#include <utility>
+
+#include <rmm/device_vector.hpp>
+
+namespace hornet {
+namespace gpu {
+
+template <typename, typename = EMPTY, typename = DEGREE_T>
+class Subgraph;
+
+/**
+ * @brief Compact CSR in device memory of a subgraph extracted from a
+ *        `Hornet` (`induced_subgraph`, `filter_edges`)
+ * @details with relabeling the vertices have dense ids and `id_map()[i]` is
+ *          the id in the original graph of the vertex `i`, in increasing
+ *          order; otherwise the ids are the original ones and `id_map()` is
+ *          empty. The adjacency lists keep the order of the original graph
+ */
+template <typename... EdgeMetaTypes, typename vid_t, typename degree_t>
+class Subgraph<vid_t, TypeList<EdgeMetaTypes...>, degree_t> {
+public:
+    using HInitT = HornetInit<vid_t, EMPTY, TypeList<EdgeMetaTypes...>,
+                              degree_t>;
+
+    Subgraph(vid_t nV, degree_t nE) :
+            _nV(nV), _nE(nE), _offsets(nV + 1, 0), _edge_data(nE) {}
+
+    vid_t nV(void) const noexcept {
+        return _nV;
+    }
+
+    degree_t nE(void) const noexcept {
+        return _nE;
+    }
+
+    degree_t* csr_offsets(void) noexcept {
+        return _offsets.data().get();
+    }
+
+    vid_t* csr_edges(void) noexcept {
+        return _edge_data.get_soa_ptr().template get<0>();
+    }
+
+    SoAPtr<vid_t, EdgeMetaTypes...> edge_data_ptr(void) noexcept {
+        return _edge_data.get_soa_ptr();
+    }
+
+    rmm::device_vector<vid_t>& id_map(void) noexcept {
+        return _id_map;
+    }
+
+    /**
+     * @brief device arrays of the subgraph for
+     *        `HornetStatic(init, DeviceType::DEVICE)`
+     * @warning valid while the subgraph is alive
+     */
+    HInitT init(void) noexcept {
+        return init(std::make_index_sequence<sizeof...(EdgeMetaTypes)>());
+    }
+
+private:
+    using EdgeDataT = SoAData<TypeList<vid_t, EdgeMetaTypes...>,
+                              DeviceType::DEVICE>;
+
+    vid_t                        _nV;
+    degree_t                     _nE;
+    rmm::device_vector<degree_t> _offsets;
+    EdgeDataT                    _edge_data;
+    rmm::device_vector<vid_t>    _id_map;
+
+    template <size_t... I>
+    HInitT init(std::index_sequence<I...>) noexcept {
+        HInitT h_init(_nV, _nE, csr_offsets(), csr_edges());
+        h_init.insertEdgeData(edge_data_ptr().template get<I + 1>()...);
+        return h_init;
+    }
+};
+
+} // namespace gpu
+} // namespace hornet
+#endif
@@ -0,0 +1,173 @@
+/*
+ * Copyright (c) 2019, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef UPDATE_PIPELINE_HPP
+#define UPDATE_PIPELINE_HPP
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace hornet {
+
+/**
+ * @brief Two-stage ordered pipeline of graph updates
+ * @details Every update is split in a `prepare` stage, which must not depend
+ *          on the graph (e.g. sorting the batch), and an `apply` stage, which
+ *          modifies the graph. Each stage runs on its own thread in submission
+ *          order, so `prepare` of update N+1 overlaps `apply` of update N
+ *          while the updates are applied exactly in submission order.
+ *          The returned future holds the value of `apply` (the graph version).
+ *          `wait()` is the consistency point: when it returns all submitted
+ *          updates have been applied.
+ * @remark the class has no device code and can be used by any backend
+ */
+class UpdatePipeline {
+public:
+    using PrepareFunction = std::function<void()>;
+    using ApplyFunction   = std::function<size_t()>;
+
+    UpdatePipeline() :
+        _prepare_thread(&UpdatePipeline::prepare_loop, this),
+        _apply_thread(&UpdatePipeline::apply_loop, this) {}
+
+    UpdatePipeline(const UpdatePipeline&) = delete;
+
+    UpdatePipeline& operator=(const UpdatePipeline&) = delete;
+
+    /**
+     * @brief all submitted updates are applied before the threads terminate
+     */
+    ~UpdatePipeline() {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _stop = true;
+        }
+        _prepare_cv.notify_all();
+        _apply_cv.notify_all();
+        _prepare_thread.join();
+        _apply_thread.join();
+    }
+
+    std::shared_future<size_t> submit(PrepareFunction prepare,
+                                      ApplyFunction   apply) {
+        Task task { std::move(prepare),
+                    std::packaged_task<size_t()>(std::move(apply)) };
+        auto future = task.apply.get_future().share();
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _prepare_queue.push_back(std::move(task));
+            _num_pending++;
+        }
+        _prepare_cv.notify_one();
+        return future;
+    }
+
+    /**
+     * @brief block until all submitted updates have been applied
+     * @warning must not be called from the pipeline stages
+     */
+    void wait() {
+        std::unique_lock<std::mutex> lock(_mutex);
+        _done_cv.wait(lock, [this] { return _num_pending == 0; });
+    }
+
+    /**
+     * @brief number of submitted updates not yet applied
+     */
+    int pending() const {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _num_pending;
+    }
+
+    /**
+     * @brief `true` if the caller is one of the pipeline stages
+     */
+    bool is_stage_thread() const noexcept {
+        auto id = std::this_thread::get_id();
+        return id == _prepare_thread.get_id() || id == _apply_thread.get_id();
+    }
+
+private:
+    struct Task {
+        PrepareFunction              prepare;
+        std::packaged_task<size_t()> apply;
+    };
+
+    mutable std::mutex      _mutex;
+    std::condition_variable _prepare_cv;
+    std::condition_variable _apply_cv;
+    std::condition_variable _done_cv;
+    std::deque<Task>        _prepare_queue;
+    std::deque<Task>        _apply_queue;
+    int                     _num_pending { 0 };
+    bool                    _stop        { false };
+    std::thread             _prepare_thread;
+    std::thread             _apply_thread;
+
+    void prepare_loop() {
+        while (true) {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _prepare_cv.wait(lock, [this] {
+                return _stop || !_prepare_queue.empty();
+            });
+            if (_prepare_queue.empty())
+                return;
+            auto task = std::move(_prepare_queue.front());
+            _prepare_queue.pop_front();
+            lock.unlock();
+
+            if (task.prepare)
+                task.prepare();
+
+            lock.lock();
+            _apply_queue.push_back(std::move(task));
+            lock.unlock();
+            _apply_cv.notify_one();
+        }
+    }
+
+    void apply_loop() {
+        while (true) {
+            std::unique_lock<std::mutex> lock(_mutex);
+            //a task can still be in the prepare stage when stopping
+            _apply_cv.wait(lock, [this] {
+                return !_apply_queue.empty() ||
+                       (_stop && _num_pending == 0);
+            });
+            if (_apply_queue.empty())
+                return;
+            auto task = std::move(_apply_queue.front());
+            _apply_queue.pop_front();
+            lock.unlock();
+
+            task.apply();
+
+            lock.lock();
+            _num_pending--;
+            lock.unlock();
+            _done_cv.notify_all();
+            _apply_cv.notify_one();
+        }
+    }
+};
+
+} // namespace hornet
+#endif
@@ -0,0 +1,205 @@
+/*
+ * Copyright (c) 2019, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef UPDATE_TRACE_CUH
+#define UPDATE_TRACE_CUH
+
+#include "Conf/HornetConf.cuh"
+#include "SoA/SoAData.cuh"
+#include "BatchUpdate/BatchUpdate.cuh"
+#include <Host/Basic.hpp>   //ERROR
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace hornet {
+
+/**
+ * Binary trace of the batches applied to a graph.
+ *
+ * Header: `"HUTR"`, format version, `sizeof(vid_t)`, `sizeof(degree_t)`,
+ * number of edge metadata fields and their sizes (`uint32_t` each).
+ * Then one record for every batch: operation (`uint8_t`), flags (`uint8_t`,
+ * bit 0 remove batch duplicates, bit 1 remove graph duplicates), number of
+ * edges (`uint64_t`) and the columns of the batch: sources, destinations,
+ * then every metadata field.
+ */
+enum class TraceOp : uint8_t { INSERT = 0, ERASE = 1 };
+
+namespace detail {
+
+const char     TRACE_MAGIC[4]  = { 'H', 'U', 'T', 'R' };
+const uint32_t TRACE_VERSION   = 1;
+const uint8_t  TRACE_BATCH_DUP = 1;
+const uint8_t  TRACE_GRAPH_DUP = 2;
+
+template <typename... Ts>
+std::vector<uint32_t> trace_header(void) {
+    return { TRACE_VERSION, sizeof(Ts)... };
+}
+
+} // namespace detail
+
+template <typename, typename = EMPTY, typename = DEGREE_T>
+class UpdateTraceWriter;
+
+template <typename, typename = EMPTY, typename = DEGREE_T>
+class UpdateTraceReader;
+
+template <typename... EdgeMetaTypes, typename vid_t, typename degree_t>
+class UpdateTraceWriter<vid_t, TypeList<EdgeMetaTypes...>, degree_t> {
+public:
+    explicit UpdateTraceWriter(const std::string& filename) :
+            _file(filename, std::ios::binary | std::ios::trunc) {
+        if (!_file.is_open())
+            ERROR("Unable to write the trace: ", filename)
+        auto header = detail::trace_header<vid_t, degree_t, EdgeMetaTypes...>();
+        header.insert(header.begin() + 3, sizeof...(EdgeMetaTypes));
+        _file.write(detail::TRACE_MAGIC, sizeof(detail::TRACE_MAGIC));
+        write_raw(header.data(), header.size());
+    }
+
+    /**
+     * @brief append a batch of `num_edges` edges stored in `device_t` memory
+     */
+    void write(TraceOp op, bool removeBatchDuplicates,
+               bool removeGraphDuplicates,
+               SoAPtr<vid_t, vid_t, EdgeMetaTypes...> ptr,
+               DeviceType device_t, degree_t num_edges) {
+        SoAData<TypeList<vid_t, vid_t, EdgeMetaTypes...>, DeviceType::HOST>
+            h_edges(num_edges);
+        h_edges.copy(ptr, device_t, num_edges);
+        uint8_t flags = (removeBatchDuplicates ? detail::TRACE_BATCH_DUP : 0) |
+                        (removeGraphDuplicates ? detail::TRACE_GRAPH_DUP : 0);
+        uint64_t num_items = num_edges;
+
+        std::lock_guard<std::mutex> lock(_mutex);
+        write_raw(reinterpret_cast<uint8_t*>(&op), 1);
+        write_raw(&flags, 1);
+        write_raw(&num_items, 1);
+        write_columns(h_edges.get_soa_ptr(), num_edges, Columns());
+        _file.flush();
+        _num_batches++;
+    }
+
+    size_t num_batches(void) const noexcept {
+        return _num_batches;
+    }
+
+private:
+    using Columns = std::make_index_sequence<2 + sizeof...(EdgeMetaTypes)>;
+
+    std::ofstream _file;
+    std::mutex    _mutex;
+    size_t        _num_batches { 0 };
+
+    template <typename T>
+    void write_raw(const T* data, size_t count) {
+        _file.write(reinterpret_cast<const char*>(data), count * sizeof(T));
+    }
+
+    template <typename SoAPtrT, size_t... I>
+    void write_columns(SoAPtrT ptr, degree_t num_edges,
+                       std::index_sequence<I...>) {
+        int dummy[] = { (write_raw(ptr.template get<I>(), num_edges), 0)... };
+        (void) dummy;
+    }
+};
+
+template <typename... EdgeMetaTypes, typename vid_t, typename degree_t>
+class UpdateTraceReader<vid_t, TypeList<EdgeMetaTypes...>, degree_t> {
+public:
+    /**
+     * @brief batch of the trace in host memory
+     */
+    struct Batch {
+        TraceOp  op                    { TraceOp::INSERT };
+        bool     removeBatchDuplicates { false };
+        bool     removeGraphDuplicates { false };
+        degree_t nE                    { 0 };
+        SoAData<TypeList<vid_t, vid_t, EdgeMetaTypes...>, DeviceType::HOST>
+            edges;
+
+        BatchUpdatePtr<vid_t, TypeList<EdgeMetaTypes...>, DeviceType::HOST,
+                       degree_t>
+        ptr(void) noexcept {
+            return BatchUpdatePtr<vid_t, TypeList<EdgeMetaTypes...>,
+                                  DeviceType::HOST, degree_t>(nE,
+                                          edges.get_soa_ptr());
+        }
+    };
+
+    explicit UpdateTraceReader(const std::string& filename) :
+            _file(filename, std::ios::binary) {
+        if (!_file.is_open())
+            ERROR("Unable to read the trace: ", filename)
+        auto expected = detail::trace_header<vid_t, degree_t, EdgeMetaTypes...>();
+        expected.insert(expected.begin() + 3, sizeof...(EdgeMetaTypes));
+        char magic[sizeof(detail::TRACE_MAGIC)];
+        std::vector<uint32_t> header(expected.size());
+        _file.read(magic, sizeof(magic));
+        read_raw(header.data(), header.size());
+        if (!_file || std::memcmp(magic, detail::TRACE_MAGIC, sizeof(magic)) != 0
+                || header != expected) {
+            ERROR("The trace does not match the graph types: ", filename)
+        }
+    }
+
+    /**
+     * @brief read the next batch
+     * @return `false` at the end of the trace
+     */
+    bool next(Batch& batch) {
+        uint8_t  op, flags;
+        uint64_t num_items;
+        read_raw(&op, 1);
+        read_raw(&flags, 1);
+        read_raw(&num_items, 1);
+        if (!_file) { return false; }
+        batch.op                    = static_cast<TraceOp>(op);
+        batch.removeBatchDuplicates = flags & detail::TRACE_BATCH_DUP;
+        batch.removeGraphDuplicates = flags & detail::TRACE_GRAPH_DUP;
+        batch.nE                    = static_cast<degree_t>(num_items);
+        batch.edges.resize(batch.nE);
+        read_columns(batch.edges.get_soa_ptr(), batch.nE, Columns());
+        if (!_file)
+            ERROR("Truncated trace")
+        return true;
+    }
+
+private:
+    using Columns = std::make_index_sequence<2 + sizeof...(EdgeMetaTypes)>;
+
+    std::ifstream _file;
+
+    template <typename T>
+    void read_raw(T* data, size_t count) {
+        _file.read(reinterpret_cast<char*>(data), count * sizeof(T));
+    }
+
+    template <typename SoAPtrT, size_t... I>
+    void read_columns(SoAPtrT ptr, degree_t num_edges,
+                      std::index_sequence<I...>) {
+        int dummy[] = { (read_raw(ptr.template get<I>(), num_edges), 0)... };
+        (void) dummy;
+    }
+};
+
+} // namespace hornet
+#endif
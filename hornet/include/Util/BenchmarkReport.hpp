@@ -0,0 +1,92 @@
+/*
+ * Copyright (c) 2019, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @file
+ */
+#ifndef BENCHMARK_REPORT_HPP
+#define BENCHMARK_REPORT_HPP
+
+#include "BasicTypes.hpp"       //vert_t, eoff_t
+#include <ostream>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Machine-readable benchmark results
+ * @details one row for every (graph, algorithm, backend). The CSV output is
+ *          also the baseline format of `findRegressions`
+ */
+namespace hornets_nest {
+
+struct BenchmarkResult {
+    std::string graph;
+    std::string algorithm;
+    std::string backend;
+    vert_t      nV          { 0 };
+    eoff_t      nE          { 0 };
+    int         repetitions { 0 };
+    float       median_ms   { 0 };
+    float       p95_ms      { 0 };
+    float       min_ms      { 0 };
+    float       max_ms      { 0 };
+    ///edges of the graph traversed per second by one run, in millions
+    double      mteps       { 0 };
+    size_t      peak_memory { 0 };
+};
+
+/**
+ * @brief nearest-rank percentile `p` (in [0, 1]) of a sorted, non-empty
+ *        sequence
+ */
+float percentile(const std::vector<float>& sorted, double p);
+
+/**
+ * @brief fill the time columns and `mteps` of `result` from the times (ms)
+ *        of the repetitions. `result.nE` must be set
+ * @remark the median of an even number of times is the mean of the two
+ *         middle ones, `p95_ms` is the nearest-rank percentile
+ */
+void summarize(std::vector<float> times_ms, BenchmarkResult& result);
+
+/**
+ * @brief one row for every result, the text fields quoted as in RFC 4180
+ *        when they contain commas, quotes or line breaks
+ */
+void writeCSV(std::ostream& out, const std::vector<BenchmarkResult>& results);
+
+void writeJSON(std::ostream& out, const std::vector<BenchmarkResult>& results);
+
+///results written by `writeCSV`
+std::vector<BenchmarkResult> readCSV(const std::string& filename);
+
+struct Regression {
+    BenchmarkResult current;
+    float           baseline_ms { 0 };
+    ///`current.median_ms / baseline_ms`
+    double          slowdown    { 0 };
+};
+
+/**
+ * @brief the results whose median time is more than `threshold` (relative)
+ *        slower than the baseline row with the same graph, algorithm and
+ *        backend. The results without a baseline row are ignored
+ */
+std::vector<Regression>
+findRegressions(const std::vector<BenchmarkResult>& current,
+                const std::vector<BenchmarkResult>& baseline,
+                double threshold);
+
+} // namespace hornets_nest
+#endif
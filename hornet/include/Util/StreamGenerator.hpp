@@ -0,0 +1,159 @@
+/*
+ * Copyright (c) 2019, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @file
+ */
+#ifndef STREAM_GENERATOR_HPP
+#define STREAM_GENERATOR_HPP
+
+#include "BasicTypes.hpp"       //vert_t, eoff_t
+#include <Graph/GraphStd.hpp>   //GraphStd
+#include <cstdint>
+#include <deque>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @brief Deterministic generators of graphs and update streams
+ * @details The output depends only on the seed and on the parameters, not on
+ *          the number of OpenMP threads: the edges are generated in fixed
+ *          chunks, each with its own random engine. The batches are host
+ *          arrays for `BatchUpdatePtr<vert_t, EMPTY, DeviceType::HOST>`
+ */
+namespace hornets_nest {
+
+struct EdgeBatch {
+    std::vector<vert_t> src;
+    std::vector<vert_t> dst;
+
+    int  size(void) const noexcept;
+    void clear(void) noexcept;
+};
+
+/**
+ * @brief R-MAT quadrant probabilities, `d = 1 - a - b - c`
+ * @details the default values are the Graph500 Kronecker initiator
+ */
+struct RMatParams {
+    double a        { 0.57 };
+    double b        { 0.19 };
+    double c        { 0.19 };
+    ///relative perturbation of the probabilities at every level
+    double noise    { 0.1 };
+    ///relabel the vertices: the hubs are not the smallest ids
+    bool   scramble { true };
+};
+
+/**
+ * @brief R-MAT (Kronecker) graph with `2^scale` vertices and `num_edges`
+ *        directed edges, duplicates and self-loops included
+ */
+EdgeBatch generateRMat(int scale, eoff_t num_edges, uint64_t seed,
+                       const RMatParams& params = RMatParams());
+
+//------------------------------------------------------------------------------
+
+/**
+ * @brief Preferential attachment (Barabasi-Albert) stream
+ * @details every new vertex links to `edges_per_vertex` existing vertices
+ *          chosen with probability proportional to their degree, so the
+ *          degrees follow a power law over time. The vertex ids grow: the
+ *          graph must have room for them (`Hornet::insert_vertices`)
+ */
+class PreferentialAttachmentStream {
+public:
+    /**
+     * @param[in] initial_nV vertices of the initial ring
+     */
+    PreferentialAttachmentStream(vert_t initial_nV, int edges_per_vertex,
+                                 uint64_t seed);
+
+    ///edges of the initial ring
+    EdgeBatch initial_edges(void) const;
+
+    ///edges of the next `num_vertices` vertices, in arrival order
+    EdgeBatch next(vert_t num_vertices);
+
+    vert_t nV(void) const noexcept;
+
+private:
+    std::mt19937_64     _gen;
+    //every edge adds both endpoints: uniform picks are degree-weighted
+    std::vector<vert_t> _endpoints;
+    vert_t              _initial_nV;
+    vert_t              _nV;
+    int                 _edges_per_vertex;
+};
+
+//------------------------------------------------------------------------------
+
+struct UpdateStreamConfig {
+    uint64_t seed            { 0 };
+    ///fraction of insertions among the updates of a batch
+    double   insert_ratio    { 0.5 };
+    ///fraction of the vertices that receive skewed traffic
+    double   hot_fraction    { 0.01 };
+    ///probability that an endpoint of an insertion is a hot vertex
+    double   hot_probability { 0.5 };
+    ///edges expire `window` batches after their insertion, 0: never
+    int      window          { 0 };
+};
+
+struct UpdateBatch {
+    EdgeBatch insertions;
+    ///apply before `insertions`
+    EdgeBatch deletions;
+};
+
+/**
+ * @brief Mixed insertion/deletion stream over a fixed vertex set
+ * @details the stream keeps the set of live edges: the insertions are new
+ *          edges without self-loops, the deletions are live edges chosen
+ *          uniformly, plus the edges expired from the sliding window
+ *          (on top of `batch_size`)
+ */
+class UpdateStream {
+public:
+    UpdateStream(vert_t nV, const UpdateStreamConfig& config);
+
+    ///the edges of `graph` are live, they never expire
+    UpdateStream(const graph::GraphStd<>& graph,
+                 const UpdateStreamConfig& config);
+
+    UpdateBatch next(int batch_size);
+
+    eoff_t num_live_edges(void) const noexcept;
+
+private:
+    UpdateStreamConfig                   _config;
+    std::mt19937_64                      _gen;
+    vert_t                               _nV;
+    std::vector<vert_t>                  _hot_vertices;
+    std::vector<uint64_t>                _live_edges;
+    //batch that inserted each live edge
+    std::vector<uint64_t>                _live_batches;
+    std::unordered_map<uint64_t, size_t> _live_index;
+    //edges inserted by each of the last `window` batches
+    std::deque<std::vector<uint64_t>>    _history;
+    uint64_t                             _num_batches { 0 };
+
+    void init_hot_vertices(void);
+    bool insert_live(uint64_t key, uint64_t batch_id);
+    bool erase_live(uint64_t key, uint64_t batch_id);
+};
+
+} // namespace hornets_nest
+#endif
@@ -0,0 +1,77 @@
+/*
+ * Copyright (c) 2019, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * @file
+ */
+#ifndef UTIL_SUBGRAPH_HPP
+#define UTIL_SUBGRAPH_HPP
+
+#include "BasicTypes.hpp"       //vert_t, eoff_t
+#include <Graph/GraphStd.hpp>   //GraphStd
+#include <vector>
+
+/**
+ * @brief Host counterpart of `Hornet::induced_subgraph` and
+ *        `Hornet::filter_edges`: same CSR, same ids, same edge order
+ */
+namespace hornets_nest {
+
+struct HostSubgraph {
+    std::vector<eoff_t> offsets;
+    std::vector<vert_t> edges;
+    ///original id of every vertex, empty without relabeling
+    std::vector<vert_t> id_map;
+
+    vert_t nV(void) const noexcept;
+    eoff_t nE(void) const noexcept;
+};
+
+/**
+ * @brief CSR of the edges with `keep_edge[i] != 0`
+ * @param[in] is_member vertices of the relabeled subgraph, if empty the
+ *            endpoints of the kept edges
+ */
+HostSubgraph extractSubgraph(const graph::GraphStd<>& graph,
+                             const std::vector<char>& keep_edge,
+                             const std::vector<char>& is_member,
+                             bool relabel);
+
+///subgraph induced by `vertices` (any order, duplicates allowed)
+HostSubgraph inducedSubgraph(const graph::GraphStd<>& graph,
+                             const std::vector<vert_t>& vertices,
+                             bool relabel = true);
+
+/**
+ * @brief edges for which `pred(src, dst)` is true
+ * @details with relabeling the vertices of the subgraph are the endpoints
+ *          of the selected edges
+ */
+template <typename Predicate>
+HostSubgraph filterEdges(const graph::GraphStd<>& graph,
+                         const Predicate& pred, bool relabel = false) {
+    const eoff_t* offsets = graph.csr_out_offsets();
+    const vert_t* edges   = graph.csr_out_edges();
+    std::vector<char> keep_edge(graph.nE());
+
+    #pragma omp parallel for schedule(dynamic, 64)
+    for (vert_t v = 0; v < graph.nV(); v++) {
+        for (eoff_t i = offsets[v]; i < offsets[v + 1]; i++)
+            keep_edge[i] = pred(v, edges[i]);
+    }
+    return extractSubgraph(graph, keep_edge, std::vector<char>(), relabel);
+}
+
+} // namespace hornets_nest
+#endif
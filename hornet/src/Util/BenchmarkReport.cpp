@@ -0,0 +1,199 @@
+/*
+ * Copyright (c) 2019, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "Util/BenchmarkReport.hpp"
+#include <Host/Basic.hpp>       //ERROR
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <fstream>
+#include <istream>
+
+namespace hornets_nest {
+
+namespace {
+
+const char* CSV_HEADER = "graph,algorithm,backend,nV,nE,repetitions,"
+                         "median_ms,p95_ms,min_ms,max_ms,mteps,peak_memory";
+
+//graph names are file names: only the quotes need escaping
+std::string json_string(const std::string& str) {
+    std::string escaped = "\"";
+    for (auto c : str) {
+        if (c == '"' || c == '\\')
+            escaped += '\\';
+        escaped += c;
+    }
+    return escaped + "\"";
+}
+
+//RFC 4180: the fields with commas, quotes or line breaks are quoted and
+//their quotes doubled
+std::string csv_field(const std::string& str) {
+    if (str.find_first_of(",\"\r\n") == std::string::npos)
+        return str;
+    std::string quoted = "\"";
+    for (auto c : str) {
+        if (c == '"')
+            quoted += '"';
+        quoted += c;
+    }
+    return quoted + "\"";
+}
+
+//next row of a CSV file written by csv_field, false at the end of the file
+bool read_csv_row(std::istream& in, std::vector<std::string>& fields) {
+    fields.assign(1, "");
+    bool is_quoted = false;
+    char c;
+    if (!in.get(c))
+        return false;
+    do {
+        if (is_quoted) {
+            if (c != '"')
+                fields.back() += c;
+            else if (in.peek() == '"')
+                fields.back() += static_cast<char>(in.get());
+            else
+                is_quoted = false;
+        }
+        else if (c == '"')
+            is_quoted = true;
+        else if (c == ',')
+            fields.emplace_back();
+        else if (c == '\n')
+            break;
+        else if (c != '\r')
+            fields.back() += c;
+    } while (in.get(c));
+    return true;
+}
+
+} // namespace
+
+//------------------------------------------------------------------------------
+
+float percentile(const std::vector<float>& sorted, double p) {
+    assert(!sorted.empty());
+    auto rank = static_cast<size_t>(std::ceil(p * sorted.size()));
+    return sorted[std::min(std::max<size_t>(rank, 1), sorted.size()) - 1];
+}
+
+void summarize(std::vector<float> times_ms, BenchmarkResult& result) {
+    assert(!times_ms.empty());
+    std::sort(times_ms.begin(), times_ms.end());
+    auto middle = times_ms.size() / 2;
+    result.repetitions = static_cast<int>(times_ms.size());
+    //even count: mean of the two middle times
+    result.median_ms   = times_ms.size() % 2 == 1 ? times_ms[middle] :
+                         (times_ms[middle - 1] + times_ms[middle]) / 2;
+    result.p95_ms      = percentile(times_ms, 0.95);
+    result.min_ms      = times_ms.front();
+    result.max_ms      = times_ms.back();
+    result.mteps       = result.median_ms > 0 ?
+                         result.nE / (result.median_ms * 1000.0) : 0.0;
+}
+
+void writeCSV(std::ostream& out, const std::vector<BenchmarkResult>& results) {
+    out << CSV_HEADER << "\n";
+    for (const auto& r : results) {
+        out << csv_field(r.graph) << "," << csv_field(r.algorithm) << ","
+            << csv_field(r.backend) << ","
+            << r.nV << "," << r.nE << "," << r.repetitions << ","
+            << r.median_ms << "," << r.p95_ms << "," << r.min_ms << ","
+            << r.max_ms << "," << r.mteps << "," << r.peak_memory << "\n";
+    }
+}
+
+void writeJSON(std::ostream& out, const std::vector<BenchmarkResult>& results) {
+    out << "[\n";
+    for (size_t i = 0; i < results.size(); i++) {
+        const auto& r = results[i];
+        out << "  { \"graph\": "       << json_string(r.graph)
+            << ", \"algorithm\": "     << json_string(r.algorithm)
+            << ", \"backend\": "       << json_string(r.backend)
+            << ", \"nV\": "            << r.nV
+            << ", \"nE\": "            << r.nE
+            << ", \"repetitions\": "   << r.repetitions
+            << ", \"median_ms\": "     << r.median_ms
+            << ", \"p95_ms\": "        << r.p95_ms
+            << ", \"min_ms\": "        << r.min_ms
+            << ", \"max_ms\": "        << r.max_ms
+            << ", \"mteps\": "         << r.mteps
+            << ", \"peak_memory\": "   << r.peak_memory << " }"
+            << (i + 1 < results.size() ? ",\n" : "\n");
+    }
+    out << "]\n";
+}
+
+std::vector<BenchmarkResult> readCSV(const std::string& filename) {
+    std::ifstream fin(filename);
+    if (!fin.is_open())
+        ERROR("Unable to read the baseline: ", filename)
+    std::string line;
+    std::getline(fin, line);
+    if (!line.empty() && line.back() == '\r')
+        line.pop_back();
+    if (line != CSV_HEADER)
+        ERROR("Unknown baseline format: ", filename)
+
+    std::vector<BenchmarkResult> results;
+    std::vector<std::string> fields;
+    int row = 1;
+    while (read_csv_row(fin, fields)) {
+        row++;
+        if (fields.size() == 1 && fields[0].empty())
+            continue;
+        if (fields.size() != 12)
+            ERROR("Wrong baseline row: ", row, " of ", filename)
+        BenchmarkResult r;
+        r.graph       = fields[0];
+        r.algorithm   = fields[1];
+        r.backend     = fields[2];
+        r.nV          = static_cast<vert_t>(std::stoll(fields[3]));
+        r.nE          = static_cast<eoff_t>(std::stoll(fields[4]));
+        r.repetitions = std::stoi(fields[5]);
+        r.median_ms   = std::stof(fields[6]);
+        r.p95_ms      = std::stof(fields[7]);
+        r.min_ms      = std::stof(fields[8]);
+        r.max_ms      = std::stof(fields[9]);
+        r.mteps       = std::stod(fields[10]);
+        r.peak_memory = std::stoull(fields[11]);
+        results.push_back(r);
+    }
+    return results;
+}
+
+std::vector<Regression>
+findRegressions(const std::vector<BenchmarkResult>& current,
+                const std::vector<BenchmarkResult>& baseline,
+                double threshold) {
+    std::vector<Regression> regressions;
+    for (const auto& r : current) {
+        auto it = std::find_if(baseline.begin(), baseline.end(),
+                    [&](const BenchmarkResult& b) {
+                        return b.graph == r.graph && b.algorithm == r.algorithm
+                               && b.backend == r.backend;
+                    });
+        if (it == baseline.end() || it->median_ms <= 0)
+            continue;
+        double slowdown = r.median_ms / it->median_ms;
+        if (slowdown > 1.0 + threshold)
+            regressions.push_back({ r, it->median_ms, slowdown });
+    }
+    return regressions;
+}
+
+} // namespace hornets_nest
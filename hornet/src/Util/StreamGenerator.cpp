@@ -0,0 +1,313 @@
+/*
+ * Copyright (c) 2019, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "Util/StreamGenerator.hpp"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+namespace hornets_nest {
+
+namespace {
+
+//edges generated by the same random engine
+const eoff_t CHUNK_SIZE = 1 << 16;
+
+uint64_t splitmix64(uint64_t x) {
+    x += 0x9E3779B97F4A7C15ull;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+    return x ^ (x >> 31);
+}
+
+uint64_t chunk_seed(uint64_t seed, uint64_t stream, uint64_t chunk) {
+    return splitmix64(splitmix64(seed ^ splitmix64(stream)) + chunk);
+}
+
+//the standard distributions are implementation defined: the same seed must
+//give the same stream with every compiler
+double uniform_real(std::mt19937_64& gen) {
+    return (gen() >> 11) * (1.0 / 9007199254740992.0);
+}
+
+vert_t uniform_vertex(std::mt19937_64& gen, vert_t n) {
+    return static_cast<vert_t>(gen() % static_cast<uint64_t>(n));
+}
+
+uint64_t edge_key(vert_t src, vert_t dst) {
+    return (static_cast<uint64_t>(src) << 32) | static_cast<uint32_t>(dst);
+}
+
+vert_t key_src(uint64_t key) { return static_cast<vert_t>(key >> 32); }
+vert_t key_dst(uint64_t key) { return static_cast<vert_t>(key & 0xFFFFFFFFu); }
+
+const uint64_t NEVER_EXPIRES = ~0ull;
+const uint64_t ANY_BATCH     = ~0ull - 1;
+
+//bijection of [0, 2^scale)
+uint64_t scramble_vertex(uint64_t v, int scale, uint64_t seed) {
+    uint64_t mask = (scale == 64) ? ~0ull : (1ull << scale) - 1;
+    uint64_t mul1 = splitmix64(seed) | 1;
+    uint64_t mul2 = splitmix64(seed + 1) | 1;
+    int      shift = scale / 2 + 1;
+    v = (v * mul1 + splitmix64(seed + 2)) & mask;
+    v ^= v >> shift;
+    v = (v * mul2) & mask;
+    v ^= v >> shift;
+    return v;
+}
+
+} // namespace
+
+//------------------------------------------------------------------------------
+
+int EdgeBatch::size(void) const noexcept {
+    return static_cast<int>(src.size());
+}
+
+void EdgeBatch::clear(void) noexcept {
+    src.clear();
+    dst.clear();
+}
+
+//------------------------------------------------------------------------------
+
+EdgeBatch generateRMat(int scale, eoff_t num_edges, uint64_t seed,
+                       const RMatParams& params) {
+    assert(scale > 0 && scale < 32);
+    assert(params.a + params.b + params.c < 1.0);
+    //the perturbed probabilities of every level are shared by all the edges
+    std::vector<double> level_a(scale), level_ab(scale), level_abc(scale);
+    std::mt19937_64 level_gen(chunk_seed(seed, 0, ~0ull));
+    for (int l = 0; l < scale; l++) {
+        double q[4] = { params.a, params.b, params.c,
+                        1.0 - params.a - params.b - params.c };
+        double sum = 0;
+        for (auto& p : q) {
+            p *= 1.0 - params.noise + 2.0 * params.noise * uniform_real(level_gen);
+            sum += p;
+        }
+        level_a[l]   = q[0] / sum;
+        level_ab[l]  = (q[0] + q[1]) / sum;
+        level_abc[l] = (q[0] + q[1] + q[2]) / sum;
+    }
+
+    EdgeBatch batch;
+    batch.src.resize(num_edges);
+    batch.dst.resize(num_edges);
+    eoff_t num_chunks = (num_edges + CHUNK_SIZE - 1) / CHUNK_SIZE;
+
+    #pragma omp parallel for schedule(dynamic)
+    for (eoff_t chunk = 0; chunk < num_chunks; chunk++) {
+        std::mt19937_64 gen(chunk_seed(seed, 1, chunk));
+        eoff_t end = std::min(num_edges, (chunk + 1) * CHUNK_SIZE);
+        for (eoff_t i = chunk * CHUNK_SIZE; i < end; i++) {
+            uint64_t src = 0, dst = 0;
+            for (int l = 0; l < scale; l++) {
+                double r = uniform_real(gen);
+                uint64_t src_bit = r >= level_ab[l];
+                uint64_t dst_bit = (r >= level_a[l] && r < level_ab[l]) ||
+                                   r >= level_abc[l];
+                src = (src << 1) | src_bit;
+                dst = (dst << 1) | dst_bit;
+            }
+            if (params.scramble) {
+                src = scramble_vertex(src, scale, seed);
+                dst = scramble_vertex(dst, scale, seed);
+            }
+            batch.src[i] = static_cast<vert_t>(src);
+            batch.dst[i] = static_cast<vert_t>(dst);
+        }
+    }
+    return batch;
+}
+
+//------------------------------------------------------------------------------
+
+PreferentialAttachmentStream::
+PreferentialAttachmentStream(vert_t initial_nV, int edges_per_vertex,
+                             uint64_t seed) :
+        _gen(chunk_seed(seed, 2, 0)),
+        _initial_nV(initial_nV),
+        _nV(initial_nV),
+        _edges_per_vertex(edges_per_vertex) {
+    assert(initial_nV > 1 && edges_per_vertex > 0);
+    for (vert_t v = 0; v < initial_nV; v++) {
+        _endpoints.push_back(v);
+        _endpoints.push_back((v + 1) % initial_nV);
+    }
+}
+
+EdgeBatch PreferentialAttachmentStream::initial_edges(void) const {
+    EdgeBatch batch;
+    for (vert_t v = 0; v < _initial_nV; v++) {
+        batch.src.push_back(v);
+        batch.dst.push_back((v + 1) % _initial_nV);
+    }
+    return batch;
+}
+
+EdgeBatch PreferentialAttachmentStream::next(vert_t num_vertices) {
+    //every pick depends on the previous edges: the stream is sequential
+    EdgeBatch batch;
+    batch.src.reserve(num_vertices * _edges_per_vertex);
+    batch.dst.reserve(num_vertices * _edges_per_vertex);
+    for (vert_t i = 0; i < num_vertices; i++, _nV++) {
+        //the targets are picked among the previous vertices only
+        size_t num_endpoints = _endpoints.size();
+        for (int j = 0; j < _edges_per_vertex; j++) {
+            vert_t target = _endpoints[_gen() % num_endpoints];
+            batch.src.push_back(_nV);
+            batch.dst.push_back(target);
+            _endpoints.push_back(_nV);
+            _endpoints.push_back(target);
+        }
+    }
+    return batch;
+}
+
+vert_t PreferentialAttachmentStream::nV(void) const noexcept {
+    return _nV;
+}
+
+//------------------------------------------------------------------------------
+
+UpdateStream::UpdateStream(vert_t nV, const UpdateStreamConfig& config) :
+        _config(config),
+        _gen(chunk_seed(config.seed, 3, 0)),
+        _nV(nV) {
+    assert(nV > 1);
+    init_hot_vertices();
+}
+
+UpdateStream::UpdateStream(const graph::GraphStd<>& graph,
+                           const UpdateStreamConfig& config) :
+        UpdateStream(graph.nV(), config) {
+    auto offsets = graph.csr_out_offsets();
+    auto edges   = graph.csr_out_edges();
+    for (vert_t v = 0; v < graph.nV(); v++) {
+        for (auto i = offsets[v]; i < offsets[v + 1]; i++)
+            insert_live(edge_key(v, edges[i]), NEVER_EXPIRES);
+    }
+}
+
+void UpdateStream::init_hot_vertices(void) {
+    auto num_hot = std::max<vert_t>(1,
+            static_cast<vert_t>(std::llround(_nV * _config.hot_fraction)));
+    _hot_vertices.resize(num_hot);
+    for (auto& v : _hot_vertices)
+        v = uniform_vertex(_gen, _nV);
+}
+
+bool UpdateStream::insert_live(uint64_t key, uint64_t batch_id) {
+    if (!_live_index.emplace(key, _live_edges.size()).second)
+        return false;
+    _live_edges.push_back(key);
+    _live_batches.push_back(batch_id);
+    return true;
+}
+
+bool UpdateStream::erase_live(uint64_t key, uint64_t batch_id) {
+    auto it = _live_index.find(key);
+    if (it == _live_index.end())
+        return false;
+    size_t index = it->second;
+    //the edge was erased and inserted again by a later batch
+    if (batch_id != ANY_BATCH && _live_batches[index] != batch_id)
+        return false;
+    _live_index.erase(it);
+    if (index + 1 < _live_edges.size()) {
+        _live_edges[index]   = _live_edges.back();
+        _live_batches[index] = _live_batches.back();
+        _live_index[_live_edges[index]] = index;
+    }
+    _live_edges.pop_back();
+    _live_batches.pop_back();
+    return true;
+}
+
+UpdateBatch UpdateStream::next(int batch_size) {
+    UpdateBatch batch;
+    auto erase = [&](uint64_t key, uint64_t batch_id) {
+        if (erase_live(key, batch_id)) {
+            batch.deletions.src.push_back(key_src(key));
+            batch.deletions.dst.push_back(key_dst(key));
+        }
+    };
+    //sliding window expiry
+    if (_config.window > 0 &&
+            _history.size() == static_cast<size_t>(_config.window)) {
+        uint64_t expired_batch = _num_batches - _config.window;
+        for (auto key : _history.front())
+            erase(key, expired_batch);
+        _history.pop_front();
+    }
+
+    int num_insertions = static_cast<int>(
+            std::llround(batch_size * _config.insert_ratio));
+    int num_deletions  = std::min<eoff_t>(batch_size - num_insertions,
+                                          _live_edges.size());
+    for (int i = 0; i < num_deletions; i++)
+        erase(_live_edges[_gen() % _live_edges.size()], ANY_BATCH);
+
+    //candidate insertions in parallel, then a sequential filter of the
+    //duplicates and of the self-loops
+    std::vector<uint64_t> candidates(num_insertions);
+    int num_chunks = (num_insertions + CHUNK_SIZE - 1) / CHUNK_SIZE;
+    uint64_t stream_id = 4 + _num_batches;
+    auto draw_vertex = [&](std::mt19937_64& gen) {
+        if (uniform_real(gen) < _config.hot_probability) {
+            return _hot_vertices[gen() % _hot_vertices.size()];
+        }
+        return uniform_vertex(gen, _nV);
+    };
+
+    #pragma omp parallel for schedule(dynamic)
+    for (int chunk = 0; chunk < num_chunks; chunk++) {
+        std::mt19937_64 gen(chunk_seed(_config.seed, stream_id, chunk));
+        int end = std::min(num_insertions, (chunk + 1) * CHUNK_SIZE);
+        for (int i = chunk * CHUNK_SIZE; i < end; i++) {
+            vert_t src = draw_vertex(gen);
+            vert_t dst = draw_vertex(gen);
+            candidates[i] = edge_key(src, dst);
+        }
+    }
+
+    const int MAX_ATTEMPTS = 16;
+    std::vector<uint64_t> inserted;
+    inserted.reserve(num_insertions);
+    for (auto key : candidates) {
+        for (int attempt = 0; attempt < MAX_ATTEMPTS; attempt++) {
+            if (key_src(key) != key_dst(key) &&
+                    insert_live(key, _num_batches)) {
+                inserted.push_back(key);
+                batch.insertions.src.push_back(key_src(key));
+                batch.insertions.dst.push_back(key_dst(key));
+                break;
+            }
+            key = edge_key(draw_vertex(_gen), draw_vertex(_gen));
+        }
+    }
+    if (_config.window > 0)
+        _history.push_back(std::move(inserted));
+    _num_batches++;
+    return batch;
+}
+
+eoff_t UpdateStream::num_live_edges(void) const noexcept {
+    return static_cast<eoff_t>(_live_edges.size());
+}
+
+} // namespace hornets_nest
@@ -0,0 +1,122 @@
+/*
+ * Copyright (c) 2019, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "Util/Subgraph.hpp"
+#include <Host/Basic.hpp>       //ERROR
+#include <algorithm>
+#include <numeric>
+
+namespace hornets_nest {
+
+vert_t HostSubgraph::nV(void) const noexcept {
+    return static_cast<vert_t>(offsets.size()) - 1;
+}
+
+eoff_t HostSubgraph::nE(void) const noexcept {
+    return static_cast<eoff_t>(edges.size());
+}
+
+//------------------------------------------------------------------------------
+
+HostSubgraph extractSubgraph(const graph::GraphStd<>& graph,
+                             const std::vector<char>& keep_edge,
+                             const std::vector<char>& is_member,
+                             bool relabel) {
+    if (keep_edge.size() != static_cast<size_t>(graph.nE()))
+        ERROR("extractSubgraph: one flag for every edge expected")
+    const eoff_t* offsets = graph.csr_out_offsets();
+    const vert_t* edges   = graph.csr_out_edges();
+    vert_t        nV      = graph.nV();
+
+    std::vector<eoff_t> kept_degrees(nV);
+    #pragma omp parallel for schedule(dynamic, 64)
+    for (vert_t v = 0; v < nV; v++) {
+        kept_degrees[v] = std::count(keep_edge.begin() + offsets[v],
+                                     keep_edge.begin() + offsets[v + 1], 1);
+    }
+
+    //new_ids[v]: dense id of v, -1 if v is not in the subgraph
+    std::vector<vert_t> new_ids;
+    HostSubgraph subgraph;
+    if (relabel) {
+        std::vector<char> selected(is_member);
+        if (selected.empty()) {
+            selected.resize(nV, 0);
+            #pragma omp parallel for schedule(dynamic, 64)
+            for (vert_t v = 0; v < nV; v++) {
+                for (eoff_t i = offsets[v]; i < offsets[v + 1]; i++) {
+                    if (!keep_edge[i])
+                        continue;
+                    #pragma omp atomic write
+                    selected[v] = 1;
+                    #pragma omp atomic write
+                    selected[edges[i]] = 1;
+                }
+            }
+        }
+        new_ids.resize(nV, -1);
+        for (vert_t v = 0; v < nV; v++) {
+            if (selected[v]) {
+                new_ids[v] = static_cast<vert_t>(subgraph.id_map.size());
+                subgraph.id_map.push_back(v);
+            }
+        }
+        //the other vertices have no kept edges
+        subgraph.offsets.push_back(0);
+        for (auto v : subgraph.id_map)
+            subgraph.offsets.push_back(subgraph.offsets.back() +
+                                       kept_degrees[v]);
+    }
+    else {
+        subgraph.offsets.resize(nV + 1, 0);
+        std::partial_sum(kept_degrees.begin(), kept_degrees.end(),
+                         subgraph.offsets.begin() + 1);
+    }
+    subgraph.edges.resize(subgraph.offsets.back());
+
+    vert_t sub_nV = subgraph.nV();
+    #pragma omp parallel for schedule(dynamic, 64)
+    for (vert_t u = 0; u < sub_nV; u++) {
+        vert_t v   = relabel ? subgraph.id_map[u] : u;
+        eoff_t out = subgraph.offsets[u];
+        for (eoff_t i = offsets[v]; i < offsets[v + 1]; i++) {
+            if (keep_edge[i])
+                subgraph.edges[out++] = relabel ? new_ids[edges[i]] : edges[i];
+        }
+    }
+    return subgraph;
+}
+
+HostSubgraph inducedSubgraph(const graph::GraphStd<>& graph,
+                             const std::vector<vert_t>& vertices,
+                             bool relabel) {
+    const eoff_t* offsets = graph.csr_out_offsets();
+    const vert_t* edges   = graph.csr_out_edges();
+    std::vector<char> is_member(graph.nV(), 0);
+    for (auto v : vertices) {
+        if (v < 0 || v >= graph.nV())
+            ERROR("inducedSubgraph: vertex id out of range: ", v)
+        is_member[v] = 1;
+    }
+    std::vector<char> keep_edge(graph.nE());
+    #pragma omp parallel for schedule(dynamic, 64)
+    for (vert_t v = 0; v < graph.nV(); v++) {
+        for (eoff_t i = offsets[v]; i < offsets[v + 1]; i++)
+            keep_edge[i] = is_member[v] && is_member[edges[i]];
+    }
+    return extractSubgraph(graph, keep_edge, is_member, relabel);
+}
+
+} // namespace hornets_nest
@@ -0,0 +1,27 @@
+/**
+ * @brief Betweenness centrality benchmark, single root of largest degree
+ * @file
+ */
+#include "Static/BetweennessCentrality/bc.cuh"
+#include "Benchmark.cuh"
+
+namespace hornets_nest {
+namespace benchmark {
+
+void bcGPU(GraphSet& graph_set, Runner& runner) {
+    const auto& graph = graph_set.undirected();
+    HornetInit hornet_init(graph.nV(), graph.nE(), graph.csr_out_offsets(),
+                           graph.csr_out_edges());
+    HornetGraph hornet_graph(hornet_init);
+    BCCentrality bc(hornet_graph);
+    vid_t root = graph.max_out_degree_id();
+
+    runner.measure(graph, [&]() {
+                              bc.reset();
+                              bc.setRoot(root);
+                          },
+                          [&]() { bc.run(); });
+}
+
+} // namespace benchmark
+} // namespace hornets_nest
@@ -0,0 +1,177 @@
+/**
+ * @brief Benchmark driver of the hornetsnest algorithms
+ * @file
+ *
+ * benchmark <graph>... [--algo name,...|all] [--backend gpu|host]
+ *           [--warmup N] [--reps N] [--format csv|json] [--output file]
+ *           [--baseline file.csv] [--threshold fraction]
+ *
+ * One row for every (graph, algorithm): median/p95/min/max time of the
+ * repetitions after the warm-up runs, MTEPS and peak memory. With
+ * `--baseline`, the rows slower than the baseline median by more than
+ * `--threshold` (default 0.1) are reported and the exit code is 1
+ */
+#include "Benchmark.cuh"
+#include <Host/Basic.hpp>       //ERROR
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+using namespace hornets_nest;
+using namespace hornets_nest::benchmark;
+
+namespace {
+
+const Algorithm ALGORITHMS[] = {
+    { "spmv",        spmvGPU,       spmvHost       },
+    { "pagerank",    pageRankGPU,   pageRankHost   },
+    { "triangle",    triangleGPU,   triangleHost   },
+    { "katz",        katzGPU,       nullptr        },
+    { "core-number", coreNumberGPU, coreNumberHost },
+    { "bc",          bcGPU,         nullptr        }
+};
+
+std::vector<std::string> split(const std::string& str) {
+    std::vector<std::string> tokens;
+    std::istringstream stream(str);
+    std::string token;
+    while (std::getline(stream, token, ','))
+        tokens.push_back(token);
+    return tokens;
+}
+
+const Algorithm* find_algorithm(const std::string& name) {
+    for (const auto& algorithm : ALGORITHMS) {
+        if (name == algorithm.name)
+            return &algorithm;
+    }
+    return nullptr;
+}
+
+void print_usage(const char* program) {
+    std::cerr << "usage: " << program << " <graph>... [--algo name,...|all] "
+              << "[--backend gpu|host]\n        [--warmup N] [--reps N] "
+              << "[--format csv|json] [--output file]\n        "
+              << "[--baseline file.csv] [--threshold fraction]\n"
+              << "algorithms:";
+    for (const auto& algorithm : ALGORITHMS)
+        std::cerr << " " << algorithm.name;
+    std::cerr << std::endl;
+}
+
+} // namespace
+
+int exec(int argc, char* argv[]) {
+    BenchmarkConfig          config;
+    std::vector<std::string> graphs;
+    std::string algorithms = "all", format = "csv", output, baseline;
+    double threshold = 0.1;
+
+    for (int i = 1; i < argc; i++) {
+        std::string str(argv[i]);
+        bool has_value = i + 1 < argc;
+        if (str == "--algo" && has_value)
+            algorithms = argv[++i];
+        else if (str == "--backend" && has_value) {
+            std::string backend = argv[++i];
+            if (backend != "gpu" && backend != "host")
+                ERROR("Unknown backend: ", backend)
+            config.backend = backend == "gpu" ? Backend::GPU : Backend::HOST;
+        }
+        else if (str == "--warmup" && has_value)
+            config.warmup = std::stoi(argv[++i]);
+        else if (str == "--reps" && has_value)
+            config.repetitions = std::stoi(argv[++i]);
+        else if (str == "--format" && has_value)
+            format = argv[++i];
+        else if (str == "--output" && has_value)
+            output = argv[++i];
+        else if (str == "--baseline" && has_value)
+            baseline = argv[++i];
+        else if (str == "--threshold" && has_value)
+            threshold = std::stod(argv[++i]);
+        else if (str.compare(0, 2, "--") == 0) {
+            print_usage(argv[0]);
+            return 1;
+        }
+        else
+            graphs.push_back(str);
+    }
+    if (graphs.empty() || config.repetitions < 1 ||
+            (format != "csv" && format != "json")) {
+        print_usage(argv[0]);
+        return 1;
+    }
+
+    std::vector<const Algorithm*> selected;
+    if (algorithms == "all") {
+        for (const auto& algorithm : ALGORITHMS)
+            selected.push_back(&algorithm);
+    }
+    else {
+        for (const auto& name : split(algorithms)) {
+            auto algorithm = find_algorithm(name);
+            if (algorithm == nullptr)
+                ERROR("Unknown algorithm: ", name)
+            selected.push_back(algorithm);
+        }
+    }
+
+    bool is_host = config.backend == Backend::HOST;
+    std::vector<BenchmarkResult> results;
+    for (const auto& filename : graphs) {
+        GraphSet graph_set(filename);
+        for (auto algorithm : selected) {
+            auto benchmark_fn = is_host ? algorithm->host : algorithm->gpu;
+            if (benchmark_fn == nullptr) {
+                std::cerr << algorithm->name << ": no host implementation, "
+                          << "skipped\n";
+                continue;
+            }
+            BenchmarkResult result;
+            result.graph     = graph_set.name();
+            result.algorithm = algorithm->name;
+            result.backend   = is_host ? "host" : "gpu";
+            {
+                //the algorithm data is released before the next one
+                Runner runner(config, result);
+                benchmark_fn(graph_set, runner);
+            }
+            std::cerr << result.graph << "  " << result.algorithm << "  "
+                      << result.median_ms << " ms\n";
+            results.push_back(result);
+        }
+    }
+
+    std::ofstream fout;
+    if (!output.empty()) {
+        fout.open(output);
+        if (!fout.is_open())
+            ERROR("Unable to write: ", output)
+    }
+    std::ostream& out = output.empty() ? std::cout : fout;
+    if (format == "csv")
+        writeCSV(out, results);
+    else
+        writeJSON(out, results);
+
+    if (baseline.empty())
+        return 0;
+    auto regressions = findRegressions(results, readCSV(baseline), threshold);
+    for (const auto& r : regressions) {
+        std::cerr << "REGRESSION " << r.current.graph << "  "
+                  << r.current.algorithm << "  " << r.current.backend << "  "
+                  << r.baseline_ms << " ms -> " << r.current.median_ms
+                  << " ms  (+" << (r.slowdown - 1.0) * 100.0 << "%)\n";
+    }
+    std::cerr << (regressions.empty() ? "PASSED" : "NOT PASSED") << std::endl;
+    return !regressions.empty();
+}
+
+int main(int argc, char* argv[]) {
+    int ret = 0;
+    {
+        ret = exec(argc, argv);
+    }
+    return ret;
+}
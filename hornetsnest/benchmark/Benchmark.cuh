@@ -0,0 +1,243 @@
+/**
+ * @brief Common interface of the algorithm benchmarks
+ * @file
+ */
+#ifndef HORNETS_NEST_BENCHMARK_CUH
+#define HORNETS_NEST_BENCHMARK_CUH
+
+#include <Device/Util/Timer.cuh>
+#include <Graph/GraphStd.hpp>
+#include <Util/BenchmarkReport.hpp>
+#include <rmm/mr/device/device_memory_resource.hpp>
+#include <rmm/mr/device/per_device_resource.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+#include <sys/resource.h>       //getrusage
+#include <unistd.h>             //sysconf
+
+namespace hornets_nest {
+namespace benchmark {
+
+using GraphT = graph::GraphStd<vert_t, eoff_t>;
+
+enum class Backend { GPU, HOST };
+
+struct BenchmarkConfig {
+    int     warmup      { 1 };
+    int     repetitions { 5 };
+    Backend backend     { Backend::GPU };
+};
+
+/**
+ * @brief input graph of the benchmarks, read once for every structure
+ * @details the undirected graph has sorted adjacency lists (intersections)
+ */
+class GraphSet {
+public:
+    explicit GraphSet(const std::string& filename) : _filename(filename) {}
+
+    const GraphT& directed(void) {
+        if (!_directed) {
+            _directed.reset(new GraphT(graph::structure_prop::DIRECTED,
+                                       _filename.c_str(),
+                                       graph::parsing_prop::NONE));
+        }
+        return *_directed;
+    }
+
+    const GraphT& undirected(void) {
+        if (!_undirected) {
+            _undirected.reset(new GraphT(graph::structure_prop::UNDIRECTED,
+                                         _filename.c_str(),
+                                         graph::parsing_prop::SORT));
+        }
+        return *_undirected;
+    }
+
+    std::string name(void) const {
+        return _filename.substr(_filename.find_last_of('/') + 1);
+    }
+
+private:
+    std::string             _filename;
+    std::unique_ptr<GraphT> _directed;
+    std::unique_ptr<GraphT> _undirected;
+};
+
+/**
+ * @brief device memory resource which counts the bytes in use through it and
+ *        their peak, as `rmm::mr::statistics_resource_adaptor` of the newer
+ *        RMM versions
+ * @details the blocks allocated before it was installed may be released
+ *          through it: the bytes in use can be negative
+ */
+class PeakMemoryResource final : public rmm::mr::device_memory_resource {
+public:
+    explicit PeakMemoryResource(rmm::mr::device_memory_resource* upstream) :
+                                    _upstream(upstream) {}
+
+    /**
+     * @brief the resource installed as current device resource, never
+     *        destroyed: its blocks may be released at exit
+     */
+    static PeakMemoryResource& instance(void) {
+        static auto resource = [] {
+            auto tracker = new PeakMemoryResource(
+                                rmm::mr::get_current_device_resource());
+            rmm::mr::set_current_device_resource(tracker);
+            return tracker;
+        }();
+        return *resource;
+    }
+
+    ///restarts the peak from the bytes in use, returned
+    int64_t reset_peak(void) {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _peak = _used;
+        return _used;
+    }
+
+    int64_t peak(void) const {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _peak;
+    }
+
+    bool supports_streams(void) const noexcept override {
+        return _upstream->supports_streams();
+    }
+
+    bool supports_get_mem_info(void) const noexcept override {
+        return _upstream->supports_get_mem_info();
+    }
+
+private:
+    rmm::mr::device_memory_resource* _upstream;
+    mutable std::mutex               _mutex;
+    int64_t                          _used { 0 };
+    int64_t                          _peak { 0 };
+
+    void* do_allocate(std::size_t bytes,
+                      rmm::cuda_stream_view stream) override {
+        void* ptr = _upstream->allocate(bytes, stream);
+        std::lock_guard<std::mutex> lock(_mutex);
+        _used += bytes;
+        _peak  = std::max(_peak, _used);
+        return ptr;
+    }
+
+    void do_deallocate(void* ptr, std::size_t bytes,
+                       rmm::cuda_stream_view stream) override {
+        _upstream->deallocate(ptr, bytes, stream);
+        std::lock_guard<std::mutex> lock(_mutex);
+        _used -= bytes;
+    }
+
+    std::pair<std::size_t, std::size_t>
+    do_get_mem_info(rmm::cuda_stream_view stream) const override {
+        return _upstream->get_mem_info(stream);
+    }
+};
+
+/**
+ * @brief timing and memory measurement of one (graph, algorithm, backend)
+ * @details the memory column is the peak memory in use above the level at
+ *          construction, from the setup to the last run: the bytes allocated
+ *          through RMM for the GPU backend, the resident set size of the
+ *          process for the host backend (high-water mark reset through
+ *          `/proc/self/clear_refs`; where it cannot be reset the peak of the
+ *          whole process is reported)
+ */
+class Runner {
+public:
+    Runner(const BenchmarkConfig& config, BenchmarkResult& result) :
+            _config(config), _result(result), _initial_used(reset_peak()) {}
+
+    /**
+     * @brief `warmup + repetitions` times: `reset()` (not timed), `run()`
+     */
+    template <typename ResetT, typename RunT>
+    void measure(const GraphT& graph, ResetT&& reset, RunT&& run) {
+        _result.nV = graph.nV();
+        _result.nE = graph.nE();
+        std::vector<float> times_ms;
+        for (int i = 0; i < _config.warmup + _config.repetitions; i++) {
+            reset();
+            float ms = _config.backend == Backend::GPU ?
+                       time<timer::DEVICE>(run) : time<timer::HOST>(run);
+            if (i >= _config.warmup)
+                times_ms.push_back(ms);
+        }
+        summarize(times_ms, _result);
+        auto peak = peak_memory();
+        _result.peak_memory = peak > _initial_used ? peak - _initial_used : 0;
+    }
+
+private:
+    const BenchmarkConfig& _config;
+    BenchmarkResult&       _result;
+    int64_t                _initial_used;
+
+    template <timer::timer_type TIMER_T, typename RunT>
+    static float time(RunT& run) {
+        timer::Timer<TIMER_T> TM;
+        TM.start();
+        run();
+        TM.stop();
+        return TM.duration();
+    }
+
+    ///restarts the peak measurement, returns the memory in use
+    int64_t reset_peak(void) const {
+        if (_config.backend == Backend::GPU)
+            return PeakMemoryResource::instance().reset_peak();
+        //"5" resets the high-water mark of the resident set size
+        std::ofstream("/proc/self/clear_refs") << "5";
+        //current resident set size: the second field, in pages
+        int64_t size_pages = 0, resident_pages = 0;
+        std::ifstream statm("/proc/self/statm");
+        statm >> size_pages >> resident_pages;
+        return resident_pages * sysconf(_SC_PAGESIZE);
+    }
+
+    int64_t peak_memory(void) const {
+        if (_config.backend == Backend::GPU)
+            return PeakMemoryResource::instance().peak();
+        rusage usage;
+        getrusage(RUSAGE_SELF, &usage);
+        return static_cast<int64_t>(usage.ru_maxrss) * 1024;    //KiB
+    }
+};
+
+/**
+ * @brief builds the data structures of an algorithm on one graph and
+ *        measures it with `runner.measure`
+ */
+using BenchmarkFn = void (*)(GraphSet& graph, Runner& runner);
+
+struct Algorithm {
+    const char* name;
+    BenchmarkFn gpu;
+    ///`nullptr`: no host implementation
+    BenchmarkFn host;
+};
+
+void spmvGPU(GraphSet& graph, Runner& runner);
+void spmvHost(GraphSet& graph, Runner& runner);
+void pageRankGPU(GraphSet& graph, Runner& runner);
+void pageRankHost(GraphSet& graph, Runner& runner);
+void triangleGPU(GraphSet& graph, Runner& runner);
+void triangleHost(GraphSet& graph, Runner& runner);
+void katzGPU(GraphSet& graph, Runner& runner);
+void coreNumberGPU(GraphSet& graph, Runner& runner);
+void coreNumberHost(GraphSet& graph, Runner& runner);
+void bcGPU(GraphSet& graph, Runner& runner);
+
+} // namespace benchmark
+} // namespace hornets_nest
+#endif
@@ -0,0 +1,70 @@
+/**
+ * @brief Core number (k-core decomposition) benchmark on the undirected graph
+ * @file
+ */
+#include "Static/CoreNumber/CoreNumber.cuh"
+#include "Benchmark.cuh"
+#include <algorithm>
+
+namespace hornets_nest {
+namespace benchmark {
+
+void coreNumberGPU(GraphSet& graph_set, Runner& runner) {
+    const auto& graph = graph_set.undirected();
+    HornetInit hornet_init(graph.nV(), graph.nE(), graph.csr_out_offsets(),
+                           graph.csr_out_edges());
+    HornetGraph hornet_graph(hornet_init);
+    thrust::device_vector<int> core_number(graph.nV());
+    CoreNumberStatic kcore(hornet_graph, core_number.data().get());
+
+    runner.measure(graph, [&]() { kcore.reset(); }, [&]() { kcore.run(); });
+}
+
+//Batagelj-Zaversnik peeling with degree buckets, O(V + E)
+void coreNumberHost(GraphSet& graph_set, Runner& runner) {
+    const auto& graph = graph_set.undirected();
+    auto   offsets = graph.csr_out_offsets();
+    auto   edges   = graph.csr_out_edges();
+    vert_t nV      = graph.nV();
+    std::vector<int>    degree(nV), bucket_start, position(nV);
+    std::vector<vert_t> order(nV);
+
+    runner.measure(graph, []() {}, [&]() {
+        int max_degree = 0;
+        for (vert_t v = 0; v < nV; v++) {
+            degree[v]  = offsets[v + 1] - offsets[v];
+            max_degree = std::max(max_degree, degree[v]);
+        }
+        bucket_start.assign(max_degree + 2, 0);
+        for (vert_t v = 0; v < nV; v++)
+            bucket_start[degree[v] + 1]++;
+        for (int d = 1; d <= max_degree + 1; d++)
+            bucket_start[d] += bucket_start[d - 1];
+        auto next = bucket_start;
+        for (vert_t v = 0; v < nV; v++) {
+            position[v]        = next[degree[v]]++;
+            order[position[v]] = v;
+        }
+        //`degree` becomes the core number
+        for (vert_t i = 0; i < nV; i++) {
+            auto v = order[i];
+            for (auto j = offsets[v]; j < offsets[v + 1]; j++) {
+                auto u = edges[j];
+                if (degree[u] <= degree[v])
+                    continue;
+                //swap `u` with the first vertex of its bucket
+                auto first = bucket_start[degree[u]];
+                auto w     = order[first];
+                if (u != w) {
+                    std::swap(order[position[u]], order[first]);
+                    std::swap(position[u], position[w]);
+                }
+                bucket_start[degree[u]]++;
+                degree[u]--;
+            }
+        }
+    });
+}
+
+} // namespace benchmark
+} // namespace hornets_nest
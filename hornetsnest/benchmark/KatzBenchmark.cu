@@ -0,0 +1,25 @@
+/**
+ * @brief Katz centrality benchmark on the undirected graph
+ * @file
+ */
+#include "Static/KatzCentrality/Katz.cuh"
+#include "Benchmark.cuh"
+
+namespace hornets_nest {
+namespace benchmark {
+
+void katzGPU(GraphSet& graph_set, Runner& runner) {
+    const int MAX_ITERATIONS = 100;
+    const auto& graph = graph_set.undirected();
+    HornetInit hornet_init(graph.nV(), graph.nE(), graph.csr_out_offsets(),
+                           graph.csr_out_edges());
+    HornetStaticGraph hornet_graph(hornet_init);
+    //alpha below the inverse of the largest eigenvalue
+    double alpha = 1.0 / (hornet_graph.max_degree() + 1.0);
+    KatzCentralityStatic katz(hornet_graph, alpha, MAX_ITERATIONS);
+
+    runner.measure(graph, [&]() { katz.reset(); }, [&]() { katz.run(); });
+}
+
+} // namespace benchmark
+} // namespace hornets_nest
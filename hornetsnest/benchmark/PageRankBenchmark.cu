@@ -0,0 +1,65 @@
+/**
+ * @brief PageRank benchmark, pull contributions on the directed graph
+ * @file
+ */
+#include "Static/PageRank/PageRank.cuh"
+#include "Benchmark.cuh"
+#include <cmath>
+
+namespace hornets_nest {
+namespace benchmark {
+
+namespace {
+
+const int  ITERATION_MAX = 20;
+const pr_t THRESHOLD     = 0.001f;
+const pr_t DAMP          = 0.85f;
+
+} // namespace
+
+void pageRankGPU(GraphSet& graph_set, Runner& runner) {
+    const auto& graph = graph_set.directed();
+    HornetInit hornet_init(graph.nV(), graph.nE(), graph.csr_out_offsets(),
+                           graph.csr_out_edges());
+    HornetGraph hornet_graph(hornet_init);
+    StaticPageRank page_rank(hornet_graph, ITERATION_MAX, THRESHOLD, DAMP,
+                             false);
+
+    runner.measure(graph, [&]() { page_rank.reset(); },
+                          [&]() { page_rank.run(); });
+}
+
+//same iterations of StaticPageRank::run
+void pageRankHost(GraphSet& graph_set, Runner& runner) {
+    const auto& graph = graph_set.directed();
+    auto offsets = graph.csr_out_offsets();
+    auto edges   = graph.csr_out_edges();
+    vert_t nV    = graph.nV();
+    std::vector<pr_t> prev_pr(nV), curr_pr(nV), contri(nV);
+
+    runner.measure(graph, []() {}, [&]() {
+        std::fill(prev_pr.begin(), prev_pr.end(), 1.0f / nV);
+        pr_t diff = THRESHOLD + 1;
+        for (int iteration = 0; iteration < ITERATION_MAX &&
+                                diff > THRESHOLD; iteration++) {
+            #pragma omp parallel for
+            for (vert_t v = 0; v < nV; v++) {
+                auto degree = offsets[v + 1] - offsets[v];
+                contri[v] = degree == 0 ? 0.0f : prev_pr[v] / degree;
+            }
+            diff = 0;
+            #pragma omp parallel for schedule(dynamic, 1024) reduction(+:diff)
+            for (vert_t v = 0; v < nV; v++) {
+                pr_t sum = 0;
+                for (auto i = offsets[v]; i < offsets[v + 1]; i++)
+                    sum += contri[edges[i]];
+                curr_pr[v] = (1.0f - DAMP) / nV + DAMP * sum;
+                diff      += std::abs(curr_pr[v] - prev_pr[v]);
+            }
+            std::swap(prev_pr, curr_pr);
+        }
+    });
+}
+
+} // namespace benchmark
+} // namespace hornets_nest
@@ -0,0 +1,45 @@
+/**
+ * @brief SpMV benchmark, unit matrix values and input vector
+ * @file
+ */
+#include "Static/SpMV/SpMV.cuh"
+#include "Benchmark.cuh"
+
+namespace hornets_nest {
+namespace benchmark {
+
+void spmvGPU(GraphSet& graph_set, Runner& runner) {
+    const auto& graph = graph_set.directed();
+    std::vector<int> h_value(graph.nE(), 1);
+    std::vector<int> h_vector(graph.nV(), 1);
+
+    HornetInit hornet_init(graph.nV(), graph.nE(), graph.csr_out_offsets(),
+                           graph.csr_out_edges());
+    hornet_init.insertEdgeData(h_value.data());
+    HornetGraph hornet_matrix(hornet_init);
+    SpMV spmv(hornet_matrix, h_vector.data());
+
+    runner.measure(graph, [&]() { spmv.reset(); }, [&]() { spmv.run(); });
+}
+
+void spmvHost(GraphSet& graph_set, Runner& runner) {
+    const auto& graph = graph_set.directed();
+    auto offsets = graph.csr_out_offsets();
+    auto edges   = graph.csr_out_edges();
+    std::vector<int> h_value(graph.nE(), 1);
+    std::vector<int> h_vector(graph.nV(), 1);
+    std::vector<int> h_result(graph.nV());
+
+    runner.measure(graph, []() {}, [&]() {
+        #pragma omp parallel for schedule(dynamic, 1024)
+        for (vert_t v = 0; v < graph.nV(); v++) {
+            int sum = 0;
+            for (auto i = offsets[v]; i < offsets[v + 1]; i++)
+                sum += h_value[i] * h_vector[edges[i]];
+            h_result[v] = sum;
+        }
+    });
+}
+
+} // namespace benchmark
+} // namespace hornets_nest
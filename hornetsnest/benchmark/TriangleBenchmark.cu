@@ -0,0 +1,55 @@
+/**
+ * @brief Triangle counting benchmark on the undirected graph
+ * @file
+ */
+#include "Static/TriangleCounting/triangle2.cuh"
+#include "Benchmark.cuh"
+
+namespace hornets_nest {
+namespace benchmark {
+
+void triangleGPU(GraphSet& graph_set, Runner& runner) {
+    const auto& graph = graph_set.undirected();
+    HornetInit hornet_init(graph.nV(), graph.nE(), graph.csr_out_offsets(),
+                           graph.csr_out_edges());
+    HornetGraph hornet_graph(hornet_init);
+    TriangleCounting2 tc(hornet_graph);
+    tc.init();
+
+    runner.measure(graph, [&]() { tc.reset(); }, [&]() { tc.run(); });
+}
+
+//merge intersection of the sorted adjacency lists of every edge
+void triangleHost(GraphSet& graph_set, Runner& runner) {
+    const auto& graph = graph_set.undirected();
+    auto offsets = graph.csr_out_offsets();
+    auto edges   = graph.csr_out_edges();
+    triangle_t num_triangles = 0;
+
+    runner.measure(graph, [&]() { num_triangles = 0; }, [&]() {
+        triangle_t sum = 0;
+        #pragma omp parallel for schedule(dynamic, 256) reduction(+:sum)
+        for (vert_t src = 0; src < graph.nV(); src++) {
+            for (auto i = offsets[src]; i < offsets[src + 1]; i++) {
+                auto dst = edges[i];
+                auto a = offsets[src], a_end = offsets[src + 1];
+                auto b = offsets[dst], b_end = offsets[dst + 1];
+                while (a < a_end && b < b_end) {
+                    if (edges[a] == edges[b]) {
+                        sum++;
+                        a++;
+                        b++;
+                    }
+                    else if (edges[a] < edges[b])
+                        a++;
+                    else
+                        b++;
+                }
+            }
+        }
+        num_triangles = sum;
+    });
+}
+
+} // namespace benchmark
+} // namespace hornets_nest
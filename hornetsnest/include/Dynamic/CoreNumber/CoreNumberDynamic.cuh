@@ -0,0 +1,406 @@
+/*
+ * Copyright (c) 2019, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "Static/CoreNumber/CoreNumber.cuh"
+#include <vector>
+
+namespace hornets_nest {
+
+#define COREMAINTENANCE CoreMaintenance<HornetGraph>
+
+using HornetDynamicGraph = ::hornet::gpu::Hornet<vert_t>;
+
+/**
+ * @brief Keeps the core number of every vertex of an undirected graph current
+ *        across batches of edge insertions and deletions
+ * @details Traversal-based maintenance (Sariyuce et al., "Streaming
+ *          Algorithms for k-core Decomposition", VLDB 2013). The batch edges
+ *          are applied one at a time: for the edge {u, v} with
+ *          K = min(core(u), core(v)) only the subcore, the vertices with core
+ *          number K connected to the root(s) through vertices with core
+ *          number K, is visited. Inserting an edge raises a part of the
+ *          subcore to K + 1, erasing it lowers a part of the subcore to K - 1.
+ *          Batch edges which are later (insertion) or earlier (deletion) in
+ *          the batch order are hidden during the traversal, so the graph is
+ *          updated once per batch.
+ * @remark the batch must contain both directions of every edge
+ */
+template <typename HornetGraph>
+class CoreMaintenance : public StaticAlgorithm<HornetGraph> {
+public:
+    CoreMaintenance(HornetGraph &hornet, int *core_number_ptr);
+    ~CoreMaintenance();
+
+    void reset()    override;
+    void run()      override;
+    void release()  override;
+    bool validate() override;
+
+    /**
+     * @brief updates the core numbers after `hornet.insert(batch, true, true)`
+     * @remark the batch must hold only new edges
+     */
+    void insert(Update &batch);
+
+    /**
+     * @brief updates the core numbers before `hornet.erase(batch)`
+     * @remark edges of `batch` which are not in the graph are ignored
+     */
+    void erase(Update &batch);
+
+    /**
+     * @brief number of subcore vertices visited by the last update
+     */
+    long visited_vertices() const noexcept;
+
+private:
+    load_balancing::BinarySearch load_balancing;
+
+    TwoLevelQueue<vert_t> frontier;
+    TwoLevelQueue<vert_t> subcore;
+    TwoLevelQueue<vert_t> evict_queue;
+
+    BufferPool pool;
+    int *subcore_mark { nullptr };
+    int *evict_mark   { nullptr };
+    int *cd           { nullptr };
+    int *core_number  { nullptr };
+
+    int  stamp            { 0 };
+    long visited_count    { 0 };
+
+    void update(Update &batch, bool is_insert);
+    void updateEdge(vert_t u, vert_t v, const vert_t *batch_src,
+                    const vert_t *batch_dst, int batch_size, int rank,
+                    bool is_insert);
+};
+
+using CoreNumberDynamic = CoreMaintenance<HornetDynamicGraph>;
+
+}
+
+namespace hornets_nest {
+
+namespace core_maintenance {
+
+/*
+ * position of (src, dst) in the batch sorted by BatchUpdate, -1 if not found
+ */
+__device__ __forceinline__
+int batchPosition(const vert_t *__restrict__ batch_src,
+                  const vert_t *__restrict__ batch_dst,
+                  int batch_size, vert_t src, vert_t dst) {
+    int low = 0, high = batch_size;
+    while (low < high) {
+        int mid = (low + high) / 2;
+        if (batch_src[mid] < src ||
+                (batch_src[mid] == src && batch_dst[mid] < dst))
+            low = mid + 1;
+        else
+            high = mid;
+    }
+    return (low < batch_size && batch_src[low] == src &&
+            batch_dst[low] == dst) ? low : -1;
+}
+
+/*
+ * Batch edges are applied in batch order: while the edge at position `rank`
+ * is processed the later insertions (earlier deletions) are not visible
+ */
+struct BatchView {
+    const vert_t *batch_src;
+    const vert_t *batch_dst;
+    int batch_size;
+    int rank;
+    bool is_insert;
+
+    __device__ __forceinline__
+    bool visible(vert_t src, vert_t dst) const {
+        vert_t low  = src < dst ? src : dst;
+        vert_t high = src < dst ? dst : src;
+        int pos = batchPosition(batch_src, batch_dst, batch_size, low, high);
+        if (pos == -1)
+            return true;
+        return is_insert ? pos <= rank : pos > rank;
+    }
+};
+
+template <typename HornetDevice>
+struct MarkGraphEdges {
+    HornetDevice hornet;
+    const vert_t *batch_src;
+    const vert_t *batch_dst;
+    int *in_graph;
+
+    OPERATOR(int i) {
+        auto vertex = hornet.vertex(batch_src[i]);
+        const vert_t *adj = vertex.neighbor_ptr();
+        int found = 0;
+        for (degree_t j = 0; j < vertex.degree() && !found; j++)
+            found = (adj[j] == batch_dst[i]);
+        in_graph[i] = found;
+    }
+};
+
+struct SubcoreExpand {
+    BatchView view;
+    int *core_number;
+    int *subcore_mark;
+    int *cd;
+    int stamp;
+    int K;
+    TwoLevelQueue<vert_t> frontier;
+    TwoLevelQueue<vert_t> subcore;
+
+    OPERATOR(Vertex &v, Edge &e) {
+        vert_t src = v.id();
+        vert_t dst = e.dst_id();
+        if (src == dst || core_number[dst] < K || !view.visible(src, dst))
+            return;
+        atomicAdd(&cd[src], 1);
+        if (core_number[dst] == K && atomicExch(&subcore_mark[dst], stamp) != stamp) {
+            cd[dst] = 0;
+            frontier.insert(dst);
+            subcore.insert(dst);
+        }
+    }
+};
+
+struct SubcoreEvict {
+    int *cd;
+    int *evict_mark;
+    int stamp;
+    int K;
+    bool is_insert;
+    TwoLevelQueue<vert_t> evict_queue;
+
+    //insertion: cd <= K cannot reach the (K+1)-core
+    //deletion:  cd <  K falls out of the K-core
+    OPERATOR(Vertex &v) {
+        vert_t id = v.id();
+        if (evict_mark[id] == stamp)
+            return;
+        if (is_insert ? cd[id] <= K : cd[id] < K) {
+            evict_mark[id] = stamp;
+            evict_queue.insert(id);
+        }
+    }
+};
+
+struct SubcoreEvictNeighbors {
+    BatchView view;
+    int *subcore_mark;
+    int *evict_mark;
+    int *cd;
+    int stamp;
+
+    OPERATOR(Vertex &v, Edge &e) {
+        vert_t src = v.id();
+        vert_t dst = e.dst_id();
+        if (src == dst || subcore_mark[dst] != stamp ||
+                evict_mark[dst] == stamp || !view.visible(src, dst))
+            return;
+        atomicSub(&cd[dst], 1);
+    }
+};
+
+struct SubcoreCommit {
+    int *core_number;
+    int *evict_mark;
+    int stamp;
+    int K;
+    bool is_insert;
+
+    OPERATOR(Vertex &v) {
+        vert_t id = v.id();
+        if (is_insert && evict_mark[id] != stamp)
+            core_number[id] = K + 1;
+        else if (!is_insert && evict_mark[id] == stamp)
+            core_number[id] = K - 1;
+    }
+};
+
+} // namespace core_maintenance
+
+template <typename HornetGraph>
+COREMAINTENANCE::CoreMaintenance(HornetGraph &hornet, int *core_number_ptr) :
+                        StaticAlgorithm<HornetGraph>(hornet),
+                        load_balancing(hornet),
+                        frontier(hornet),
+                        subcore(hornet),
+                        evict_queue(hornet),
+                        core_number(core_number_ptr) {
+    pool.allocate(&subcore_mark, hornet.nV());
+    pool.allocate(&evict_mark, hornet.nV());
+    pool.allocate(&cd, hornet.nV());
+    reset();
+}
+
+template <typename HornetGraph>
+COREMAINTENANCE::~CoreMaintenance() {
+}
+
+template <typename HornetGraph>
+void COREMAINTENANCE::reset() {
+    HornetGraph &hornet = StaticAlgorithm<HornetGraph>::hornet;
+    gpu::memset(subcore_mark, hornet.nV(), 0xFF);
+    gpu::memset(evict_mark, hornet.nV(), 0xFF);
+    stamp = 0;
+    visited_count = 0;
+}
+
+template <typename HornetGraph>
+void COREMAINTENANCE::run() {
+    HornetGraph &hornet = StaticAlgorithm<HornetGraph>::hornet;
+    gpu::memsetZero(core_number, hornet.nV());
+    CoreNumber<HornetGraph> kcore(hornet, core_number);
+    kcore.run();
+    reset();
+}
+
+template <typename HornetGraph>
+void COREMAINTENANCE::release() {
+}
+
+template <typename HornetGraph>
+long COREMAINTENANCE::visited_vertices() const noexcept {
+    return visited_count;
+}
+
+template <typename HornetGraph>
+void COREMAINTENANCE::insert(Update &batch) {
+    update(batch, true);
+}
+
+template <typename HornetGraph>
+void COREMAINTENANCE::erase(Update &batch) {
+    batch.sort();
+    batch.remove_batch_duplicates(false);
+    update(batch, false);
+}
+
+template <typename HornetGraph>
+void COREMAINTENANCE::update(Update &batch, bool is_insert) {
+    using namespace core_maintenance;
+    HornetGraph &hornet = StaticAlgorithm<HornetGraph>::hornet;
+    visited_count = 0;
+    int batch_size = batch.nE();
+    if (batch_size == 0)
+        return;
+    auto batch_ptr = batch.in_edge().get_soa_ptr();
+    const vert_t *d_src = batch_ptr.template get<0>();
+    const vert_t *d_dst = batch_ptr.template get<1>();
+
+    std::vector<vert_t> h_src(batch_size), h_dst(batch_size);
+    std::vector<int> h_in_graph(batch_size, 1);
+    gpu::copyToHost(d_src, batch_size, h_src.data());
+    gpu::copyToHost(d_dst, batch_size, h_dst.data());
+    if (!is_insert) {
+        thrust::device_vector<int> in_graph(batch_size);
+        auto hornet_device = hornet.device();
+        forAll(batch_size,
+               MarkGraphEdges<decltype(hornet_device)> { hornet_device,
+                                                         d_src, d_dst,
+                                                         in_graph.data().get() });
+        gpu::copyToHost(in_graph.data().get(), batch_size, h_in_graph.data());
+    }
+
+    for (int i = 0; i < batch_size; i++) {
+        if (h_src[i] < h_dst[i] && h_in_graph[i])
+            updateEdge(h_src[i], h_dst[i], d_src, d_dst, batch_size, i,
+                       is_insert);
+    }
+}
+
+template <typename HornetGraph>
+void COREMAINTENANCE::updateEdge(vert_t u, vert_t v,
+                                 const vert_t *batch_src,
+                                 const vert_t *batch_dst,
+                                 int batch_size, int rank, bool is_insert) {
+    using namespace core_maintenance;
+    HornetGraph &hornet = StaticAlgorithm<HornetGraph>::hornet;
+    int core_u, core_v;
+    gpu::copyToHost(core_number + u, 1, &core_u);
+    gpu::copyToHost(core_number + v, 1, &core_v);
+    int K = std::min(core_u, core_v);
+    stamp++;
+
+    //the roots are the endpoints with the smaller core number
+    vert_t roots[2];
+    int num_roots = 0;
+    if (core_u == K)
+        roots[num_roots++] = u;
+    if (core_v == K)
+        roots[num_roots++] = v;
+    for (int i = 0; i < num_roots; i++) {
+        host::copyToDevice(stamp, subcore_mark + roots[i]);
+        host::copyToDevice(0, cd + roots[i]);
+    }
+    //host insertions go to the input level of the queue
+    frontier.clear();
+    frontier.insert(roots, num_roots);
+
+    BatchView view { batch_src, batch_dst, batch_size, rank, is_insert };
+    while (frontier.size() > 0) {
+        forAllEdges(hornet, frontier,
+                    SubcoreExpand { view, core_number, subcore_mark, cd,
+                                    stamp, K, frontier, subcore },
+                    load_balancing);
+        frontier.swap();
+    }
+    subcore.swap();
+    subcore.insert(roots, num_roots);
+    visited_count += subcore.size();
+
+    while (true) {
+        forAllVertices(hornet, subcore,
+                       SubcoreEvict { cd, evict_mark, stamp, K, is_insert,
+                                      evict_queue });
+        evict_queue.swap();
+        if (evict_queue.size() == 0)
+            break;
+        forAllEdges(hornet, evict_queue,
+                    SubcoreEvictNeighbors { view, subcore_mark, evict_mark,
+                                            cd, stamp },
+                    load_balancing);
+    }
+    forAllVertices(hornet, subcore,
+                   SubcoreCommit { core_number, evict_mark, stamp, K,
+                                   is_insert });
+}
+
+template <typename HornetGraph>
+bool COREMAINTENANCE::validate() {
+    HornetGraph &hornet = StaticAlgorithm<HornetGraph>::hornet;
+    thrust::device_vector<int> static_core(hornet.nV(), 0);
+    CoreNumber<HornetGraph> kcore(hornet, static_core.data().get());
+    kcore.run();
+
+    std::vector<int> h_static(hornet.nV()), h_dynamic(hornet.nV());
+    gpu::copyToHost(static_core.data().get(), hornet.nV(), h_static.data());
+    gpu::copyToHost(core_number, hornet.nV(), h_dynamic.data());
+    for (vert_t v = 0; v < hornet.nV(); v++) {
+        if (h_static[v] != h_dynamic[v]) {
+            std::cout << "vertex " << v << "  static: " << h_static[v]
+                      << "  dynamic: " << h_dynamic[v] << "\n";
+            return false;
+        }
+    }
+    return true;
+}
+
+}
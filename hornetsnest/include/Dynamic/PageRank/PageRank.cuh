@@ -43,104 +43,91 @@
 #include "Static/PageRank/PageRank.cuh"
 #include <BufferPool.cuh>
 
-//namespace hornets_nest {
 namespace hornets_nest {
 
-using ulong_t = long long unsigned;
+using BatchUpdate = ::hornet::gpu::BatchUpdate<vid_t>;
 
 struct PrDynamicData : PrData {
     PrDynamicData() = default;
     PrDynamicData(PrData data) : PrData(data) {}
-    //__device__
-    //void operator=(const PrDynamicData&) {}
-
-    //TwoLevelQueue<vid_t> active_queue;
-    TwoLevelQueue<vid_t> queue1;
-    TwoLevelQueue<vid_t> queue2;
-    TwoLevelQueue<vid_t> queue3;
-    TwoLevelQueue<vid_t> queueDlt;
-
-    pr_t epsilon; //determinant for enqueuing
-    int* visited; //size of NV
-    int* visitedDlt; //size of NV
-    int* usedOld; //size of NV
-    pr_t* diffPR;
-    pr_t* delta;
-};
 
+    pr_t*     residual; //size of NV
+    pr_t*     delta;    //size of NV, residual pushed to every out-neighbor
+    int*      visited;  //size of NV, sweep in which the vertex was enqueued
+    degree_t* removed;  //size of NV, batch edges erased from the vertex
 
-//class PageRankDynamic : public StaticAlgorithm<HornetGraph> {
-class PageRankDynamic : public StaticAlgorithm<HornetGPU> {
-  BufferPool pool;
-public:
-//    PageRankDynamic(HornetGraph& hornet,
-//                    HornetGraph& inverted_graph,
-//                    int max_iteration, int K,
-//                    degree_t max_degree);
-
-//    PageRankDynamic(HornetGraph& hornet,
-//                    int max_iteration, int K,
-//                    degree_t max_degree);
-
-//    PageRankDynamic(HornetGPU& hornet, //HornetGraph& hornet,
-//                    HornetGPU& inverted_graph, //HornetGraph& inverted_graph,
-//                    int  iteration_max,
-//                    pr_t threshold,
-//                    pr_t damp);
-
-    PageRankDynamic(HornetGPU& hornet, //HornetGraph& hornet,
-                    int  iteration_max,
-                    pr_t threshold,
-                    pr_t damp);
+    pr_t epsilon;       //residual threshold for enqueuing a vertex
+    int  sweep;
+};
 
+/**
+ * @brief PageRank kept current across batches of edge updates
+ * @details The ranks `x` are the fixed point of `x = b + damp * A x`, where
+ *          rank flows along the out-edges (`StaticPageRank` with push
+ *          contributions). The algorithm keeps the residual
+ *          `r = b + damp * A x - x` of the current ranks: a batch only changes
+ *          the residual of the out-neighbors of its sources, and the ranks
+ *          are corrected by pushing residuals from these vertices until every
+ *          `|r(v)|` is below `threshold / nV`. Vertices far from the batch are
+ *          never visited, while a cold start iterates over the whole graph.
+ */
+class PageRankDynamic : public StaticAlgorithm<HornetGraph> {
+public:
+    PageRankDynamic(HornetGraph& hornet,
+                    int  iteration_max = 20,
+                    pr_t threshold     = 0.001f,
+                    pr_t damp          = 0.85f);
     ~PageRankDynamic();
 
-    void setInitParametersUndirected(int max_iteration, pr_t threshold,
-                                     pr_t damp);
-    void setInitParametersDirectedint(int max_iteration, pr_t threshold,
-                                     pr_t damp);
-
     void reset()    override;
-    //void run()      override;
-    void run() override;
+    void run()      override;
     void release()  override;
     bool validate() override;
 
-    //void Reset();
-#if 0
-//    void RecomputeInsertionContriUndirected();
-    void RecomputeContri();
-    void RecomputeDeletionContriUndirected();
-    void UpdateDeltaAndMove();
-    void UpdateDeltaAndCopy();
-    void UpdateContributionsUndirected();
-    void RemoveContributionsUndirected();
-    void PrevEqualCurr();
-    void ResetCurr();
-#endif
+    /**
+     * @brief updates the ranks after `hornet.insert(batch, true, true)`
+     * @remark the batch must hold only new edges
+     */
+    void batchUpdateInserted(BatchUpdate& batch_update);
 
+    /**
+     * @brief updates the ranks before `hornet.erase(batch_update)`
+     * @remark edges of the batch which are not in the graph are ignored
+     */
+    void batchUpdateDeleted(BatchUpdate& batch_update);
+
+    /**
+     * @brief residual sweeps of the last update (or of the warm start
+     *        after `run()`)
+     */
     int get_iteration_count();
 
-    void copyPRToHost(double* host_array);
-    void copyNumPathsToHost(ulong_t* host_array);
+    /**
+     * @brief iterations of the last `StaticPageRank` run, in `run()` or
+     *        `validate()`
+     */
+    int cold_start_iteration_count();
 
-    void batchUpdateInserted(BatchUpdate& batch_update);
-    void batchUpdateDeleted(BatchUpdate&  batch_update);
+    /**
+     * @brief vertices pushed by the last update
+     */
+    long pushed_vertices() const noexcept;
 
-    void processUpdate(BatchUpdate& batch_update, bool is_insert);
+    void copyPRToHost(pr_t* host_array);
 
 private:
+    BufferPool                   pool;
     HostDeviceVar<PrDynamicData> hd_prdata;
-
-//    HornetGraph&             inverted_graph;
-    //HornetGPU&                 inverted_graph;
-//    load_balancing::BinarySearch load_balancing;
     load_balancing::BinarySearch load_balancing;
-//    PageRank                   pr_static;
-    StaticPageRank           pr_static;
-    bool                       is_directed;
+    StaticPageRank               pr_static;
+    TwoLevelQueue<vid_t>         queue;
 
+    int  cold_iterations { 0 };
+    long pushed_count    { 0 };
+
+    void processUpdate(BatchUpdate& batch_update, bool is_insert);
+    void propagate(const vid_t* batch_src = nullptr,
+                   const vid_t* batch_dst = nullptr, int batch_size = 0);
 };
 
 } // namespace hornets_nest
-
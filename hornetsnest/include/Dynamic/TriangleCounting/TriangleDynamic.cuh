@@ -0,0 +1,69 @@
+/**
+ * @brief Incremental triangle counting on top of BatchUpdate
+ * @file
+ */
+#pragma once
+
+#include "HornetAlg.hpp"
+#include "Static/TriangleCounting/triangle2.cuh"
+#include <BufferPool.cuh>
+
+namespace hornets_nest {
+
+using BatchUpdate = ::hornet::gpu::BatchUpdate<vid_t>;
+
+//==============================================================================
+
+/**
+ * @brief Maintains the triangles of each vertex and the global triangle
+ *        count of an undirected (symmetric) graph across edge batches
+ * @details Only the adjacencies of the batch endpoints are intersected. A
+ *          triangle closed by `k` batch edges is found once per batch edge;
+ *          the inclusion-exclusion correction keeps only the occurrence
+ *          found from its smallest batch edge, so every triangle contributes
+ *          exactly once whatever `k` is.
+ * @remark  adjacency lists must be sorted (`Hornet::sort()`) and the batch
+ *          must contain both directions of every edge
+ */
+class TriangleCountingDynamic : public StaticAlgorithm<HornetGraph> {
+    BufferPool pool;
+public:
+    TriangleCountingDynamic(HornetGraph& hornet);
+    ~TriangleCountingDynamic();
+
+    void reset()    override;
+    void run()      override;
+    void release()  override;
+    bool validate() override;
+
+    /**
+     * @brief adds the triangles closed by `batch`
+     * @remark call after `hornet.insert(batch, true, true)` and
+     *         `hornet.sort()`: the batch must hold only new edges
+     */
+    void insert(BatchUpdate& batch);
+
+    /**
+     * @brief removes the triangles opened by `batch`
+     * @remark call before `hornet.erase(batch)`; edges of `batch` which are
+     *         not in the graph are ignored
+     */
+    void erase(BatchUpdate& batch);
+
+    void copyTCToHost(triangle_t* h_tcs);
+
+    triangle_t countTriangles() const noexcept;
+
+private:
+    load_balancing::BinarySearch load_balancing;
+
+    triangle_t* triPerVertex  { nullptr };
+    triangle_t* d_delta       { nullptr };
+    triangle_t  num_triangles { 0 };
+
+    void update(BatchUpdate& batch, bool is_insert);
+};
+
+//==============================================================================
+
+} // namespace hornets_nest
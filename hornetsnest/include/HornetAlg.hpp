@@ -44,9 +44,14 @@
 #include <HornetAlg.cuh>
 #include <Operator++.cuh>
 #include "Queue/TwoLevelQueue.cuh"
+#include "Queue/Frontier.cuh"
+#include "Queue/HostFrontier.hpp"
+#include "Queue/HostTwoLevelQueue.hpp"
 #include "StandardAPI.hpp"
 #include "HostDeviceVar.cuh"
 #include "LoadBalancing/BinarySearch.cuh"
+#include "LoadBalancing/MergePath.cuh"
+#include "Selection/TopK.cuh"
 
 
 //#include <BasicTypes.hpp>
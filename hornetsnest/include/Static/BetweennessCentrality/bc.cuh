@@ -59,7 +59,7 @@ struct BCData {
     bc_t *bc;
     vid_t root;
     degree_t currLevel;
-    TwoLevelQueue<vid_t> queue;
+    Frontier<vid_t> frontier;
 };
 
 class BCCentrality : public StaticAlgorithm<HornetGraph> {
@@ -82,6 +82,13 @@ public:
     paths_t* getSigmas();
     bc_t*    getDeltas();
 
+    /**
+     * @brief the `N` vertices with the highest betweenness centrality
+     * @param[out] h_ids host array of `N` vertex ids, by decreasing score
+     * @return the N-th highest score
+     */
+    bc_t     topN(int N, vid_t* h_ids);
+
 
 
 private:
@@ -89,6 +96,9 @@ private:
 
     HostDeviceVar<BCData>       hd_BCData;    
 
+    ///@internal @brief BFS vertices sorted by level, reused across roots
+    vid_t*                      depArray { nullptr };
+
 };
 
 } // hornetAlgs namespace
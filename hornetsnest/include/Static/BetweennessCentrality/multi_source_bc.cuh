@@ -0,0 +1,418 @@
+/*
+ * Copyright (c) 2019, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "Static/BetweennessCentrality/bc.cuh"
+#include <thrust/device_vector.h>
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace hornets_nest {
+
+#define MULTISOURCEBC MultiSourceBCT<word_t>
+
+/**
+ * @brief Brandes betweenness centrality from many roots at once
+ * @details The roots are processed in batches of `WIDTH` (the bits of
+ *          `word_t`). The BFS of the batch is bit-parallel (Then et al.,
+ *          "The More the Merrier: Efficient Multi-Source Graph Traversal",
+ *          VLDB 2014): every vertex keeps the set of roots which reached it,
+ *          and the set of roots for which it is in the current frontier, so
+ *          an edge is traversed once per level for all the roots. Depths,
+ *          path counts and dependencies are packed per vertex
+ *          (`sigma[v * WIDTH + lane]`). The vertices of every level are kept
+ *          for the dependency accumulation, which walks the levels backwards.
+ *          All the buffers are allocated once and reused across batches.
+ * @tparam word_t `unsigned` (32 roots per batch) or `unsigned long long`
+ *         (64 roots per batch)
+ */
+template<typename word_t>
+class MultiSourceBCT : public StaticAlgorithm<HornetGraph> {
+public:
+    static const int WIDTH = sizeof(word_t) * 8;
+
+    MultiSourceBCT(HornetGraph& hornet, const vid_t* h_roots, int num_roots);
+    ~MultiSourceBCT();
+
+    void reset()    override;
+    void run()      override;
+    void release()  override;
+    bool validate() override;
+
+    bc_t* getBCScores();
+
+    /**
+     * @brief number of BFS levels of all the batches of the last run
+     */
+    int levels() const noexcept;
+
+private:
+    load_balancing::BinarySearch load_balancing;
+    TwoLevelQueue<vid_t>         queue;
+
+    BufferPool pool;
+    word_t*  seen     { nullptr };
+    word_t*  frontier { nullptr };
+    word_t*  next     { nullptr };
+    int*     depth    { nullptr };
+    paths_t* sigma    { nullptr };
+    bc_t*    delta    { nullptr };
+    bc_t*    bc       { nullptr };
+    vid_t*   d_roots  { nullptr };
+
+    ///@internal @brief vertices of every BFS level, reused across batches
+    thrust::device_vector<vid_t> level_vertices;
+    std::vector<int>             level_offsets;
+
+    std::vector<vid_t> h_roots;
+    int                num_levels { 0 };
+
+    void runBatch(const vid_t* roots, int num_lanes);
+};
+
+using MultiSourceBC   = MultiSourceBCT<unsigned>;
+using MultiSourceBC64 = MultiSourceBCT<unsigned long long>;
+
+//==============================================================================
+
+namespace host {
+
+/**
+ * @brief Brandes betweenness centrality on the host, with the same interface
+ *        of `MultiSourceBCT`
+ * @details The roots are distributed among the OpenMP threads; every thread
+ *          reuses its own BFS scratch and accumulates in a private array
+ */
+class MultiSourceBC {
+public:
+    MultiSourceBC(const eoff_t* offsets, const vid_t* edges, vid_t nV,
+                  const vid_t* roots, int num_roots);
+
+    void reset();
+    void run();
+
+    const bc_t* getBCScores() const;
+
+private:
+    const eoff_t*      offsets;
+    const vid_t*       edges;
+    vid_t              nV;
+    std::vector<vid_t> roots;
+    std::vector<bc_t>  bc;
+};
+
+} // namespace host
+
+//==============================================================================
+
+namespace ms_bc {
+
+__device__ __forceinline__
+int lowestLane(unsigned bits) {
+    return __ffs(bits) - 1;
+}
+
+__device__ __forceinline__
+int lowestLane(unsigned long long bits) {
+    return __ffsll(bits) - 1;
+}
+
+template<typename word_t>
+struct MSBCData {
+    word_t*  seen;
+    word_t*  frontier;
+    word_t*  next;
+    int*     depth;
+    paths_t* sigma;
+    bc_t*    delta;
+    bc_t*    bc;
+    const vid_t* roots;
+    int      num_lanes;
+    int      level;
+};
+
+template<typename word_t>
+struct InitRoots {
+    MSBCData<word_t> data;
+
+    OPERATOR(int lane) {
+        const int WIDTH = sizeof(word_t) * 8;
+        vid_t  root = data.roots[lane];
+        word_t bit  = word_t(1) << lane;
+        atomicOr(data.seen + root, bit);
+        atomicOr(data.frontier + root, bit);
+        data.sigma[root * WIDTH + lane] = 1;
+        data.depth[root * WIDTH + lane] = 0;
+    }
+};
+
+/*
+ * the roots of `frontier[v]` which did not reach `w` yet reach it at the
+ * next level; the first discovery enqueues `w`
+ */
+template<typename word_t>
+struct Discover {
+    MSBCData<word_t>     data;
+    TwoLevelQueue<vid_t> queue;
+
+    OPERATOR(Vertex& vertex, Edge& edge) {
+        vid_t  w    = edge.dst_id();
+        word_t bits = data.frontier[vertex.id()] & ~data.seen[w];
+        if (bits != 0 && atomicOr(data.next + w, bits) == 0)
+            queue.insert(w);
+    }
+};
+
+template<typename word_t>
+struct CountPaths {
+    MSBCData<word_t> data;
+
+    OPERATOR(Vertex& vertex, Edge& edge) {
+        const int WIDTH = sizeof(word_t) * 8;
+        vid_t  v    = vertex.id();
+        vid_t  w    = edge.dst_id();
+        word_t bits = data.frontier[v] & data.next[w];
+        while (bits != 0) {
+            int lane = lowestLane(bits);
+            bits    &= bits - 1;
+            atomicAdd(data.sigma + w * WIDTH + lane,
+                      data.sigma[v * WIDTH + lane]);
+        }
+    }
+};
+
+template<typename word_t>
+struct ClearFrontier {
+    MSBCData<word_t> data;
+
+    OPERATOR(Vertex& vertex) {
+        data.frontier[vertex.id()] = 0;
+    }
+};
+
+template<typename word_t>
+struct Advance {
+    MSBCData<word_t> data;
+
+    OPERATOR(Vertex& vertex) {
+        const int WIDTH = sizeof(word_t) * 8;
+        vid_t  w    = vertex.id();
+        word_t bits = data.next[w];
+        data.next[w]      = 0;
+        data.seen[w]     |= bits;
+        data.frontier[w]  = bits;
+        while (bits != 0) {
+            int lane = lowestLane(bits);
+            bits    &= bits - 1;
+            data.depth[w * WIDTH + lane] = data.level;
+        }
+    }
+};
+
+/*
+ * delta(v) += sigma(v) / sigma(w) * (1 + delta(w)) for the roots with
+ * v at depth `level` and w at depth `level + 1`
+ */
+template<typename word_t>
+struct Dependency {
+    MSBCData<word_t> data;
+
+    OPERATOR(Vertex& vertex, Edge& edge) {
+        const int WIDTH = sizeof(word_t) * 8;
+        vid_t  v    = vertex.id();
+        vid_t  w    = edge.dst_id();
+        word_t bits = data.seen[v] & data.seen[w];
+        while (bits != 0) {
+            int lane = lowestLane(bits);
+            bits    &= bits - 1;
+            int pv = v * WIDTH + lane;
+            int pw = w * WIDTH + lane;
+            if (data.depth[pv] != data.level ||
+                    data.depth[pw] != data.level + 1)
+                continue;
+            atomicAdd(data.delta + pv,
+                      static_cast<bc_t>(data.sigma[pv]) /
+                      static_cast<bc_t>(data.sigma[pw]) *
+                      (1.0 + data.delta[pw]));
+        }
+    }
+};
+
+template<typename word_t>
+struct AccumulateBC {
+    MSBCData<word_t> data;
+
+    OPERATOR(vid_t v) {
+        const int WIDTH = sizeof(word_t) * 8;
+        bc_t sum = 0;
+        for (int lane = 0; lane < data.num_lanes; lane++) {
+            if (data.roots[lane] != v)
+                sum += data.delta[v * WIDTH + lane];
+        }
+        data.bc[v] += sum;
+    }
+};
+
+} // namespace ms_bc
+
+//==============================================================================
+
+template<typename word_t>
+MULTISOURCEBC::MultiSourceBCT(HornetGraph& hornet, const vid_t* roots,
+                              int num_roots) :
+                                StaticAlgorithm(hornet),
+                                load_balancing(hornet),
+                                queue(hornet),
+                                h_roots(roots, roots + num_roots) {
+    pool.allocate(&seen,     hornet.nV());
+    pool.allocate(&frontier, hornet.nV());
+    pool.allocate(&next,     hornet.nV());
+    pool.allocate(&depth,    hornet.nV() * WIDTH);
+    pool.allocate(&sigma,    hornet.nV() * WIDTH);
+    pool.allocate(&delta,    hornet.nV() * WIDTH);
+    pool.allocate(&bc,       hornet.nV());
+    pool.allocate(&d_roots,  WIDTH);
+    level_vertices.resize(hornet.nV());
+    reset();
+}
+
+template<typename word_t>
+MULTISOURCEBC::~MultiSourceBCT() {
+    release();
+}
+
+template<typename word_t>
+void MULTISOURCEBC::reset() {
+    gpu::memsetZero(bc, hornet.nV());
+    num_levels = 0;
+}
+
+template<typename word_t>
+void MULTISOURCEBC::release() {
+    seen     = nullptr;
+    frontier = nullptr;
+    next     = nullptr;
+    depth    = nullptr;
+    sigma    = nullptr;
+    delta    = nullptr;
+    bc       = nullptr;
+    d_roots  = nullptr;
+}
+
+template<typename word_t>
+void MULTISOURCEBC::run() {
+    num_levels = 0;
+    for (size_t i = 0; i < h_roots.size(); i += WIDTH) {
+        int num_lanes = std::min(static_cast<int>(h_roots.size() - i), WIDTH);
+        runBatch(h_roots.data() + i, num_lanes);
+    }
+}
+
+template<typename word_t>
+void MULTISOURCEBC::runBatch(const vid_t* roots, int num_lanes) {
+    using namespace ms_bc;
+    gpu::memsetZero(seen,     hornet.nV());
+    gpu::memsetZero(frontier, hornet.nV());
+    gpu::memsetZero(next,     hornet.nV());
+    gpu::memsetZero(sigma,    hornet.nV() * WIDTH);
+    gpu::memsetZero(delta,    hornet.nV() * WIDTH);
+    host::copyToDevice(roots, num_lanes, d_roots);
+
+    MSBCData<word_t> data { seen, frontier, next, depth, sigma, delta, bc,
+                            d_roots, num_lanes, 0 };
+    forAll(num_lanes, InitRoots<word_t> { data });
+
+    std::vector<vid_t> unique_roots(roots, roots + num_lanes);
+    std::sort(unique_roots.begin(), unique_roots.end());
+    unique_roots.erase(std::unique(unique_roots.begin(), unique_roots.end()),
+                       unique_roots.end());
+    //host insertions go to the input level of the queue
+    queue.clear();
+    queue.insert(unique_roots.data(), unique_roots.size());
+
+    level_offsets.assign(1, 0);
+    while (queue.size() > 0) {
+        int offset = level_offsets.back();
+        if (level_vertices.size() < static_cast<size_t>(offset + queue.size()))
+            level_vertices.resize(std::max(level_vertices.size() * 2,
+                                           static_cast<size_t>(offset +
+                                                               queue.size())));
+        cudaMemcpy(level_vertices.data().get() + offset,
+                   queue.device_input_ptr(), queue.size() * sizeof(vid_t),
+                   cudaMemcpyDeviceToDevice);
+        CHECK_CUDA_ERROR
+        level_offsets.push_back(offset + queue.size());
+
+        forAllEdges(hornet, queue, Discover<word_t> { data, queue },
+                    load_balancing);
+        forAllEdges(hornet, queue, CountPaths<word_t> { data },
+                    load_balancing);
+        forAllVertices(hornet, queue, ClearFrontier<word_t> { data });
+        queue.swap();
+        data.level++;
+        forAllVertices(hornet, queue, Advance<word_t> { data });
+    }
+    int batch_levels = static_cast<int>(level_offsets.size()) - 1;
+    num_levels += batch_levels;
+
+    //the deepest level has no successors
+    for (int level = batch_levels - 2; level >= 0; level--) {
+        data.level = level;
+        forAllEdges(hornet,
+                    level_vertices.data().get() + level_offsets[level],
+                    level_offsets[level + 1] - level_offsets[level],
+                    Dependency<word_t> { data }, load_balancing);
+    }
+    forAllnumV(hornet, AccumulateBC<word_t> { data });
+}
+
+template<typename word_t>
+bc_t* MULTISOURCEBC::getBCScores() {
+    return bc;
+}
+
+template<typename word_t>
+int MULTISOURCEBC::levels() const noexcept {
+    return num_levels;
+}
+
+/*
+ * compares the scores against one BCCentrality run per root
+ */
+template<typename word_t>
+bool MULTISOURCEBC::validate() {
+    BCCentrality single_source(hornet);
+    for (auto root : h_roots) {
+        single_source.setRoot(root);
+        single_source.run();
+    }
+    std::vector<bc_t> h_expected(hornet.nV()), h_bc(hornet.nV());
+    gpu::copyToHost(single_source.getBCScores(), hornet.nV(),
+                    h_expected.data());
+    gpu::copyToHost(bc, hornet.nV(), h_bc.data());
+    for (vid_t v = 0; v < hornet.nV(); v++) {
+        if (std::abs(h_expected[v] - h_bc[v]) >
+                1e-6 * std::max(1.0, std::abs(h_expected[v]))) {
+            std::cout << "vertex " << v << "  expected: " << h_expected[v]
+                      << "  multi-source: " << h_bc[v] << "\n";
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace hornets_nest
@@ -69,11 +69,15 @@ public:
 
     void set_parameters(vid_t source);
 
+    void set_frontier_policy(FrontierPolicy policy,
+                             float dense_threshold =
+                                Frontier<vid_t>::DEFAULT_DENSE_THRESHOLD);
+
     dist_t getLevels(){return current_level;}
 
 private:
     BufferPool pool;
-    TwoLevelQueue<vid_t>        queue;
+    Frontier<vid_t>             frontier;
     load_balancing::BinarySearch load_balancing;
     //load_balancing::VertexBased1 load_balancing;
     dist_t* d_distances   { nullptr };
@@ -99,12 +103,12 @@ const dist_t INF = std::numeric_limits<dist_t>::max();
 struct BFSOperatorAtomic {                  //deterministic
     dist_t               current_level;
     dist_t*              d_distances;
-    TwoLevelQueue<vid_t> queue;
+    Frontier<vid_t>      frontier;
 
     OPERATOR(Vertex& vertex, Edge& edge) {
         auto dst = edge.dst_id();
         if (atomicCAS(d_distances + dst, INF, current_level) == INF)
-            queue.insert(dst);
+            frontier.insert(dst);
     }
 };
 //------------------------------------------------------------------------------
@@ -117,7 +121,7 @@ struct BFSOperatorAtomic {                  //deterministic
 template <typename HornetGraph>
 BFSTOPDOWN2::BfsTopDown2(HornetGraph& hornet) :
                                  StaticAlgorithm<HornetGraph>(hornet),
-                                 queue(hornet, 5),
+                                 frontier(hornet, 5),
                                  load_balancing(hornet) {
     pool.allocate(&d_distances, hornet.nV());
     reset();
@@ -130,7 +134,7 @@ BFSTOPDOWN2::~BfsTopDown2() {
 template <typename HornetGraph>
 void BFSTOPDOWN2::reset() {
     current_level = 1;
-    queue.clear();
+    frontier.clear();
 
     auto distances = d_distances;
 
@@ -142,20 +146,26 @@ void BFSTOPDOWN2::reset() {
 template <typename HornetGraph>
 void BFSTOPDOWN2::set_parameters(vid_t source) {
     bfs_source = source;
-    queue.insert(bfs_source);               // insert bfs source in the frontier
+    frontier.insert(bfs_source);            // insert bfs source in the frontier
     gpu::memsetZero(d_distances + bfs_source);  //reset source distance
 }
 
+template <typename HornetGraph>
+void BFSTOPDOWN2::set_frontier_policy(FrontierPolicy policy,
+                                      float dense_threshold) {
+    frontier.set_policy(policy, dense_threshold);
+}
+
 template <typename HornetGraph>
 void BFSTOPDOWN2::run() {
-    while (queue.size() > 0) {
+    while (frontier.size() > 0) {
 
         forAllEdges(
             StaticAlgorithm<HornetGraph>::hornet,
-            queue,
-                    BFSOperatorAtomic { current_level, d_distances, queue },
+            frontier,
+                    BFSOperatorAtomic { current_level, d_distances, frontier },
                     load_balancing);
-        queue.swap();
+        frontier.swap();
         current_level++;
     }
 }
@@ -51,9 +51,9 @@ private:
 
     load_balancing::BinarySearch load_balancing;
 
-    TwoLevelQueue<vert_t> peel_vqueue;
-    TwoLevelQueue<vert_t> active_queue;
-    TwoLevelQueue<vert_t> iter_queue;
+    Frontier<vert_t> peel_vqueue;
+    Frontier<vert_t> active_queue;
+    Frontier<vert_t> iter_queue;
 
     vert_t *vertex_pres { nullptr };
     vert_t *vertex_deg { nullptr };
@@ -87,7 +87,7 @@ CORENUMBER::~CoreNumber() {
 struct ActiveVertices {
     vert_t *vertex_pres;
     vert_t *deg;
-    TwoLevelQueue<vert_t> active_queue;
+    Frontier<vert_t> active_queue;
 
     OPERATOR(Vertex &v) {
         vert_t id = v.id();
@@ -103,8 +103,8 @@ struct PeelVertices {
     vert_t *vertex_pres;
     vert_t *deg;
     int peel;
-    TwoLevelQueue<vert_t> peel_queue;
-    TwoLevelQueue<vert_t> iter_queue;
+    Frontier<vert_t> peel_queue;
+    Frontier<vert_t> iter_queue;
     
     //mark vertices with degrees less than peel
     OPERATOR(Vertex &v) {
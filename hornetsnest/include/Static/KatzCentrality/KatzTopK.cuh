@@ -82,9 +82,10 @@ struct KatzTopKData {
 
     bool*   is_active;
     double* lower_bound_unsorted;
-    double* lower_bound_sorted;
-    int*    vertex_array_unsorted; // Sorting
-    int*    vertex_array_sorted;   // Sorting
+    int*    vertex_array_unsorted;
+    int*    vertex_array_sorted;   // K most important vertices
+    double  kth_lower_bound;       // K-th largest lower bound of the active
+                                   // vertices
 };
 
 // Label propogation is based on the values from the previous iteration.
@@ -111,6 +112,7 @@ public:
 private:
     load_balancing::BinarySearch load_balancing;
     HostDeviceVar<KatzTopKData>     hd_katzdata;
+    TopK<double>                top_k;
     ulong_t**                   h_paths_ptr;
     bool                        is_static;
 
@@ -188,8 +190,7 @@ struct CountActive {
     HostDeviceVar<KatzTopKData> kd;
 
     OPERATOR(vert_t src) {
-        auto index = kd().vertex_array_sorted[kd().num_prev_active - kd().K];
-        if (kd().upper_bound[src] > kd().lower_bound[index])
+        if (kd().upper_bound[src] > kd().kth_lower_bound)
             atomicAdd(&(kd.ptr()->num_active), 1);
         else
             kd().is_active[src] = false;
@@ -209,6 +210,7 @@ KATZCENTRALITYTOPK::KatzCentralityTopK(HornetGraph& hornet, int max_iteration, i
                                int max_degree, bool is_static) :
                                        StaticAlgorithm<HornetGraph>(hornet),
                                        load_balancing(hornet),
+                                       top_k(hornet.nV()),
                                        is_static(is_static) {
     if (max_iteration <= 0)
         ERROR("Number of max iterations should be greater than zero")
@@ -247,7 +249,6 @@ KATZCENTRALITYTOPK::KatzCentralityTopK(HornetGraph& hornet, int max_iteration, i
     pool.allocate(&hd_katzdata().is_active,             nV);
     pool.allocate(&hd_katzdata().vertex_array_sorted,   nV);
     pool.allocate(&hd_katzdata().vertex_array_unsorted, nV);
-    pool.allocate(&hd_katzdata().lower_bound_sorted,    nV);
     pool.allocate(&hd_katzdata().lower_bound_unsorted,  nV);
 
     reset();
@@ -321,20 +322,15 @@ void KATZCENTRALITYTOPK::run() {
         auto         old_active_count = hd_katzdata().num_active;
         hd_katzdata().num_prev_active = hd_katzdata().num_active;
         hd_katzdata().num_active      = 0; // Resetting active vertices for
-                                           // sorting
-
-        // Notice that the sorts the vertices in an incremental order based on
-        // the lower bounds.
-        // The algorithms requires the vertices to be sorted in an decremental
-        // fashion.
-        // As such, we use the num_prev_active variables to store the number of
-        // previous active vertices and are able to find the K-th from last
-        // vertex (which is essentially going from the tail of the array).
-        xlib::CubSortByKey<double, vert_t>::srun
-            (hd_katzdata().lower_bound_unsorted,
-             hd_katzdata().vertex_array_unsorted,
-             old_active_count, hd_katzdata().lower_bound_sorted,
-             hd_katzdata().vertex_array_sorted);
+                                           // the selection
+
+        // Only the K-th largest lower bound of the active vertices is needed:
+        // a vertex stays active if its upper bound is above it. The
+        // k-selection avoids sorting all the active vertices.
+        hd_katzdata().kth_lower_bound = top_k.kthLargest(
+                                            hd_katzdata().lower_bound_unsorted,
+                                            old_active_count,
+                                            hd_katzdata().K);
 
         forAllnumV(StaticAlgorithm<HornetGraph>::hornet, CountActive { hd_katzdata } );
         hd_katzdata.sync();
@@ -350,44 +346,41 @@ void KATZCENTRALITYTOPK::copyKCToHost(double* d) {
 // commented out due to to large execution overheads.
 template <typename HornetGraph>
 void KATZCENTRALITYTOPK::printKMostImportant() {
-    ulong_t* num_paths_curr;
-    ulong_t* num_paths_prev;
     int*     vertex_array;
-    int*     vertex_array_unsorted;
     double*  KC;
     double*  lower_bound;
     double*  upper_bound;
 
     auto nV = StaticAlgorithm<HornetGraph>::hornet.nV();
-    host::allocate(num_paths_curr, nV);
-    host::allocate(num_paths_prev, nV);
-    host::allocate(vertex_array,   nV);
-    host::allocate(vertex_array_unsorted, nV);
+    auto K  = hd_katzdata().K;
+    if (hd_katzdata().num_prev_active <= K)
+        return;
+    host::allocate(vertex_array, K);
     host::allocate(KC,          nV);
     host::allocate(lower_bound, nV);
     host::allocate(upper_bound, nV);
 
+    top_k.select(hd_katzdata().lower_bound_unsorted,
+                 hd_katzdata().vertex_array_unsorted,
+                 hd_katzdata().num_prev_active, K,
+                 hd_katzdata().vertex_array_sorted);
+
     gpu::copyToHost(hd_katzdata().lower_bound, nV, lower_bound);
     gpu::copyToHost(hd_katzdata().upper_bound, nV, upper_bound);
     gpu::copyToHost(hd_katzdata().KC, nV, KC);
-    gpu::copyToHost(hd_katzdata().vertex_array_sorted, nV, vertex_array);
-    gpu::copyToHost(hd_katzdata().vertex_array_unsorted, nV,
-                    vertex_array_unsorted);
-
-    if (hd_katzdata().num_prev_active > hd_katzdata().K) {
-        for (int i = hd_katzdata().num_prev_active - 1;
-                i >= hd_katzdata().num_prev_active - hd_katzdata().K; i--) {
-            vert_t j = vertex_array[i];
-            std::cout << j << "\t\t" << KC[j] << "\t\t" << upper_bound[j]
-                      << upper_bound[j] - lower_bound[j] << "\n";
-        }
+    gpu::copyToHost(hd_katzdata().vertex_array_sorted, K, vertex_array);
+
+    // only the K selected vertices are sorted
+    std::sort(vertex_array, vertex_array + K,
+              [&](vert_t a, vert_t b) { return lower_bound[a] > lower_bound[b]; });
+    for (int i = 0; i < K; i++) {
+        vert_t j = vertex_array[i];
+        std::cout << j << "\t\t" << KC[j] << "\t\t" << upper_bound[j]
+                  << upper_bound[j] - lower_bound[j] << "\n";
     }
     std::cout << std::endl;
 
-    host::free(num_paths_curr);
-    host::free(num_paths_prev);
     host::free(vertex_array);
-    host::free(vertex_array_unsorted);
     host::free(KC);
     host::free(lower_bound);
     host::free(upper_bound);
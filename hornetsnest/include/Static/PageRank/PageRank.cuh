@@ -92,6 +92,13 @@ public:
 
 	void printRankings();
 
+    /**
+     * @brief the `N` vertices with the highest rank
+     * @param[out] h_ids host array of `N` vertex ids, by decreasing rank
+     * @return the N-th highest rank
+     */
+    pr_t topN(int N, vid_t* h_ids);
+
     PrData pr_data();
 
 private:
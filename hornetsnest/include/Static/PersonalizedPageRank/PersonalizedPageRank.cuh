@@ -0,0 +1,375 @@
+/*
+ * Copyright (c) 2019, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "HornetAlg.hpp"
+#include <BufferPool.cuh>
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace hornets_nest {
+
+#define PERSONALIZEDPAGERANK PersonalizedPageRankT<WIDTH>
+
+using vid_t = int;
+using HornetGraph = ::hornet::gpu::Hornet<vid_t>;
+using HornetInit  = ::hornet::HornetInit<vid_t>;
+
+using ppr_t = float;
+
+/**
+ * @brief Personalized PageRank with forward push (Andersen, Chung, Lang,
+ *        "Local Graph Partitioning using PageRank Vectors", FOCS 2006)
+ * @details Every query (lane) keeps an estimate `p` and a residual `r`,
+ *          initially `r = s`, the personalization vector of its seed set.
+ *          A vertex is pushed when `r(v) >= epsilon * deg(v)` in some lane:
+ *          `alpha * r(v)` moves to `p(v)` and `(1 - alpha) * r(v)` is spread
+ *          over the out-neighbors of `v`. All the active vertices are pushed
+ *          in the same sweep, which ends when every residual is below its
+ *          threshold. Then `0 <= ppr(v) - p(v) <= sum(r)` for every vertex.
+ *
+ *          `WIDTH` queries are solved together: the values of a vertex are
+ *          stored as a dense block of `WIDTH` lanes (`p[v * WIDTH + lane]`),
+ *          so a single `forAllEdges` sweep advances all the queries.
+ *          Dangling vertices behave as if they had a self-loop.
+ * @tparam WIDTH number of queries packed per vertex (1, or 8 to 32 for the
+ *         batched mode)
+ */
+template<int WIDTH>
+class PersonalizedPageRankT : public StaticAlgorithm<HornetGraph> {
+    static_assert(WIDTH >= 1 && WIDTH <= 32, "WIDTH must be in [1, 32]");
+public:
+    PersonalizedPageRankT(HornetGraph& hornet,
+                          ppr_t alpha      = 0.15f,
+                          ppr_t epsilon    = 1e-6f,
+                          int   max_sweeps = 1000);
+    ~PersonalizedPageRankT();
+
+    void reset()    override;
+    void run()      override;
+    void release()  override;
+    bool validate() override;
+
+    /**
+     * @brief one seed vertex per lane
+     * @param[in] h_seeds host array of `num_seeds <= WIDTH` vertex ids
+     */
+    void set_seeds(const vid_t* h_seeds, int num_seeds);
+
+    /**
+     * @brief one seed set per lane, the restart probability is uniform over
+     *        the set
+     * @param[in] h_offsets host array of `num_sets + 1` offsets in `h_seeds`
+     * @param[in] h_seeds host array of the vertex ids of all the sets
+     */
+    void set_seed_sets(const int* h_offsets, const vid_t* h_seeds,
+                       int num_sets);
+
+    /**
+     * @brief copies the estimate of `lane` on the host
+     * @param[out] h_scores host array of `nV` values
+     */
+    void copyScoresToHost(int lane, ppr_t* h_scores) const;
+
+    /**
+     * @brief copies the residual of `lane` on the host
+     * @param[out] h_residuals host array of `nV` values
+     */
+    void copyResidualsToHost(int lane, ppr_t* h_residuals) const;
+
+    int  num_queries()   const noexcept;
+    int  sweeps()        const noexcept;
+    long pushed_vertices() const noexcept;
+
+private:
+    load_balancing::BinarySearch load_balancing;
+    TwoLevelQueue<vid_t>         frontier;
+
+    BufferPool pool;
+    ppr_t* estimate  { nullptr };
+    ppr_t* residual  { nullptr };
+    ppr_t* pushed    { nullptr };
+    int*   queued    { nullptr };
+
+    std::vector<int>   h_offsets;
+    std::vector<vid_t> h_seeds;
+
+    ppr_t alpha;
+    ppr_t epsilon;
+    int   max_sweeps;
+    int   num_sweeps   { 0 };
+    long  pushed_count { 0 };
+
+    void lane_copy(const ppr_t* d_array, int lane, ppr_t* h_array) const;
+};
+
+using PersonalizedPageRank = PersonalizedPageRankT<1>;
+
+template<int WIDTH>
+using PersonalizedPageRankBatch = PersonalizedPageRankT<WIDTH>;
+
+//==============================================================================
+
+namespace ppr {
+
+__device__ __forceinline__
+ppr_t pushThreshold(ppr_t epsilon, degree_t degree) {
+    return epsilon * static_cast<ppr_t>(degree > 0 ? degree : 1);
+}
+
+/*
+ * takes the residual of the active vertices: the estimate grows by alpha,
+ * the rest is split among the out-neighbors
+ */
+template<int WIDTH>
+struct PushVertex {
+    ppr_t* estimate;
+    ppr_t* residual;
+    ppr_t* pushed;
+    ppr_t  alpha;
+
+    OPERATOR(Vertex& v) {
+        vid_t    id     = v.id();
+        degree_t degree = v.degree();
+        #pragma unroll
+        for (int lane = 0; lane < WIDTH; lane++) {
+            int   pos   = id * WIDTH + lane;
+            ppr_t value = residual[pos];
+            residual[pos] = 0;
+            if (degree == 0) {
+                estimate[pos] += value;
+                pushed[pos]    = 0;
+            }
+            else {
+                estimate[pos] += alpha * value;
+                pushed[pos]    = (1 - alpha) * value / degree;
+            }
+        }
+    }
+};
+
+/*
+ * a vertex enters the next frontier when one of its residuals reaches the
+ * threshold, at most once per sweep
+ */
+template<int WIDTH>
+struct PushEdges {
+    ppr_t* residual;
+    const ppr_t* pushed;
+    int*   queued;
+    ppr_t  epsilon;
+    int    sweep;
+    TwoLevelQueue<vid_t> frontier;
+
+    OPERATOR(Vertex& v, Edge& e) {
+        vid_t src = v.id();
+        vid_t dst = e.dst_id();
+        ppr_t threshold = pushThreshold(epsilon, e.dst().degree());
+        bool  activated = false;
+        #pragma unroll
+        for (int lane = 0; lane < WIDTH; lane++) {
+            ppr_t value = pushed[src * WIDTH + lane];
+            if (value == 0)
+                continue;
+            ppr_t old = atomicAdd(residual + dst * WIDTH + lane, value);
+            activated |= (old < threshold && old + value >= threshold);
+        }
+        if (activated && atomicExch(queued + dst, sweep) != sweep)
+            frontier.insert(dst);
+    }
+};
+
+struct VertexDegree {
+    degree_t* degrees;
+
+    OPERATOR(Vertex& v) {
+        degrees[v.id()] = v.degree();
+    }
+};
+
+} // namespace ppr
+
+//==============================================================================
+
+template<int WIDTH>
+PERSONALIZEDPAGERANK::PersonalizedPageRankT(HornetGraph& hornet,
+                                            ppr_t alpha_,
+                                            ppr_t epsilon_,
+                                            int   max_sweeps_) :
+                                StaticAlgorithm(hornet),
+                                load_balancing(hornet),
+                                frontier(hornet),
+                                alpha(alpha_),
+                                epsilon(epsilon_),
+                                max_sweeps(max_sweeps_) {
+    pool.allocate(&estimate, hornet.nV() * WIDTH);
+    pool.allocate(&residual, hornet.nV() * WIDTH);
+    pool.allocate(&pushed,   hornet.nV() * WIDTH);
+    pool.allocate(&queued,   hornet.nV());
+    reset();
+}
+
+template<int WIDTH>
+PERSONALIZEDPAGERANK::~PersonalizedPageRankT() {
+    release();
+}
+
+template<int WIDTH>
+void PERSONALIZEDPAGERANK::reset() {
+    gpu::memsetZero(estimate, hornet.nV() * WIDTH);
+    gpu::memsetZero(residual, hornet.nV() * WIDTH);
+    gpu::memset(queued, hornet.nV(), 0xFF);
+    frontier.clear();
+    num_sweeps   = 0;
+    pushed_count = 0;
+}
+
+template<int WIDTH>
+void PERSONALIZEDPAGERANK::release() {
+    estimate = nullptr;
+    residual = nullptr;
+    pushed   = nullptr;
+    queued   = nullptr;
+}
+
+template<int WIDTH>
+void PERSONALIZEDPAGERANK::set_seeds(const vid_t* seeds, int num_seeds) {
+    std::vector<int> offsets(num_seeds + 1);
+    for (int i = 0; i <= num_seeds; i++)
+        offsets[i] = i;
+    set_seed_sets(offsets.data(), seeds, num_seeds);
+}
+
+template<int WIDTH>
+void PERSONALIZEDPAGERANK::set_seed_sets(const int* offsets,
+                                         const vid_t* seeds, int num_sets) {
+    if (num_sets < 1 || num_sets > WIDTH)
+        ERROR("The number of seed sets must be in [1, ", WIDTH, "]")
+    h_offsets.assign(offsets, offsets + num_sets + 1);
+    h_seeds.assign(seeds, seeds + offsets[num_sets]);
+}
+
+template<int WIDTH>
+void PERSONALIZEDPAGERANK::run() {
+    using namespace ppr;
+    reset();
+    //initial residual: the personalization vector of every lane
+    std::vector<ppr_t> h_residual(hornet.nV() * WIDTH, 0);
+    std::vector<vid_t> roots;
+    for (int lane = 0; lane + 1 < static_cast<int>(h_offsets.size()); lane++) {
+        int set_size = h_offsets[lane + 1] - h_offsets[lane];
+        for (int i = h_offsets[lane]; i < h_offsets[lane + 1]; i++) {
+            vid_t seed = h_seeds[i];
+            h_residual[seed * WIDTH + lane] += ppr_t(1) / set_size;
+            roots.push_back(seed);
+        }
+    }
+    std::sort(roots.begin(), roots.end());
+    roots.erase(std::unique(roots.begin(), roots.end()), roots.end());
+    host::copyToDevice(h_residual.data(), h_residual.size(), residual);
+    //host insertions go to the input level of the queue
+    frontier.insert(roots.data(), roots.size());
+
+    while (frontier.size() > 0 && num_sweeps < max_sweeps) {
+        pushed_count += frontier.size();
+        forAllVertices(hornet, frontier,
+                       PushVertex<WIDTH> { estimate, residual, pushed, alpha });
+        forAllEdges(hornet, frontier,
+                    PushEdges<WIDTH> { residual, pushed, queued, epsilon,
+                                       num_sweeps, frontier },
+                    load_balancing);
+        frontier.swap();
+        num_sweeps++;
+    }
+}
+
+template<int WIDTH>
+void PERSONALIZEDPAGERANK::lane_copy(const ppr_t* d_array, int lane,
+                                     ppr_t* h_array) const {
+    std::vector<ppr_t> h_block(hornet.nV() * WIDTH);
+    gpu::copyToHost(d_array, h_block.size(), h_block.data());
+    for (vid_t v = 0; v < hornet.nV(); v++)
+        h_array[v] = h_block[v * WIDTH + lane];
+}
+
+template<int WIDTH>
+void PERSONALIZEDPAGERANK::copyScoresToHost(int lane, ppr_t* h_scores) const {
+    lane_copy(estimate, lane, h_scores);
+}
+
+template<int WIDTH>
+void PERSONALIZEDPAGERANK::copyResidualsToHost(int lane,
+                                               ppr_t* h_residuals) const {
+    lane_copy(residual, lane, h_residuals);
+}
+
+template<int WIDTH>
+int PERSONALIZEDPAGERANK::num_queries() const noexcept {
+    return static_cast<int>(h_offsets.size()) - 1;
+}
+
+template<int WIDTH>
+int PERSONALIZEDPAGERANK::sweeps() const noexcept {
+    return num_sweeps;
+}
+
+template<int WIDTH>
+long PERSONALIZEDPAGERANK::pushed_vertices() const noexcept {
+    return pushed_count;
+}
+
+/*
+ * after convergence every residual is non-negative and below its threshold,
+ * and estimate + residual keeps the unit mass of the seed set in every lane
+ */
+template<int WIDTH>
+bool PERSONALIZEDPAGERANK::validate() {
+    using namespace ppr;
+    thrust::device_vector<degree_t> d_degrees(hornet.nV());
+    forAllVertices(hornet, VertexDegree { d_degrees.data().get() });
+    std::vector<degree_t> h_degrees(hornet.nV());
+    gpu::copyToHost(d_degrees.data().get(), hornet.nV(), h_degrees.data());
+
+    std::vector<ppr_t> h_estimate(hornet.nV() * WIDTH);
+    std::vector<ppr_t> h_residual(hornet.nV() * WIDTH);
+    gpu::copyToHost(estimate, h_estimate.size(), h_estimate.data());
+    gpu::copyToHost(residual, h_residual.size(), h_residual.data());
+
+    bool is_converged = num_sweeps < max_sweeps;
+    for (int lane = 0; lane < num_queries(); lane++) {
+        double mass = 0;
+        for (vid_t v = 0; v < hornet.nV(); v++) {
+            ppr_t r = h_residual[v * WIDTH + lane];
+            ppr_t threshold = epsilon * std::max(h_degrees[v], 1);
+            if (r < 0 || h_estimate[v * WIDTH + lane] < 0 ||
+                    (is_converged && r >= threshold)) {
+                std::cout << "lane " << lane << "  vertex " << v
+                          << "  estimate: " << h_estimate[v * WIDTH + lane]
+                          << "  residual: " << r << "\n";
+                return false;
+            }
+            mass += h_estimate[v * WIDTH + lane] + r;
+        }
+        if (std::abs(mass - 1.0) > 1e-3) {
+            std::cout << "lane " << lane << "  total mass: " << mass << "\n";
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace hornets_nest
@@ -38,337 +38,177 @@
  */
 #include "Dynamic/PageRank/PageRank.cuh"
 #include "PageRankOperators.cuh"
+#include <cmath>
+#include <vector>
 
 namespace hornets_nest {
-//namespace hornet_alg {
-//#if 0
-//PageRankDynamic::PageRankDynamic(HornetGPU& hornet, //HornetGraph& hornet,
-//                                HornetGPU& inverted_graph, //HornetGraph& inverted_graph,
-//                                int  iteration_max,
-//                                pr_t threshold,
-//                                pr_t damp) :
-//                         StaticAlgorithm(hornet),
-//                         load_balancing(hornet), //load_balancing(hornet),
-//                         inverted_graph(inverted_graph),
-//                         is_directed(false),
-//                         pr_static(hornet, iteration_max, 
-//                                threshold, damp, false) {
-//#else
-//PageRankDynamic::PageRankDynamic(HornetGPU& hornet, //HornetGraph& hornet,
-//                                HornetGPU& inverted_graph, //HornetGraph& inverted_graph,
-//                                int  iteration_max,
-//                                pr_t threshold,
-//                                pr_t damp) :
-//                         StaticAlgorithm(hornet),
-//                         load_balancing(hornet), //load_balancing(hornet),
-//                         inverted_graph(inverted_graph),
-//                         is_directed(false),
-//                         pr_static(hornet, iteration_max, 
-//                                threshold, damp) { //, false) {
-//#endif
-//    printf("------------- dynamic pr 1");
-//
-//    //hd_prdata().active_queue.initialize(hornet);
-//    hd_prdata().queue1.initialize(hornet);//initialize(hornet);
-//    hd_prdata().queue2.initialize(hornet);//initialize(hornet);
-//    hd_prdata().queue3.initialize(hornet);//initialize(hornet);
-//    hd_prdata().queueDlt.initialize(hornet);//initialize(hornet);
-//
-//    gpu::allocate(hd_prdata().visited,    hornet.nV());
-//    gpu::allocate(hd_prdata().visitedDlt, hornet.nV());
-//    gpu::allocate(hd_prdata().usedOld,    hornet.nV());
-//    gpu::allocate(hd_prdata().diffPR,     hornet.nV());
-//    gpu::allocate(hd_prdata().delta,      hornet.nV());
-//
-//    hd_prdata = pr_static.pr_data();
-//
-//    std::cout << "Oded remember to take care of memory de-allocation\n"
-//              << "Oded need to figure out correct API for dynamic graph"
-//              << "algorithms\n"
-//              << "Dynamic PageRank algorithm needs to get both the"
-//              << "original graph and the inverted graph for directed graphs"
-//              << std::endl;
-//}
-PageRankDynamic::PageRankDynamic(HornetGPU& hornet, ////HornetGraph& hornet,
+
+///@brief bound on the residual sweeps of an update
+const int MAX_SWEEPS = 10000;
+
+//rank flows along the out-edges (push contributions), as in the update
+PageRankDynamic::PageRankDynamic(HornetGraph& hornet,
                                  int  iteration_max,
                                  pr_t threshold,
                                  pr_t damp) :
                         StaticAlgorithm(hornet),
-                        load_balancing(hornet), //load_balancing(hornet),
-                        is_directed(true),
-                        pr_static(hornet, iteration_max, 
-                                 threshold, damp) { //, true) {
-
-    printf("------------- dynamic pr 2");
-    hd_prdata = pr_static.pr_data(); //!!!! ERROR!!!!
-    printf("------------- dynamic pr 2");
-    //hd_prdata().active_queue.initialize(hornet);
-    hd_prdata().queue1.initialize(hornet);//initialize(hornet);
-    hd_prdata().queue2.initialize(hornet);//initialize(hornet);
-    hd_prdata().queue3.initialize(hornet);//initialize(hornet);
-    hd_prdata().queueDlt.initialize(hornet);//initialize(hornet);
-
-    printf("------------- dynamic pr 2");
-    pool.allocate(&hd_prdata().visited,    hornet.nV());
-    pool.allocate(&hd_prdata().visitedDlt, hornet.nV());
-    pool.allocate(&hd_prdata().usedOld,    hornet.nV());
-    pool.allocate(&hd_prdata().diffPR,     hornet.nV());
-    pool.allocate(&hd_prdata().delta,      hornet.nV());
-
-    //printf("------------- dynamic pr 2");
-    std::cerr<<"------------- dynamic pr 2";
-
-    //std::cout << "Oded remember to take care of memory de-allocation\n"
-    //          << "Oded need to figure out correct API for dynamic graph"
-    //          << "algorithms\n"
-    //          << "Dynamic PageRank algorithm needs to get both the"
-    //          << "original graph and the inverted graph for directed graphs"
-    //          << std::endl;
+                        load_balancing(hornet),
+                        pr_static(hornet, iteration_max, threshold, damp, true),
+                        queue(hornet) {
+    PrDynamicData data(pr_static.pr_data());
+    pool.allocate(&data.residual, hornet.nV());
+    pool.allocate(&data.delta,    hornet.nV());
+    pool.allocate(&data.visited,  hornet.nV());
+    pool.allocate(&data.removed,  hornet.nV());
+    data.epsilon = threshold / static_cast<pr_t>(hornet.nV());
+    data.sweep   = 0;
+    hd_prdata = data;
+    reset();
 }
 
 PageRankDynamic::~PageRankDynamic() {
     release();
 }
 
-void PageRankDynamic::run() {
+void PageRankDynamic::release() {
+    hd_prdata().residual = nullptr;
+    hd_prdata().delta    = nullptr;
+    hd_prdata().visited  = nullptr;
+    hd_prdata().removed  = nullptr;
+}
 
-    //printf("run_static: 11111\n");
+void PageRankDynamic::reset() {
+    hd_prdata().iteration = 0;
+    hd_prdata().sweep     = 0;
+    pushed_count          = 0;
+    queue.clear();
+}
 
-    // Executing the static graph algorithm
+/*
+ * cold start, then the residual of the static ranks is pushed below epsilon
+ * so that the updates start from an exact state
+ */
+void PageRankDynamic::run() {
+    using namespace pr_dynamic;
+    reset();
     pr_static.reset();
     pr_static.run();
-
-    //hd_prdata().iteration_static = hd_prdata().iteration;
-    hd_prdata().iteration = hd_prdata().iteration;
-
-    // Initializing the fields of the dynamic graph algorithm
-    forAllnumV(hornet, InitStreaming { hd_prdata });
+    cold_iterations = pr_static.get_iteration_count();
+
+    forAllnumV(hornet, InitResidual { hd_prdata });
+    forAllEdges(hornet, AddRankContributions { hd_prdata }, load_balancing);
+    hd_prdata().sweep++;
+    forAllnumV(hornet, EnqueueActive { hd_prdata, queue });
+    queue.swap();
+    propagate();
 }
 
-void PageRankDynamic::release(){
+/*
+ * `batch_src`/`batch_dst`: erased edges, hidden until `hornet.erase`
+ */
+void PageRankDynamic::propagate(const vid_t* batch_src, const vid_t* batch_dst,
+                                int batch_size) {
+    using namespace pr_dynamic;
+    BatchView view { batch_src, batch_dst, batch_size, batch_size == 0 };
+    hd_prdata().iteration = 0;
+    pushed_count          = 0;
+    while (queue.size() > 0 && hd_prdata().iteration < MAX_SWEEPS) {
+        pushed_count += queue.size();
+        forAllVertices(hornet, queue, PushResidual { hd_prdata });
+        hd_prdata().sweep++;
+        forAllEdges(hornet, queue, PropagateResidual { hd_prdata, view, queue },
+                    load_balancing);
+        queue.swap();
+        hd_prdata().iteration++;
+    }
 }
 
-bool PageRankDynamic::validate() {
-	return true;//?????????
+void PageRankDynamic::batchUpdateInserted(BatchUpdate& batch_update) {
+    processUpdate(batch_update, true);
 }
 
-//==============================================================================
-void PageRankDynamic::reset(){
-    hd_prdata().iteration = 0;
-    hd_prdata().queue1.clear();
-    hd_prdata().queue2.clear();
-    hd_prdata().queue3.clear();
-    hd_prdata().queueDlt.clear();
+void PageRankDynamic::batchUpdateDeleted(BatchUpdate& batch_update) {
+    batch_update.sort();
+    batch_update.remove_batch_duplicates(false);
+    processUpdate(batch_update, false);
 }
 
 void PageRankDynamic::processUpdate(BatchUpdate& batch_update,
                                     bool is_insert) {
-    //printf("--(DynamicPR)processUpdate\n");
-//---------------------------------------------------------------------        
-//        generateBatch(graph, batch_size, batch_src, batch_dst,
-//                      BatchGenType::INSERT, UNIQUE); //| PRINT
-          vid_t batch_src[] = { 0, 0, 2 };
-          vid_t batch_dst[] = { 2, 6, 7 };
-          auto batch_size = 3;
-//        gpu::BatchUpdate batch_update(batch_src, batch_dst, batch_size);
-//---------------------------------------------------------------------            
-
-    // Resetting the queue of the active vertices.
-    //hd_prdata().active_queue.clear();
-    hd_prdata().iteration = 1;
-    //hd_prdata().iteration = 0;
-    hd_prdata().queue1.clear();
-    hd_prdata().queue2.clear();
-    hd_prdata().queue3.clear();
-    hd_prdata().queueDlt.clear();
-
-    //insert vertices in updating list in Q1
-    for(auto i=0; i<batch_size; i++) {
-        hd_prdata().queue1.insert(batch_src[i]);
-        hd_prdata().queue1.insert(batch_dst[i]);
-        //cout << "queueu1 enqueue [" << i << "]: " << edgeSrc[i] << endl;
-    }  
-
-
-//TO DO:: usedOld
-//copyArrayHostToDevice((length_t*)len,hostPRData.usedOld,hostPRData.nv,sizeof(length_t));
+    using namespace pr_dynamic;
+    int batch_size = batch_update.nE();
+    hd_prdata().iteration = 0;
+    pushed_count          = 0;
+    if (batch_size == 0)
+        return;
+    auto batch_ptr = batch_update.in_edge().get_soa_ptr();
+    const vid_t* batch_src = batch_ptr.template get<0>();
+    const vid_t* batch_dst = batch_ptr.template get<1>();
+    BatchView view { batch_src, batch_dst, batch_size, is_insert };
+
+    //the sources of the batch are the only vertices whose degree changes
+    queue.clear();
+    forAll(batch_size, EnqueueBatchSources { batch_src, queue });
+    queue.swap();
+    if (is_insert)
+        forAll(batch_size, CountBatchEdges { hd_prdata, batch_src });
+    else
+        forAllEdges(hornet, queue, CountErased { hd_prdata, view },
+                    load_balancing);
+
+    hd_prdata().sweep++;
+    forAllEdges(hornet, queue, BatchResidual { hd_prdata, view, queue },
+                load_balancing);
+    queue.swap();
 
-//(update)--------------------------
-    // Initialization of insertions or deletions is slightly different.
     if (is_insert) {
-        //forAllEdges(hornet, batch_update, SetupInsertions { hd_prdata } );
-        //forAllEdges(hornet, batch_update, RecomputeInsertionContriUndirected { hd_prdata } );
-        forAllEdges(hornet, batch_update, RecomputeContri { hd_prdata } );
-    } else {
-        //forAllEdges(hornet, batch_update, SetupDeletions { hd_prdata } );
-        forAllEdges(hornet, batch_update, RecomputeContri { hd_prdata } );
-        //forAllEdges(hornet, batch_update, RecomputeDeletionContriUndirected { hd_prdata } );
-    }
-    hd_prdata.sync();
-
-    //OK:: clear --> InitStreaming
-
-    hd_prdata.sync(); // Syncing queue info
-    //move dlt
-    forAll(hd_prdata().queueDlt, //hd_prdata().num_active
-            UpdateDltMove { hd_prdata });
-    hd_prdata.sync(); // Syncing queue info
-    //update contri --> curr_pr
-    forAll(hd_prdata().queue2, //hd_prdata().num_active
-            UpdateContriCopy { hd_prdata });
-    hd_prdata.sync(); // Syncing queue info
-    //move dlt
-    forAll(hd_prdata().queueDlt, //hd_prdata().num_active
-            UpdateDltCopy { hd_prdata });
-    hd_prdata.sync(); // Syncing queue info
-
-//(propagation)--------------------
-    hd_prdata().iteration = 2;
-    int i = 0;
-    while(hd_prdata().queue2.size()>0)
-    {
-        //update contri --> curr_pr
-        //forAll(hd_prdata().queue2, //hd_prdata().num_active
-        //        UpdateContri { hd_prdata });
-        forAllEdges(hornet, hd_prdata().queue2, 
-                    UpdateContri { hd_prdata }, load_balancing);
-        hd_prdata.sync(); // Syncing queue info
-        //move dlt
-        forAll(hd_prdata().queueDlt, //hd_prdata().num_active
-                UpdateDltMove { hd_prdata });
-        hd_prdata.sync(); // Syncing queue info
-        //update contri --> curr_pr
-        forAll(hd_prdata().queue2, //hd_prdata().num_active
-                UpdateContriCopy { hd_prdata });
-        hd_prdata.sync(); // Syncing queue info
-        //move dlt
-        forAll(hd_prdata().queueDlt, //hd_prdata().num_active
-                UpdateDltCopy { hd_prdata });
-        hd_prdata.sync(); // Syncing queue info
-        if(i == 0){
-        //move dlt
-            forAll(hd_prdata().queue1, //hd_prdata().num_active
-                    RemoveContri { hd_prdata });
-        }
-        hd_prdata.sync(); // Syncing queue info       
-        i++;
-    }
-
-    //TO DO: copy curr_pr to prev_pr
-    //???????????????????????????????????????????????
-    //hostPRData.queue2.setQueueCurr(0); 
-    //prevEnd = hostPRData.queue2.getQueueEnd();
-    forAll(hd_prdata().queue2, //hd_prdata().num_active
-            PrevEqCurr { hd_prdata });
-
-//(recompute)--------------------
-    //TO DO:: condition for while loop -- h_out is static pr member..
-    //while(hd_prdata().iteration < hd_prdata().iterationMax)// && h_out>hostPRData.threshold)
-    {
-        if (hd_prdata().queue2.size() != 0) {
-        forAllVertices(hornet, hd_prdata().queue2, //hd_prdata().num_active
-                ComputeContribuitionPerVertex { hd_prdata });
-        forAllEdges(hornet, hd_prdata().queue2, //hd_prdata().num_active
-                AddContribuitionsUndirected { hd_prdata }, load_balancing);
-        forAll(hd_prdata().queue2, //hd_prdata().num_active
-                DampAndDiffAndCopy { hd_prdata });
-        forAllVertices(hornet, hd_prdata().queue2, //hd_prdata().num_active
-                ComputeContribuitionPerVertex { hd_prdata });
-        forAllnumV(hornet, Sum { hd_prdata });
-
-        hd_prdata.sync(); // Syncing queue info   
-        }
-
-        //host::copyFromDevice(hd_prdata().reduction_out, h_out);
-        //hd_prdata().iteration++;
-    }
-
-
-#if 0    
-    while (hd_prdata().iteration < hd_prdata().max_iteration &&
-           hd_prdata().iteration < hd_prdata().iteration_static) {
-        hd_prdata().alphaI = std::pow(hd_prdata().alpha,
-                                        hd_prdata().iteration);
-
-        forAll(hd_prdata().active_queue, //hd_prdata().num_active
-               InitActiveNewPaths { hd_prdata });
-
-        // Undirected graphs and directed graphs need to be dealt with differently.
-        if (!is_directed) {
-            forAllEdges(hornet, hd_prdata().active_queue,
-                        FindNextActive { hd_prdata }, load_balancing);
-            hd_prdata.sync(); // Syncing queue info
-
-            forAllEdges(hornet, hd_prdata().active_queue,
-                        UpdateActiveNewPaths { hd_prdata }, load_balancing);
-        }
-        else {
-            forAllEdges(inverted_graph, hd_prdata().active_queue,
-                        FindNextActive { hd_prdata }, load_balancing);
-            hd_prdata.sync();
-            
-            forAllEdges(inverted_graph, hd_prdata().active_queue,
-                        UpdateActiveNewPaths { hd_prdata }, load_balancing);
-        }
-        hd_prdata.sync(); // Syncing queue info
-
-        // Checking if we are dealing with a batch of insertions or deletions.
-        if (is_insert) {
-            forAllEdges(hornet, batch_update,
-                        UpdateNewPathsBatchInsert { hd_prdata });
-        }
-        else {
-            forAllEdges(hornet, batch_update,
-                        UpdateNewPathsBatchDelete { hd_prdata });
-        }
-        hd_prdata.sync();
-
-        forAll(hd_prdata().active_queue, UpdatePrevWithCurr { hd_prdata });
-        hd_prdata.sync();
-
-        hd_prdata().iteration++;
+        forAll(batch_size, ClearBatchEdges { hd_prdata, batch_src });
+        propagate();
     }
-
-    if (hd_prdata().iteration > 2) {
-        forAll(hd_prdata().active_queue, //hd_prdata().num_active?
-               UpdateLastIteration { hd_prdata } );
-        hd_prdata.sync();
+    else {
+        propagate(batch_src, batch_dst, batch_size);
+        forAll(batch_size, ClearBatchEdges { hd_prdata, batch_src });
     }
-    // Resetting the fields of the dynamic graph algorithm for all the vertices
-    // that were active
-    //hd_prdata().num_active ??
-    forAll(hd_prdata().active_queue,  InitStreaming {hd_prdata});
-#endif
-
-
-
 }
 
 //------------------------------------------------------------------------------
-int PageRankDynamic::get_iteration_count(){
-    //printf("22222\n");
+
+int PageRankDynamic::get_iteration_count() {
     return hd_prdata().iteration;
 }
 
-void PageRankDynamic::batchUpdateInserted(BatchUpdate &batch_update) {
-    processUpdate(batch_update, true);
-    //printf("33333\n");
+int PageRankDynamic::cold_start_iteration_count() {
+    return cold_iterations;
 }
 
-void PageRankDynamic::batchUpdateDeleted(BatchUpdate &batch_update) {
-    processUpdate(batch_update, false);
-    //printf("44444\n");
+long PageRankDynamic::pushed_vertices() const noexcept {
+    return pushed_count;
 }
 
-void PageRankDynamic::copyPRToHost(double* host_array) {
-    //printf("55555\n");
-//    pr_static.copyKCToHost(host_array);
+void PageRankDynamic::copyPRToHost(pr_t* host_array) {
+    gpu::copyToHost(hd_prdata().curr_pr, hornet.nV(), host_array);
 }
 
-void PageRankDynamic::copyNumPathsToHost(ulong_t* host_array) {
-    //printf("66666\n");
-//    pr_static.copyNumPathsToHost(host_array);
+/*
+ * compares the ranks against a cold start on the current graph: both are
+ * within threshold / (1 - damp) of the exact ranks (L1 norm)
+ */
+bool PageRankDynamic::validate() {
+    StaticPageRank cold_start(hornet, hd_prdata().iteration_max,
+                              hd_prdata().threshold, hd_prdata().damp, true);
+    cold_start.run();
+    cold_iterations = cold_start.get_iteration_count();
+
+    const pr_t* h_static = cold_start.get_page_rank_score_host();
+    std::vector<pr_t> h_dynamic(hornet.nV());
+    copyPRToHost(h_dynamic.data());
+
+    double error = 0;
+    for (vid_t v = 0; v < hornet.nV(); v++)
+        error += std::abs(static_cast<double>(h_static[v]) - h_dynamic[v]);
+    double tolerance = 2.0 * hd_prdata().threshold / (1.0 - hd_prdata().damp);
+    std::cout << "L1 distance from the static ranks: " << error << "\n";
+    return error <= tolerance;
 }
 
 }// hornets_nest namespace
-
@@ -37,337 +37,199 @@
  * @file
  */
 
-//------------------------------------------------------------------------------
 #pragma once
 
 namespace hornets_nest {
-//namespace hornet_alg {
-struct InitStreaming {
-    HostDeviceVar<PrDynamicData> pd;
+namespace pr_dynamic {
 
-    OPERATOR(vid_t src) {
-        pd().visited[src]     = 0;
-        pd().visitedDlt[src]  = 0;
-        pd().diffPR[src]      = 0.0f;
-        pd().delta[src]       = 0.0f;
-        *pd().reduction_out   = 0;
-    }
-};
-//------------------------------------------------------------------------------
-struct SetupInsertions {
-    HostDeviceVar<PrDynamicData> pd;
+/*
+ * the batch is sorted by (src, dst) after BatchUpdate::preprocess
+ */
+__device__ __forceinline__
+bool batchContains(const vid_t* __restrict__ batch_src,
+                   const vid_t* __restrict__ batch_dst,
+                   int batch_size, vid_t src, vid_t dst) {
+    int low = 0, high = batch_size;
+    while (low < high) {
+        int mid = (low + high) / 2;
+        if (batch_src[mid] < src ||
+                (batch_src[mid] == src && batch_dst[mid] < dst))
+            low = mid + 1;
+        else
+            high = mid;
+    }
+    return low < batch_size && batch_src[low] == src && batch_dst[low] == dst;
+}
+
+/*
+ * erased edges stay in the graph until `hornet.erase`: they are hidden
+ * while the residuals are propagated
+ */
+struct BatchView {
+    const vid_t* batch_src;
+    const vid_t* batch_dst;
+    int          batch_size;
+    bool         is_insert;
 
-    OPERATOR(Vertex& src_vertex, Vertex& dst_vertex) {
-        auto src = src_vertex.id();
-        auto dst = dst_vertex.id();
-        //atomicAdd(kd().KC + src, kd().alpha);
-        //atomicAdd(kd().new_paths_prev + src, 1);
-        //vid_t prev = atomicCAS(kd().active + src, 0, kd().iteration);
-        //if (prev == 0)
-        //    kd().active_queue.insert(src);
+    __device__ __forceinline__
+    bool contains(vid_t src, vid_t dst) const {
+        return batchContains(batch_src, batch_dst, batch_size, src, dst);
     }
-};
-//------------------------------------------------------------------------------
-struct SetupDeletions {
-    HostDeviceVar<PrDynamicData> pd;
 
-    OPERATOR(Vertex& src_vertex, Vertex& dst_vertex) {
-        //double minus_alpha = -kd().alpha;
-        auto           src = src_vertex.id();
-        auto           dst = dst_vertex.id();
-
-        //atomicAdd(kd().KC + src, minus_alpha);
-        //atomicAdd(kd().new_paths_prev + src, -1);
-        //vid_t prev = atomicCAS(kd().active + src, 0, kd().iteration);
-        //if (prev == 0)
-        //    kd().active_queue.insert(src);
+    __device__ __forceinline__
+    bool hidden(vid_t src, vid_t dst) const {
+        return !is_insert && contains(src, dst);
     }
 };
-//------------------------------------------------------------------------------
-//struct RecomputeInsertionContriUndirected {
-struct RecomputeContri {
-    HostDeviceVar<PrDynamicData> pd;
 
-    OPERATOR(Vertex& src_vertex, Vertex& dst_vertex) {
-        auto src = src_vertex.id();
-        auto dst = dst_vertex.id();
-        auto degree_src = src_vertex.degree();
-        auto degree_dst = dst_vertex.degree();
-        if (degree_dst == 0) return;
-
-        //pd().curr_pr[src]  = pd().normalized_damp +
-        //                           pd().damp * pd().curr_pr[src];
-
-        float update_diff = pd().damp*(pd().prev_pr[dst]/degree_dst);//(pr->usedOld[dst])); //@@old dst
-        float update_prop = pd().damp*(update_diff/degree_src);
-
-        atomicAdd(pd().diffPR+src,update_diff);
-        atomicAdd(pd().contri+src,update_diff); 
-
-        if(fabs(update_prop) > pd().epsilon){
-            if (pd().visited[src] == 0) {
-                //CAS: old == compare ? val : old
-                auto temp = pd().visited[src] + 1;
-                auto old = atomicCAS(pd().visited+src,0,temp);
-                if (old == 0) { 
-                    pd().queue2.insert(src);  //pr->
-                }   
-            }
-        }else{
-            atomicAdd(pd().delta+src,update_diff);
-            if ((pd().visited[src] == 0) && (pd().visitedDlt[src] == 0 )) {
-                //CAS: old == compare ? val : old
-                auto temp = pd().visitedDlt[src] + 1;
-                auto old = atomicCAS(pd().visitedDlt+src,0,temp);
-                if (old == 0) { 
-                    pd().queueDlt.insert(src); 
-                }   
-            }
-        } 
-    }
-};
+/*
+ * a vertex is enqueued (once per sweep) when its residual is above epsilon
+ */
+__device__ __forceinline__
+void activate(PrDynamicData& pd, TwoLevelQueue<vid_t>& queue, vid_t v,
+              pr_t residual) {
+    if (fabsf(residual) > pd.epsilon && pd.visited[v] != pd.sweep &&
+            atomicExch(pd.visited + v, pd.sweep) != pd.sweep)
+        queue.insert(v);
+}
 
-//------------------------------------------------------------------------------
-struct RecomputeDeletionContriUndirected {
-//TO DO
-};
 //------------------------------------------------------------------------------
 
-//struct UpdateDeltaAndMove {
-struct UpdateDltMove {
+struct InitResidual {
     HostDeviceVar<PrDynamicData> pd;
 
-    //OPERATOR(Vertex& vertex_src) {
-      OPERATOR(vid_t vertex_src) {
-        auto src = vertex_src;
-        //auto src = vertex_src.id();
-        if (pd().delta[src] > pd().epsilon)
-        {
-            if (pd().visited[src] == 0) {
-                //CAS: old == compare ? val : old
-                auto temp = pd().visited[src] + 1;
-                auto old = atomicCAS(pd().visited+src,0,temp);
-                if (old == 0) {
-                    //prType delta = pr->delta[src]; //$$pair with recomputeContributionUndirected, updateContributionsUndirected
-                    //atomicAdd(pr->contri+src,delta);
-                    pd().delta[src] = 0.0;
-                    pd().queue2.insert(src); 
-                }   
-            }
-        }
-    }
-};
-//------------------------------------------------------------------------------
-//struct UpdateContributionAndCopy {
-struct UpdateContriCopy {
-    HostDeviceVar<PrDynamicData> pd;
-#if 0
-    OPERATOR(Vertex& src) {
-        atomicAdd(pd().curr_pr + src.id(),
-                  pd().contri[src.id()]);
-    }
-#else
     OPERATOR(vid_t src) {
-        atomicAdd(pd().curr_pr + src, pd().contri[src]);
+        pd().residual[src]     = pd().normalized_damp - pd().curr_pr[src];
+        pd().prev_pr[src]      = pd().curr_pr[src];
+        pd().visited[src]      = -1;
+        pd().removed[src]      = 0;
     }
-#endif
 };
 
 //------------------------------------------------------------------------------
-//struct UpdateDeltaAndCopy {
-struct UpdateDltCopy {
-    HostDeviceVar<PrDynamicData> pd;
-#if 0
-    OPERATOR(Vertex& src) {
-        atomicAdd(pd().curr_pr + src.id(),
-                  pd().contri[src.id()]);
-    }
-#else
-    OPERATOR(vid_t src) {
-        atomicAdd(pd().curr_pr + src, pd().contri[src]);
-    }
-#endif
-};
 
-//------------------------------------------------------------------------------
-//struct UpdateContributionsUndirected {
-struct UpdateContri {
+struct AddRankContributions {
     HostDeviceVar<PrDynamicData> pd;
 
     OPERATOR(Vertex& vertex, Edge& edge) {
-        auto src = vertex.id();
-        auto dst = edge.dst_id();
-        auto dstVertex = edge.dst();
-        //auto degree_src = src.degree();
-        auto degree_src = vertex.degree();
-        //auto degree_dst = dst.degree();
-        auto degree_dst = dstVertex.degree(); //????????
- 
-        if (degree_src == 0) return;
-
-        //pd().curr_pr[src]  = pd().normalized_damp +
-        //                           pd().damp * pd().curr_pr[src];
-
-        float update_diff = pd().damp*((pd().prev_pr[src]/degree_src) - (pd().prev_pr[src]/degree_src));//(pr->usedOld[src]));
-        float update_prop = pd().damp*(update_diff/degree_dst);
-
-        //atomicAdd(pd().diffPR+src,update_diff);
-        atomicAdd(pd().contri+dst,update_diff); 
-
-        if(fabs(update_prop) > pd().epsilon){
-            if (pd().visited[dst] == 0) {
-                //CAS: old == compare ? val : old
-                auto temp = pd().visited[dst] + 1;
-                auto old = atomicCAS(pd().visited+dst,0,temp);
-                if (old == 0) { 
-                    //pr->queue2.insert(dst); 
-                    pd().queue2.insert(dst);
-                }   
-            }
-        }else{
-            atomicAdd(pd().delta+dst,update_diff);
-            if ((pd().visited[dst] == 0) && (pd().visitedDlt[dst] == 0 )) {
-                //CAS: old == compare ? val : old
-                auto temp = pd().visitedDlt[dst] + 1;
-                auto old = atomicCAS(pd().visitedDlt+dst,0,temp);
-                if (old == 0) { 
-                    pd().queueDlt.insert(dst); 
-                }   
-            }
-        } 
+        atomicAdd(pd().residual + edge.dst_id(),
+                  pd().damp * pd().curr_pr[vertex.id()] / vertex.degree());
     }
 };
-//------------------------------------------------------------------------------
-//struct RemoveContributionsUndirected {
-struct RemoveContri {
-    HostDeviceVar<PrDynamicData> pd;
-#if 0
-    OPERATOR(Vertex& src) {
-        float diffPR = pd().diffPR[src];
-        atomicAdd(pd().curr_pr + src.id(),-diffPR);
-    }
-#else
-    OPERATOR(vid_t src) {
-        float diffPR = pd().diffPR[src];
-        atomicAdd(pd().curr_pr + src, -diffPR);
-    }
-#endif
-};
-//------------------------------------------------------------------------------
-//struct PrevEqualCurr {
-struct PrevEqCurr {
-    HostDeviceVar<PrDynamicData> pd;
-#if 0
-    OPERATOR(Vertex& src) {
-        pd().prev_pr[src]  = pd().curr_pr[src];
-    }
-#else
-    OPERATOR(vid_t src) {
-        atomicAdd(pd().prev_pr + src, pd().curr_pr[src]);
-    }
-#endif
-};
+
 //------------------------------------------------------------------------------
 
-struct ResetCurr {
+struct EnqueueActive {
     HostDeviceVar<PrDynamicData> pd;
+    TwoLevelQueue<vid_t>         queue;
 
     OPERATOR(vid_t src) {
-        pd().curr_pr[src]     = 0.0f;
-        *(pd().reduction_out) = 0;
+        activate(pd(), queue, src, pd().residual[src]);
     }
 };
-//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+
 //------------------------------------------------------------------------------
 
-struct ComputeContribuitionPerVertex {
-    HostDeviceVar<PrDynamicData> pd;
-#if 1
-    OPERATOR(Vertex& vertex_src) {
-        auto degree = vertex_src.degree();
-        auto    src = vertex_src.id();
-        pd().contri[src] = degree == 0 ? 0.0f :
-                                  pd().prev_pr[src] / degree;
-    }
-#else
-    OPERATOR(vid_t vertex_src) {
-        auto degree = vertex_src.degree();
-        auto src = vertex_src;
-        atomicAdd(pd().curr_pr + src, pd().contri[src]);
+struct EnqueueBatchSources {
+    const vid_t*         batch_src;
+    TwoLevelQueue<vid_t> queue;
+
+    OPERATOR(int i) {
+        if (i == 0 || batch_src[i] != batch_src[i - 1])
+            queue.insert(batch_src[i]);
     }
-#endif
 };
 
-//------------------------------------------------------------------------------
-
-struct AddContribuitions {
+struct CountBatchEdges {
     HostDeviceVar<PrDynamicData> pd;
+    const vid_t*                 batch_src;
 
-    OPERATOR(Vertex& src, Edge& edge) {
-        atomicAdd(pd().curr_pr + edge.dst_id(),
-                  pd().contri[src.id()]);
+    OPERATOR(int i) {
+        atomicAdd(pd().removed + batch_src[i], 1);
     }
 };
 
-//------------------------------------------------------------------------------
-
-struct AddContribuitionsUndirected {
+struct CountErased {
     HostDeviceVar<PrDynamicData> pd;
+    BatchView                    view;
 
-    OPERATOR(Vertex& src_vertex, Edge& edge) {
-        atomicAdd(pd().curr_pr+ src_vertex.id(),
-                  pd().contri[edge.dst_id()]);
+    OPERATOR(Vertex& vertex, Edge& edge) {
+        if (view.contains(vertex.id(), edge.dst_id()))
+            atomicAdd(pd().removed + vertex.id(), 1);
     }
 };
 
 //------------------------------------------------------------------------------
 
-struct DampAndDiffAndCopy {
+/*
+ * the out-degree of a batch source changes from `old_degree` to
+ * `new_degree`: the share of its rank moves among the out-neighbors
+ */
+struct BatchResidual {
     HostDeviceVar<PrDynamicData> pd;
+    BatchView                    view;
+    TwoLevelQueue<vid_t>         queue;
 
-    OPERATOR(vid_t src) {
-        // pd().curr_pr[src]=(1-pd().damp)/float(pd().nV)+
-        //                          pd().damp*pd().curr_pr[src];
-        pd().curr_pr[src]  = pd().normalized_damp +
-                                   pd().damp * pd().curr_pr[src];
+    OPERATOR(Vertex& vertex, Edge& edge) {
+        vid_t    src        = vertex.id();
+        vid_t    dst        = edge.dst_id();
+        degree_t degree     = vertex.degree();
+        degree_t old_degree = view.is_insert ? degree - pd().removed[src]
+                                             : degree;
+        degree_t new_degree = view.is_insert ? degree
+                                             : degree - pd().removed[src];
+        bool is_batch = view.contains(src, dst);
+        bool in_new   = view.is_insert || !is_batch;
+        bool in_old   = !view.is_insert || !is_batch;
 
-        pd().abs_diff[src] = fabsf(pd().curr_pr[src] -
-                                         pd().prev_pr[src]);
-        pd().prev_pr[src]  = pd().curr_pr[src];
+        pr_t value = pd().damp * pd().curr_pr[src];
+        pr_t diff  = (in_new ? value / new_degree : 0.0f) -
+                     (in_old ? value / old_degree : 0.0f);
+        pr_t old   = atomicAdd(pd().residual + dst, diff);
+        activate(pd(), queue, dst, old + diff);
     }
 };
 
-//------------------------------------------------------------------------------
-
-struct Sum {
+struct ClearBatchEdges {
     HostDeviceVar<PrDynamicData> pd;
+    const vid_t*                 batch_src;
 
-    OPERATOR(vid_t src) {
-        atomicAdd(pd().reduction_out, pd().abs_diff[src]);
+    OPERATOR(int i) {
+        pd().removed[batch_src[i]] = 0;
     }
 };
 
 //------------------------------------------------------------------------------
 
-struct SumPr {
+struct PushResidual {
     HostDeviceVar<PrDynamicData> pd;
 
-    OPERATOR(vid_t src) {
-        atomicAdd(pd().reduction_out, pd().prev_pr[src] );
+    OPERATOR(Vertex& vertex) {
+        vid_t    src    = vertex.id();
+        degree_t degree = vertex.degree() - pd().removed[src];
+        pr_t     value  = pd().residual[src];
+        pd().residual[src] = 0.0f;
+        pd().curr_pr[src] += value;
+        pd().prev_pr[src]  = pd().curr_pr[src];
+        pd().delta[src]    = degree == 0 ? 0.0f : pd().damp * value / degree;
     }
 };
 
-//------------------------------------------------------------------------------
-
-struct SetIds {
-    vid_t* ids;
+struct PropagateResidual {
+    HostDeviceVar<PrDynamicData> pd;
+    BatchView                    view;
+    TwoLevelQueue<vid_t>         queue;
 
-    OPERATOR(vid_t src) {
-        ids[src] = src;
+    OPERATOR(Vertex& vertex, Edge& edge) {
+        vid_t src   = vertex.id();
+        vid_t dst   = edge.dst_id();
+        pr_t  value = pd().delta[src];
+        if (value == 0.0f || view.hidden(src, dst))
+            return;
+        pr_t old = atomicAdd(pd().residual + dst, value);
+        activate(pd(), queue, dst, old + value);
     }
 };
-//-------------------------------------------------------------------------------
-//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
-
-} // hornetAlgs namespace
 
+} // namespace pr_dynamic
+} // namespace hornets_nest
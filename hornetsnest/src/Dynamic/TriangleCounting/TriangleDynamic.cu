@@ -0,0 +1,275 @@
+/**
+ * @brief Incremental triangle counting on top of BatchUpdate
+ * @file
+ */
+#include <cuda.h>
+#include <cuda_runtime.h>
+
+#include "Dynamic/TriangleCounting/TriangleDynamic.cuh"
+
+namespace hornets_nest {
+
+using HornetDevice = HornetGraph::HornetDeviceT;
+
+TriangleCountingDynamic::TriangleCountingDynamic(HornetGraph& hornet) :
+                                       StaticAlgorithm(hornet),
+                                       load_balancing(hornet) {
+    pool.allocate(&triPerVertex, hornet.nV());
+    pool.allocate(&d_delta, 1);
+    reset();
+}
+
+TriangleCountingDynamic::~TriangleCountingDynamic() {
+    release();
+}
+
+//------------------------------------------------------------------------------
+
+/*
+ * the batch is sorted by (src, dst) after BatchUpdate::preprocess
+ */
+__device__ __forceinline__
+bool batchContains(const vid_t* __restrict__ batch_src,
+                   const vid_t* __restrict__ batch_dst,
+                   int batch_size, vid_t src, vid_t dst) {
+    int low = 0, high = batch_size;
+    while (low < high) {
+        int mid = (low + high) / 2;
+        if (batch_src[mid] < src ||
+                (batch_src[mid] == src && batch_dst[mid] < dst))
+            low = mid + 1;
+        else
+            high = mid;
+    }
+    return low < batch_size && batch_src[low] == src && batch_dst[low] == dst;
+}
+
+__device__ __forceinline__
+bool adjacencyContains(const vid_t* __restrict__ adj, degree_t length,
+                       vid_t dst) {
+    degree_t low = 0, high = length;
+    while (low < high) {
+        degree_t mid = (low + high) / 2;
+        if (adj[mid] < dst)
+            low = mid + 1;
+        else
+            high = mid;
+    }
+    return low < length && adj[low] == dst;
+}
+
+/*
+ * true if {a, b} is a batch edge smaller than the batch edge {u, v} (u < v)
+ */
+__device__ __forceinline__
+bool smallerBatchEdge(const vid_t* __restrict__ batch_src,
+                      const vid_t* __restrict__ batch_dst,
+                      int batch_size, vid_t a, vid_t b, vid_t u, vid_t v) {
+    vid_t low  = a < b ? a : b;
+    vid_t high = a < b ? b : a;
+    if (low > u || (low == u && high > v))
+        return false;
+    return batchContains(batch_src, batch_dst, batch_size, low, high);
+}
+
+struct OPERATOR_ResetTriangleCounts {
+    triangle_t* d_triPerVertex;
+
+    OPERATOR(Vertex& vertex) {
+        d_triPerVertex[vertex.id()] = 0;
+    }
+};
+
+/*
+ * Full count: every triangle u < v < w is found once from the edge (u, v)
+ */
+struct OPERATOR_OrderedIntersection {
+    HornetDevice hornet;
+    triangle_t*  d_triPerVertex;
+
+    OPERATOR(Vertex& vertex_u, Edge& edge) {
+        vid_t u = vertex_u.id();
+        vid_t v = edge.dst_id();
+        if (u >= v)
+            return;
+        auto vertex_v = hornet.vertex(v);
+        degree_t u_len = vertex_u.degree();
+        degree_t v_len = vertex_v.degree();
+        const vid_t* u_ptr = vertex_u.neighbor_ptr();
+        const vid_t* v_ptr = vertex_v.neighbor_ptr();
+
+        triangle_t count = 0;
+        degree_t iu = 0, iv = 0;
+        while (iu < u_len && iv < v_len) {
+            vid_t wu = u_ptr[iu];
+            vid_t wv = v_ptr[iv];
+            iu += (wu <= wv);
+            iv += (wv <= wu);
+            if (wu != wv || wu <= v)
+                continue;
+            atomicAdd(d_triPerVertex + wu, 1ull);
+            count++;
+        }
+        if (count == 0)
+            return;
+        atomicAdd(d_triPerVertex + u, count);
+        atomicAdd(d_triPerVertex + v, count);
+    }
+};
+
+/*
+ * One thread for each batch edge (u, v) with u < v. Every common neighbor w
+ * closes a triangle; the triangle is accounted only by the smallest of its
+ * batch edges (inclusion-exclusion over the edges of the same batch).
+ */
+struct OPERATOR_BatchEdgeIntersection {
+    HornetDevice      hornet;
+    const vid_t*      batch_src;
+    const vid_t*      batch_dst;
+    int               batch_size;
+    triangle_t*       d_triPerVertex;
+    triangle_t*       d_delta;
+    bool              is_insert;
+
+    OPERATOR(int i) {
+        vid_t u = batch_src[i];
+        vid_t v = batch_dst[i];
+        if (u >= v)
+            return;
+        auto vertex_u = hornet.vertex(u);
+        auto vertex_v = hornet.vertex(v);
+        degree_t u_len = vertex_u.degree();
+        degree_t v_len = vertex_v.degree();
+        const vid_t* u_ptr = vertex_u.neighbor_ptr();
+        const vid_t* v_ptr = vertex_v.neighbor_ptr();
+        if (!adjacencyContains(u_ptr, u_len, v))
+            return;
+
+        // triPerVertex is unsigned: erasing relies on modular arithmetic
+        triangle_t share = is_insert ? 1ull : ~0ull;
+        triangle_t count = 0;
+        degree_t iu = 0, iv = 0;
+        while (iu < u_len && iv < v_len) {
+            vid_t wu = u_ptr[iu];
+            vid_t wv = v_ptr[iv];
+            iu += (wu <= wv);
+            iv += (wv <= wu);
+            if (wu != wv || wu == u || wu == v ||
+                    smallerBatchEdge(batch_src, batch_dst, batch_size,
+                                     u, wu, u, v) ||
+                    smallerBatchEdge(batch_src, batch_dst, batch_size,
+                                     v, wu, u, v))
+                continue;
+            atomicAdd(d_triPerVertex + wu, share);
+            count++;
+        }
+        if (count == 0)
+            return;
+        atomicAdd(d_triPerVertex + u, count * share);
+        atomicAdd(d_triPerVertex + v, count * share);
+        atomicAdd(d_delta, count);
+    }
+};
+
+//------------------------------------------------------------------------------
+
+void TriangleCountingDynamic::insert(BatchUpdate& batch) {
+    update(batch, true);
+}
+
+void TriangleCountingDynamic::erase(BatchUpdate& batch) {
+    batch.sort();
+    batch.remove_batch_duplicates(false);
+    update(batch, false);
+}
+
+void TriangleCountingDynamic::update(BatchUpdate& batch, bool is_insert) {
+    int batch_size = batch.nE();
+    if (batch_size == 0)
+        return;
+    auto batch_ptr = batch.in_edge().get_soa_ptr();
+
+    gpu::memsetZero(d_delta);
+    forAll(batch_size,
+           OPERATOR_BatchEdgeIntersection { hornet.device(),
+                                            batch_ptr.template get<0>(),
+                                            batch_ptr.template get<1>(),
+                                            batch_size, triPerVertex,
+                                            d_delta, is_insert });
+    triangle_t h_delta;
+    gpu::copyToHost(d_delta, 1, &h_delta);
+    num_triangles = is_insert ? num_triangles + h_delta
+                              : num_triangles - h_delta;
+}
+
+void TriangleCountingDynamic::copyTCToHost(triangle_t* h_tcs) {
+    gpu::copyToHost(triPerVertex, hornet.nV(), h_tcs);
+}
+
+triangle_t TriangleCountingDynamic::countTriangles() const noexcept {
+    return num_triangles;
+}
+
+//------------------------------------------------------------------------------
+
+void TriangleCountingDynamic::reset() {
+    forAllVertices(hornet, OPERATOR_ResetTriangleCounts { triPerVertex });
+    num_triangles = 0;
+}
+
+void TriangleCountingDynamic::run() {
+    reset();
+    forAllEdges(hornet, OPERATOR_OrderedIntersection { hornet.device(),
+                                                       triPerVertex },
+                load_balancing);
+
+    triangle_t* h_triPerVertex;
+    host::allocate(h_triPerVertex, hornet.nV());
+    copyTCToHost(h_triPerVertex);
+    triangle_t sum = 0;
+    for (vid_t v = 0; v < hornet.nV(); v++)
+        sum += h_triPerVertex[v];
+    host::free(h_triPerVertex);
+    num_triangles = sum / 3;
+}
+
+void TriangleCountingDynamic::release() {
+    triPerVertex = nullptr;
+    d_delta      = nullptr;
+}
+
+/*
+ * Compares the maintained counts against a full recount and the global count
+ * against TriangleCounting2
+ */
+bool TriangleCountingDynamic::validate() {
+    triangle_t* h_dynamic;
+    triangle_t* h_static;
+    host::allocate(h_dynamic, hornet.nV());
+    host::allocate(h_static, hornet.nV());
+    copyTCToHost(h_dynamic);
+    triangle_t dynamic_triangles = num_triangles;
+
+    run();
+    copyTCToHost(h_static);
+
+    TriangleCounting2 static_tc(hornet);
+    static_tc.init();
+    static_tc.run(1);
+
+    bool is_correct = dynamic_triangles == num_triangles &&
+                      num_triangles == static_tc.countTriangles() / 6;
+    for (vid_t v = 0; v < hornet.nV(); v++) {
+        if (h_static[v] != h_dynamic[v]) {
+            std::cout << "vertex " << v << "  static: " << h_static[v]
+                      << "  dynamic: " << h_dynamic[v] << "\n";
+            is_correct = false;
+            break;
+        }
+    }
+    host::free(h_dynamic);
+    host::free(h_static);
+    return is_correct;
+}
+
+} // namespace hornets_nest
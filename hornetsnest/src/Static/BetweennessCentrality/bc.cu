@@ -55,13 +55,14 @@ BCCentrality::BCCentrality(HornetGraph& hornet) :
 {
     cout << "hornet.nV   " << hornet.nV() << endl;
 
-    host::allocate(hd_BCData().depth_indices, hornet.nV());
+    host::allocate(hd_BCData().depth_indices, hornet.nV() + 1);
     pool.allocate(&hd_BCData().d, hornet.nV());
+    pool.allocate(&depArray, hornet.nV());
 
     pool.allocate(&hd_BCData().sigma, hornet.nV());
     pool.allocate(&hd_BCData().delta, hornet.nV());
     pool.allocate(&hd_BCData().bc, hornet.nV());
-    hd_BCData().queue.initialize(hornet);
+    hd_BCData().frontier.initialize(hornet);
 
     reset();
 }
@@ -86,59 +87,47 @@ void BCCentrality::setRoot(vid_t root_){
 
 void BCCentrality::run() {
 
-
     // Initialization
     hd_BCData().currLevel=0;
     forAllnumV(hornet, InitOneTree { hd_BCData });
     vid_t root = hd_BCData().root;
 
-    hd_BCData().queue.insert(root);                   // insert source in the frontier
+    hd_BCData().frontier.insert(root);                // insert source in the frontier
     forAll(1,  InitRootData { hd_BCData });
 
     // Regular BFS
-    hd_BCData().depth_indices[0]=1;
-
-    vid_t* depArray;
-    pool.allocate(&depArray, hornet.nV());
-
-
-    cudaMemcpy(depArray,hd_BCData().queue.device_input_ptr(),sizeof(vid_t)*hd_BCData().queue.size(),cudaMemcpyDeviceToDevice);
-
-    while (hd_BCData().queue.size() > 0) {
+    // the vertices of level i are depArray[depth_indices[i], depth_indices[i+1])
+    hd_BCData().depth_indices[0]=0;
 
-        if(hd_BCData().currLevel>0) {
-            length_t prevLength = hd_BCData().depth_indices[hd_BCData().currLevel] - 
-                                  hd_BCData().depth_indices[hd_BCData().currLevel-1];
+    while (hd_BCData().frontier.size() > 0) {
+        degree_t level = hd_BCData().currLevel;
+        hd_BCData().depth_indices[level+1]=
+                       hd_BCData().depth_indices[level]+hd_BCData().frontier.size();
+        cudaMemcpy(depArray+hd_BCData().depth_indices[level],
+                   hd_BCData().frontier.device_input_ptr(),
+                   sizeof(vid_t)*hd_BCData().frontier.size(), cudaMemcpyDeviceToDevice);
 
-            cudaMemcpy(depArray+hd_BCData().depth_indices[hd_BCData().currLevel-1],
-                       hd_BCData().queue.device_input_ptr(),
-                       sizeof(vid_t)*(prevLength), cudaMemcpyDeviceToDevice);
-        }
-
-
-        forAllEdges(hornet, hd_BCData().queue, BC_BFSTopDown { hd_BCData }, load_balancing);
-        hd_BCData().queue.swap();
-        hd_BCData().depth_indices[hd_BCData().currLevel+1]=
-                       hd_BCData().depth_indices[hd_BCData().currLevel]+hd_BCData().queue.size();
+        forAllEdges(hornet, hd_BCData().frontier, BC_BFSTopDown { hd_BCData }, load_balancing);
+        hd_BCData().frontier.swap();
 
         hd_BCData().currLevel++;
     }
 
-    hd_BCData().currLevel -= 2;
-
-    vid_t deepest = hd_BCData().currLevel-1;
+    vid_t visited = hd_BCData().depth_indices[hd_BCData().currLevel];
 
     // Reverse BFS - Dependency accumulation
+    // the deepest level has no successors
+    hd_BCData().currLevel -= 2;
     while (hd_BCData().currLevel>0) {
-        length_t prevLength = hd_BCData().depth_indices[hd_BCData().currLevel+1] - 
-                              hd_BCData().depth_indices[hd_BCData().currLevel];
-        forAllEdges(hornet, depArray+hd_BCData().depth_indices[hd_BCData().currLevel] ,prevLength, 
+        degree_t level = hd_BCData().currLevel;
+        length_t levelLength = hd_BCData().depth_indices[level+1] -
+                               hd_BCData().depth_indices[level];
+        forAllEdges(hornet, depArray+hd_BCData().depth_indices[level], levelLength,
                     BC_DepAccumulation { hd_BCData }, load_balancing);
         hd_BCData().currLevel--;
     }
 
-    if(deepest>0)
-        forAllVertices(hornet, depArray, hd_BCData().depth_indices[deepest],IncrementBCNew { hd_BCData });
+    forAllVertices(hornet, depArray, visited, IncrementBCNew { hd_BCData });
 
 }
 
@@ -159,4 +148,20 @@ bc_t* BCCentrality::getDeltas() {
     return  bc_data().delta;
 }
 
+bc_t BCCentrality::topN(int N, vid_t* h_ids) {
+    TopK<bc_t> top_k(hornet.nV());
+    thrust::device_vector<vid_t> d_ids(N);
+    bc_t threshold = top_k.select(hd_BCData().bc, (const vid_t*) nullptr,
+                                  hornet.nV(), N, d_ids.data().get());
+
+    bc_t* h_bc;
+    host::allocate(h_bc, hornet.nV());
+    gpu::copyToHost(hd_BCData().bc, hornet.nV(), h_bc);
+    gpu::copyToHost(d_ids.data().get(), N, h_ids);
+    std::sort(h_ids, h_ids + N,
+              [&](vid_t a, vid_t b) { return h_bc[a] > h_bc[b]; });
+    host::free(h_bc);
+    return threshold;
+}
+
 } // namespace hornets_nest
@@ -89,7 +89,7 @@ struct BC_BFSTopDown {
 
         degree_t prev = atomicCAS(bcd().d + w, INT32_MAX, nextLevel);
         if (prev == INT32_MAX) {
-            bcd().queue.insert(w);
+            bcd().frontier.insert(w);
         }
         if (bcd().d[w] == nextLevel) {
             atomicAdd(bcd().sigma + w, bcd().sigma[v]);
@@ -0,0 +1,97 @@
+/*
+ * Copyright (c) 2019, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "Static/BetweennessCentrality/multi_source_bc.cuh"
+#include <omp.h>
+
+namespace hornets_nest {
+namespace host {
+
+MultiSourceBC::MultiSourceBC(const eoff_t* offsets_, const vid_t* edges_,
+                             vid_t nV_, const vid_t* roots_, int num_roots) :
+                                offsets(offsets_),
+                                edges(edges_),
+                                nV(nV_),
+                                roots(roots_, roots_ + num_roots),
+                                bc(nV_, 0) {}
+
+void MultiSourceBC::reset() {
+    std::fill(bc.begin(), bc.end(), 0);
+}
+
+void MultiSourceBC::run() {
+    int num_roots = static_cast<int>(roots.size());
+
+    #pragma omp parallel
+    {
+        std::vector<int>     depth(nV, -1);
+        std::vector<paths_t> sigma(nV, 0);
+        std::vector<bc_t>    delta(nV, 0);
+        std::vector<bc_t>    local_bc(nV, 0);
+        std::vector<vid_t>   order;
+        order.reserve(nV);
+
+        #pragma omp for schedule(dynamic)
+        for (int i = 0; i < num_roots; i++) {
+            vid_t root = roots[i];
+            order.clear();
+            order.push_back(root);
+            depth[root] = 0;
+            sigma[root] = 1;
+            //the BFS order is also the queue
+            for (size_t head = 0; head < order.size(); head++) {
+                vid_t v = order[head];
+                for (eoff_t j = offsets[v]; j < offsets[v + 1]; j++) {
+                    vid_t w = edges[j];
+                    if (depth[w] == -1) {
+                        depth[w] = depth[v] + 1;
+                        order.push_back(w);
+                    }
+                    if (depth[w] == depth[v] + 1)
+                        sigma[w] += sigma[v];
+                }
+            }
+            for (auto it = order.rbegin(); it != order.rend(); ++it) {
+                vid_t v = *it;
+                for (eoff_t j = offsets[v]; j < offsets[v + 1]; j++) {
+                    vid_t w = edges[j];
+                    if (depth[w] == depth[v] + 1) {
+                        delta[v] += static_cast<bc_t>(sigma[v]) /
+                                    static_cast<bc_t>(sigma[w]) *
+                                    (1.0 + delta[w]);
+                    }
+                }
+                if (v != root)
+                    local_bc[v] += delta[v];
+            }
+            //only the visited vertices are restored
+            for (auto v : order) {
+                depth[v] = -1;
+                sigma[v] = 0;
+                delta[v] = 0;
+            }
+        }
+        #pragma omp critical
+        for (vid_t v = 0; v < nV; v++)
+            bc[v] += local_bc[v];
+    }
+}
+
+const bc_t* MultiSourceBC::getBCScores() const {
+    return bc.data();
+}
+
+} // namespace host
+} // namespace hornets_nest
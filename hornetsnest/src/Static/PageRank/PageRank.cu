@@ -136,22 +136,33 @@ void StaticPageRank::run() {
 }
 
 
-void StaticPageRank::printRankings() {
-    pr_t*  d_scores, *h_scores;
-    vid_t* d_ids, *h_ids;
-    pool.allocate(&d_scores,  hornet.nV());
-    pool.allocate(&d_ids,     hornet.nV());
+pr_t StaticPageRank::topN(int N, vid_t* h_ids) {
+    TopK<pr_t> top_k(hornet.nV());
+    thrust::device_vector<vid_t> d_ids(N);
+    pr_t threshold = top_k.select(hd_prdata().curr_pr, (const vid_t*) nullptr,
+                                  hornet.nV(), N, d_ids.data().get());
+
+    pr_t* h_scores;
     host::allocate(h_scores, hornet.nV());
-    host::allocate(h_ids,    hornet.nV());
+    host::copyFromDevice(hd_prdata().curr_pr, hornet.nV(), h_scores);
+    host::copyFromDevice(d_ids.data().get(), N, h_ids);
+    std::sort(h_ids, h_ids + N,
+              [&](vid_t a, vid_t b) { return h_scores[a] > h_scores[b]; });
+    host::free(h_scores);
+    return threshold;
+}
 
-    gpu::copyToDevice(hd_prdata().curr_pr, hornet.nV(), d_scores);
-	forAllnumV(hornet, SetIds { d_ids });
+void StaticPageRank::printRankings() {
+    const int N = std::min(10, hornet.nV());
+    vid_t  h_ids[10];
+    pr_t*  h_scores;
+    host::allocate(h_scores, hornet.nV());
 
-    host::copyFromDevice(d_scores, hornet.nV(), h_scores);
-    host::copyFromDevice(d_ids,    hornet.nV(), h_ids);
+    topN(N, h_ids);
+    host::copyFromDevice(hd_prdata().curr_pr, hornet.nV(), h_scores);
 
-	for (int i = 0; i < 10; i++)
-        std::cout << "Pr[" << h_ids[i] << "]:= " <<  h_scores[i] << "\n";
+	for (int i = 0; i < N; i++)
+        std::cout << "Pr[" << h_ids[i] << "]:= " <<  h_scores[h_ids[i]] << "\n";
     std::cout << std::endl;
 
 	forAllnumV(hornet, ResetCurr { hd_prdata });
@@ -162,7 +173,6 @@ void StaticPageRank::printRankings() {
 	std::cout << "              " << std::setprecision(9) << h_out << std::endl;
 
 	host::free(h_scores);
-	host::free(h_ids);
 }
 
 const pr_t* StaticPageRank::get_page_rank_score_host() {
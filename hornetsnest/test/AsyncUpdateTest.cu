@@ -0,0 +1,134 @@
+/**
+ * @brief Asynchronous graph update test program
+ * @file
+ */
+#include "TestGraph.cuh"
+#include <Core/UpdatePipeline.hpp>
+#include <Device/Util/Timer.cuh>
+#include <Graph/GraphStd.hpp>
+#include <Util/BatchFunctions.hpp>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
+
+using namespace timer;
+using namespace hornets_nest;
+
+using HornetGraph = ::hornet::gpu::Hornet<vid_t>;
+using HornetInit  = ::hornet::HornetInit<vid_t>;
+using BatchUpdate = ::hornet::gpu::BatchUpdate<vid_t>;
+using UpdatePtr   = ::hornet::BatchUpdatePtr<vid_t, ::hornet::EMPTY,
+                                             ::hornet::DeviceType::HOST>;
+
+/*
+ * host only: the stages of consecutive updates overlap, the updates are
+ * applied in submission order and wait() is a consistency point
+ */
+bool checkPipelineOrder() {
+    const int NUM_UPDATES = 32;
+    std::vector<int>  applied;
+    std::atomic<bool> is_applying { false };
+    std::atomic<int>  num_overlaps { 0 };
+    std::vector<std::shared_future<size_t>> futures;
+
+    hornet::UpdatePipeline pipeline;
+    for (int i = 0; i < NUM_UPDATES; i++) {
+        futures.push_back(pipeline.submit(
+            [&]() {
+                num_overlaps += is_applying;
+                std::this_thread::sleep_for(std::chrono::microseconds(100));
+            },
+            [&, i]() {
+                is_applying = true;
+                std::this_thread::sleep_for(std::chrono::microseconds(300));
+                applied.push_back(i);
+                is_applying = false;
+                return static_cast<size_t>(i);
+            }));
+    }
+    pipeline.wait();
+    bool is_correct = pipeline.pending() == 0 &&
+                      static_cast<int>(applied.size()) == NUM_UPDATES;
+    for (int i = 0; i < NUM_UPDATES; i++) {
+        is_correct &= applied[i] == i &&
+                      futures[i].get() == static_cast<size_t>(i);
+    }
+    std::cout << "pipeline  overlapped prepare stages: " << num_overlaps
+              << "/" << NUM_UPDATES << "\n";
+    return is_correct;
+}
+
+int exec(int argc, char* argv[]) {
+    using namespace graph::parsing_prop;
+
+    graph::GraphStd<vid_t, eoff_t> graph;
+    graph.read(argv[1], PRINT_INFO | SORT);
+    int batch_size  = argc > 2 ? std::stoi(argv[2]) : 100000;
+    int num_batches = argc > 3 ? std::stoi(argv[3]) : 8;
+
+    HornetInit hornet_init(graph.nV(), graph.nE(), graph.csr_out_offsets(),
+                           graph.csr_out_edges());
+    HornetGraph sync_graph(hornet_init);
+    HornetGraph async_graph(hornet_init);
+
+    std::vector<std::vector<vid_t>> batch_src(num_batches);
+    std::vector<std::vector<vid_t>> batch_dst(num_batches);
+    std::vector<int>                sizes(num_batches, batch_size);
+    for (int i = 0; i < num_batches; i++) {
+        batch_src[i].resize(batch_size);
+        batch_dst[i].resize(batch_size);
+        generateBatch(graph, sizes[i], batch_src[i].data(),
+                      batch_dst[i].data(), BatchGenType::INSERT);
+    }
+
+    Timer<HOST> TM;
+    TM.start();
+    for (int i = 0; i < num_batches; i++) {
+        BatchUpdate batch(UpdatePtr(sizes[i], batch_src[i].data(),
+                                    batch_dst[i].data()));
+        sync_graph.insert(batch, true, true);
+    }
+    TM.stop();
+    TM.print("synchronous insert");
+
+    //batch i + 1 is copied to the device while batch i is applied
+    std::vector<std::unique_ptr<BatchUpdate>> batches;
+    std::shared_future<size_t> last_update;
+    TM.start();
+    for (int i = 0; i < num_batches; i++) {
+        batches.emplace_back(new BatchUpdate(UpdatePtr(sizes[i],
+                             batch_src[i].data(), batch_dst[i].data())));
+        last_update = async_graph.insert_async(*batches.back(), 0, true, true);
+    }
+    async_graph.wait_updates();
+    TM.stop();
+    TM.print("asynchronous insert");
+
+    bool is_correct = checkPipelineOrder();
+    is_correct &= async_graph.pending_updates() == 0 &&
+                  last_update.get() == async_graph.version();
+    is_correct &= async_graph.nE() == sync_graph.nE() &&
+                  getDegrees(async_graph) == getDegrees(sync_graph);
+
+    //a synchronous update waits for the pending asynchronous ones
+    BatchUpdate async_erase(UpdatePtr(sizes[0], batch_src[0].data(),
+                                      batch_dst[0].data()));
+    BatchUpdate sync_erase(UpdatePtr(sizes[1], batch_src[1].data(),
+                                     batch_dst[1].data()));
+    async_graph.erase_async(async_erase, 0, true);
+    async_graph.erase(sync_erase, true);
+    is_correct &= async_graph.pending_updates() == 0;
+
+    std::cout << (is_correct ? "PASSED" : "NOT PASSED") << std::endl;
+    return !is_correct;
+}
+
+int main(int argc, char* argv[]) {
+    int ret = 0;
+    {
+        ret = exec(argc, argv);
+    }
+    return ret;
+}
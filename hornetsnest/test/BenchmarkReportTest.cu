@@ -0,0 +1,102 @@
+/**
+ * @brief Benchmark report test program
+ * @file
+ */
+#include <Util/BenchmarkReport.hpp>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <vector>
+
+using namespace hornets_nest;
+
+BenchmarkResult makeResult(const char* graph, const char* algorithm,
+                           float median_ms) {
+    BenchmarkResult r;
+    r.graph       = graph;
+    r.algorithm   = algorithm;
+    r.backend     = "gpu";
+    r.nV          = 100;
+    r.nE          = 2000;
+    r.repetitions = 5;
+    r.median_ms   = median_ms;
+    r.p95_ms      = median_ms * 2;
+    r.min_ms      = median_ms / 2;
+    r.max_ms      = median_ms * 4;
+    r.mteps       = 0.5;
+    r.peak_memory = 1 << 20;
+    return r;
+}
+
+bool operator==(const BenchmarkResult& a, const BenchmarkResult& b) {
+    return a.graph == b.graph && a.algorithm == b.algorithm &&
+           a.backend == b.backend && a.nV == b.nV && a.nE == b.nE &&
+           a.repetitions == b.repetitions && a.median_ms == b.median_ms &&
+           a.p95_ms == b.p95_ms && a.min_ms == b.min_ms &&
+           a.max_ms == b.max_ms && a.mteps == b.mteps &&
+           a.peak_memory == b.peak_memory;
+}
+
+int exec(int argc, char* argv[]) {
+    //nearest rank: the smallest value with at least p of the values below
+    std::vector<float> one_to_twenty(20);
+    for (int i = 0; i < 20; i++)
+        one_to_twenty[i] = i + 1;
+    bool is_correct = percentile(one_to_twenty, 0.5)  == 10 &&
+                      percentile(one_to_twenty, 0.95) == 19 &&
+                      percentile(one_to_twenty, 0.99) == 20 &&
+                      percentile(one_to_twenty, 0.0)  == 1 &&
+                      percentile(one_to_twenty, 1.0)  == 20 &&
+                      percentile({ 7 }, 0.95) == 7;
+
+    //the times are sorted by summarize
+    BenchmarkResult summary;
+    summary.nE = 3000;
+    summarize({ 5, 1, 4, 2, 3 }, summary);
+    is_correct &= summary.repetitions == 5 && summary.median_ms == 3 &&
+                  summary.p95_ms == 5 && summary.min_ms == 1 &&
+                  summary.max_ms == 5 && summary.mteps == 1.0;
+    //even count: mean of the two middle times
+    summarize({ 4, 1, 3, 2 }, summary);
+    is_correct &= summary.repetitions == 4 && summary.median_ms == 2.5f &&
+                  summary.p95_ms == 4;
+
+    //round trip of the baseline format, the commas and quotes are escaped
+    std::vector<BenchmarkResult> results = {
+        makeResult("road.mtx", "pagerank", 1.5f),
+        makeResult("web.mtx",  "katz",     12.25f),
+        makeResult("a,\"b\".mtx", "bc",     3) };
+    const char* filename = "benchmark_report_test.csv";
+    {
+        std::ofstream fout(filename);
+        writeCSV(fout, results);
+    }
+    auto read = readCSV(filename);
+    std::remove(filename);
+    is_correct &= read.size() == results.size() &&
+                  read[0] == results[0] && read[1] == results[1] &&
+                  read[2] == results[2];
+
+    //the threshold is exclusive: 12.5 ms over 10 ms is not a regression
+    std::vector<BenchmarkResult> baseline = {
+        makeResult("g", "a", 10), makeResult("g", "b", 10) };
+    std::vector<BenchmarkResult> current  = {
+        makeResult("g", "a", 12.5f), makeResult("g", "b", 12.75f),
+        makeResult("g", "c", 100) };
+    auto regressions = findRegressions(current, baseline, 0.25);
+    is_correct &= regressions.size() == 1 &&
+                  regressions[0].current.algorithm == "b" &&
+                  regressions[0].baseline_ms == 10 &&
+                  regressions[0].slowdown > 1.25;
+
+    std::cout << (is_correct ? "PASSED" : "NOT PASSED") << std::endl;
+    return !is_correct;
+}
+
+int main(int argc, char* argv[]) {
+    int ret = 0;
+    {
+        ret = exec(argc, argv);
+    }
+    return ret;
+}
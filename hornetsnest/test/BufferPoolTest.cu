@@ -0,0 +1,83 @@
+/**
+ * @brief BufferPool arena test program
+ * @file
+ */
+#include "BufferPool.cuh"
+#include <cstdint>
+#include <iostream>
+#include <utility>
+
+template<typename Pool>
+bool check_pool(const char* name) {
+    Pool pool(1 << 16);
+    bool is_correct = true;
+
+    //same allocations at every "run": the reserved memory must not grow
+    size_t reserved = 0;
+    float* first    = nullptr;
+    for (int run = 0; run < 10; run++) {
+        auto mark = pool.mark();
+        float*  small;
+        int*    other;
+        double* large;
+        pool.allocate(&small, 1000);
+        pool.allocate(&other, 3);
+        pool.allocate(&large, 1 << 16);
+        is_correct &= reinterpret_cast<std::uintptr_t>(small) % 256 == 0 &&
+                      reinterpret_cast<std::uintptr_t>(other) % 256 == 0 &&
+                      reinterpret_cast<std::uintptr_t>(large) % 256 == 0;
+        if (run == 0) {
+            reserved = pool.bytes_reserved();
+            first    = small;
+        }
+        is_correct &= pool.bytes_reserved() == reserved && small == first;
+        pool.release_to(mark);
+        is_correct &= pool.bytes_in_use() == 0;
+    }
+    size_t peak = pool.high_water_mark();
+
+    //nested releases give back only the inner buffers
+    int* bottom;
+    int* top;
+    pool.allocate(&bottom, 100);
+    auto mark = pool.mark();
+    pool.allocate(&top, 100);
+    {
+        typename Pool::Scope scope(pool);
+        int* tmp;
+        pool.allocate(&tmp, 5000);
+        is_correct &= pool.bytes_in_use() > 0;
+    }
+    pool.release_to(mark);
+    int* again;
+    pool.allocate(&again, 100);
+    is_correct &= again == top && bottom != top;
+
+    //the buffers move with the slabs, the moved-from pool is empty
+    Pool moved(std::move(pool));
+    is_correct &= pool.bytes_in_use() == 0 && pool.bytes_reserved() == 0 &&
+                  pool.mark() == 0 && moved.bytes_reserved() == reserved;
+    moved.release_to(mark);
+    moved.allocate(&again, 100);
+    is_correct &= again == top;
+    pool = std::move(moved);
+    is_correct &= moved.bytes_reserved() == 0 &&
+                  pool.bytes_reserved() == reserved;
+    pool.clear();
+
+    is_correct &= pool.high_water_mark() == peak &&
+                  pool.bytes_reserved() == reserved;
+    pool.shrink_to_fit();
+    is_correct &= pool.bytes_reserved() == 0;
+
+    std::cout << name << " reserved: " << reserved
+              << " high water mark: " << peak << "\n";
+    return is_correct;
+}
+
+int main() {
+    bool is_correct = check_pool<HostBufferPool>("Host") &&
+                      check_pool<BufferPool>("Device");
+    std::cout << (is_correct ? "PASSED" : "NOT PASSED") << std::endl;
+    return !is_correct;
+}
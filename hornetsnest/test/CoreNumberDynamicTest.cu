@@ -0,0 +1,71 @@
+/**
+ * @brief Dynamic CoreNumber test program
+ * @file
+ */
+
+#include "Dynamic/CoreNumber/CoreNumberDynamic.cuh"
+#include "TestGraph.cuh"
+#include <Device/Util/Timer.cuh>
+
+using namespace timer;
+using namespace hornets_nest;
+
+using HostUpdatePtr = ::hornet::BatchUpdatePtr<vert_t, hornet::EMPTY,
+                                               hornet::DeviceType::HOST>;
+
+int exec(int argc, char **argv) {
+    using namespace graph::structure_prop;
+    using namespace graph::parsing_prop;
+
+    graph::GraphStd<vert_t, eoff_t> graph(UNDIRECTED);
+    graph.read(argv[1], SORT);
+    int batch_size  = argc > 2 ? std::stoi(argv[2]) : 100;
+    int num_batches = argc > 3 ? std::stoi(argv[3]) : 10;
+
+    HornetInit hornet_init(graph.nV(), graph.nE(), graph.csr_out_offsets(),
+                           graph.csr_out_edges());
+
+    HornetDynamicGraph hornet_graph(hornet_init);
+    thrust::device_vector<int> core_number(graph.nV());
+    CoreNumberDynamic kcore(hornet_graph, core_number.data().get());
+    kcore.run();
+
+    std::vector<vert_t> batch_src, batch_dst;
+    Timer<DEVICE> TM;
+    bool is_correct = true;
+    for (int i = 0; i < num_batches && is_correct; i++) {
+        bool is_insert = (i % 2 == 0);
+        symmetricBatch(graph, batch_size,
+                       is_insert ? BatchGenType::INSERT : BatchGenType::REMOVE,
+                       batch_src, batch_dst);
+        Update batch(HostUpdatePtr(batch_src.size(), batch_src.data(),
+                                   batch_dst.data()));
+        TM.start();
+        if (is_insert) {
+            hornet_graph.insert(batch, true, true);
+            kcore.insert(batch);
+        } else {
+            kcore.erase(batch);
+            hornet_graph.erase(batch);
+        }
+        TM.stop();
+        std::cout << (is_insert ? "insert" : "erase ") << " batch " << i
+                  << "  visited vertices: " << kcore.visited_vertices()
+                  << "  ";
+        TM.print("time:");
+        is_correct = kcore.validate();
+    }
+    std::cout << (is_correct ? "PASSED" : "NOT PASSED") << std::endl;
+    return !is_correct;
+}
+
+int main(int argc, char* argv[]) {
+  int ret = 0;
+  {
+
+    ret = exec(argc, argv);
+
+  }
+
+  return ret;
+}
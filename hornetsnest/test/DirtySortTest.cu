@@ -0,0 +1,144 @@
+/**
+ * @brief Incremental adjacency list sort test program
+ * @file
+ */
+#include "HornetAlg.hpp"
+#include <Core/DirtyVertexSet.cuh>
+#include <Device/Util/Timer.cuh>
+#include <Graph/GraphStd.hpp>
+#include <Util/BatchFunctions.hpp>
+#include <vector>
+
+using namespace timer;
+using namespace hornets_nest;
+
+using HornetGraph = ::hornet::gpu::Hornet<vid_t>;
+using HornetInit  = ::hornet::HornetInit<vid_t>;
+using BatchUpdate = ::hornet::gpu::BatchUpdate<vid_t>;
+using UpdatePtr   = ::hornet::BatchUpdatePtr<vid_t, ::hornet::EMPTY,
+                                             ::hornet::DeviceType::HOST>;
+
+//order-independent checksum of every adjacency list, 0 if not sorted
+struct SortedChecksum {
+    unsigned long long* d_checksums;
+
+    OPERATOR(Vertex& vertex) {
+        unsigned long long checksum = 1;
+        for (degree_t i = 0; i < vertex.degree(); i++) {
+            unsigned long long dst = vertex.edge(i).dst_id();
+            if (i > 0 && vertex.edge(i - 1).dst_id() > dst) {
+                checksum = 0;
+                break;
+            }
+            checksum += dst * dst + 1;
+        }
+        d_checksums[vertex.id()] = checksum;
+    }
+};
+
+struct EdgeChecksum {
+    unsigned long long* d_checksums;
+
+    OPERATOR(Vertex& vertex, Edge& edge) {
+        unsigned long long dst = edge.dst_id();
+        atomicAdd(d_checksums + vertex.id(), dst * dst + 1);
+    }
+};
+
+std::vector<unsigned long long> getSortedChecksums(HornetGraph& hornet) {
+    thrust::device_vector<unsigned long long> d_checksums(hornet.nV());
+    forAllVertices(hornet, SortedChecksum { d_checksums.data().get() });
+    std::vector<unsigned long long> h_checksums(hornet.nV());
+    thrust::copy(d_checksums.begin(), d_checksums.end(), h_checksums.begin());
+    return h_checksums;
+}
+
+std::vector<unsigned long long> getChecksums(HornetGraph& hornet) {
+    thrust::device_vector<unsigned long long> d_checksums(hornet.nV(), 1);
+    forAllEdges(hornet, EdgeChecksum { d_checksums.data().get() },
+                load_balancing::BinarySearch(hornet));
+    std::vector<unsigned long long> h_checksums(hornet.nV());
+    thrust::copy(d_checksums.begin(), d_checksums.end(), h_checksums.begin());
+    return h_checksums;
+}
+
+bool testHostDirtySet() {
+    ::hornet::DirtyVertexSet<vid_t, ::hornet::DeviceType::HOST> dirty_set;
+    bool is_correct = dirty_set.is_all();
+    dirty_set.clear();
+    is_correct &= dirty_set.empty();
+    std::vector<vid_t> ids { 7, 2, 7, 4 };
+    dirty_set.mark(ids.data(), ids.size(), 8);
+    auto marked = dirty_set.compact(5);
+    is_correct &= !dirty_set.empty() && marked.size() == 2 &&
+                  marked[0] == 2 && marked[1] == 4;
+    dirty_set.clear();
+    is_correct &= dirty_set.empty() && dirty_set.compact(8).size() == 0;
+    return is_correct;
+}
+
+int exec(int argc, char* argv[]) {
+    using namespace graph::parsing_prop;
+
+    graph::GraphStd<vid_t, eoff_t> graph;
+    graph.read(argv[1], PRINT_INFO);
+    int batch_size = argc > 2 ? std::stoi(argv[2]) : 100000;
+
+    HornetInit hornet_init(graph.nV(), graph.nE(), graph.csr_out_offsets(),
+                           graph.csr_out_edges());
+    HornetGraph hornet_graph(hornet_init);
+    HornetGraph reference(hornet_init);
+
+    Timer<DEVICE> TM;
+    TM.start();
+    hornet_graph.sort();
+    TM.stop();
+    TM.print("full sort");
+
+    int erase_size  = batch_size;
+    int insert_size = batch_size;
+    std::vector<vid_t> erase_src(batch_size), erase_dst(batch_size);
+    std::vector<vid_t> insert_src(batch_size), insert_dst(batch_size);
+    generateBatch(graph, erase_size, erase_src.data(), erase_dst.data(),
+                  BatchGenType::REMOVE);
+    generateBatch(graph, insert_size, insert_src.data(), insert_dst.data(),
+                  BatchGenType::INSERT);
+
+    for (auto* hornet : { &hornet_graph, &reference }) {
+        BatchUpdate erase_batch(UpdatePtr(erase_size, erase_src.data(),
+                                          erase_dst.data()));
+        BatchUpdate insert_batch(UpdatePtr(insert_size, insert_src.data(),
+                                           insert_dst.data()));
+        hornet->erase(erase_batch, true);
+        hornet->insert(insert_batch, true, true);
+    }
+
+    //only the updated adjacency lists are sorted
+    TM.start();
+    hornet_graph.sort();
+    TM.stop();
+    TM.print("incremental sort");
+
+    auto sorted_checksums = getSortedChecksums(hornet_graph);
+    bool is_correct = hornet_graph.nE() == reference.nE() &&
+                      sorted_checksums == getChecksums(reference);
+
+    //nothing changed: no work
+    TM.start();
+    hornet_graph.sort();
+    TM.stop();
+    TM.print("clean sort");
+    is_correct &= getSortedChecksums(hornet_graph) == sorted_checksums;
+    is_correct &= testHostDirtySet();
+
+    std::cout << (is_correct ? "PASSED" : "NOT PASSED") << std::endl;
+    return !is_correct;
+}
+
+int main(int argc, char* argv[]) {
+    int ret = 0;
+    {
+        ret = exec(argc, argv);
+    }
+    return ret;
+}
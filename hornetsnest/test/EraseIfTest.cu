@@ -0,0 +1,109 @@
+/**
+ * @brief Predicate-based edge erasure test program
+ * @file
+ */
+#include "TestGraph.cuh"
+#include <tuple>
+#include <vector>
+
+using namespace hornets_nest;
+
+using weight_t    = float;
+using HornetGraph = ::hornet::gpu::Hornet<vid_t, ::hornet::EMPTY,
+                                          ::hornet::TypeList<weight_t>>;
+using HornetInit  = ::hornet::HornetInit<vid_t, ::hornet::EMPTY,
+                                         ::hornet::TypeList<weight_t>>;
+using HostGraph   = ::hornet::host::HostGraph<vid_t,
+                                              ::hornet::TypeList<weight_t>>;
+using HostEdge    = HostGraph::EdgeT;
+
+struct SelfLoop {
+    template <typename Vertex, typename Edge>
+    __device__ __forceinline__
+    bool operator()(Vertex& vertex, Edge& edge) const {
+        return vertex.id() == edge.dst_id();
+    }
+};
+
+struct LowWeight {
+    weight_t threshold;
+
+    template <typename Vertex, typename Edge>
+    __device__ __forceinline__
+    bool operator()(Vertex& vertex, Edge& edge) const {
+        return edge.template field<0>() < threshold;
+    }
+};
+
+struct BannedVertex {
+    const bool* d_banned;
+
+    template <typename Vertex, typename Edge>
+    __device__ __forceinline__
+    bool operator()(Vertex& vertex, Edge& edge) const {
+        return d_banned[vertex.id()] || d_banned[edge.dst_id()];
+    }
+};
+
+int exec(int argc, char* argv[]) {
+    const vid_t nV = 256;
+    std::vector<degree_t> offsets;
+    std::vector<vid_t>    edges;
+    std::vector<weight_t> weights;
+    //no shift: the first edge of every vertex is a self-loop
+    skewedGraph(nV, 37, 0, offsets, edges, weights,
+                [](vid_t v, degree_t k, vid_t) {
+                    return ((v * 31 + k * 17) % 100) / 100.0f;
+                });
+    HornetInit hornet_init(nV, edges.size(), offsets.data(), edges.data());
+    hornet_init.insertEdgeData(weights.data());
+    HornetGraph hornet(hornet_init);
+    HostGraph   host(hornet_init);
+    //the order of the sorted adjacency lists is preserved
+    hornet.set_keep_sorted(true);
+    host.sort();
+
+    std::vector<char> h_banned(nV, false);
+    for (vid_t v = 3; v < nV; v += 29)
+        h_banned[v] = true;
+    rmm::device_vector<bool> d_banned(h_banned.begin(), h_banned.end());
+
+    bool is_correct = true;
+    degree_t num_erased = hornet.erase_if(SelfLoop());
+    is_correct &= num_erased > 0 &&
+                  num_erased == host.erase_if([](vid_t v, const HostEdge& e) {
+                                    return std::get<0>(e) == v;
+                                });
+    is_correct &= equal(hornet, host);
+    is_correct &= hornet.last_change().num_edges == num_erased;
+
+    num_erased = hornet.erase_if(LowWeight { 0.25f });
+    is_correct &= num_erased ==
+                  host.erase_if([](vid_t, const HostEdge& e) {
+                      return std::get<1>(e) < 0.25f;
+                  });
+    is_correct &= equal(hornet, host);
+
+    num_erased = hornet.erase_if(BannedVertex { d_banned.data().get() });
+    is_correct &= num_erased ==
+                  host.erase_if([&](vid_t v, const HostEdge& e) {
+                      return h_banned[v] || h_banned[std::get<0>(e)];
+                  });
+    is_correct &= equal(hornet, host);
+
+    //nothing left to erase: the graph does not change
+    auto version = hornet.version();
+    is_correct &= hornet.erase_if(SelfLoop()) == 0 &&
+                  hornet.version() == version;
+
+    std::cout << (is_correct ? "PASSED" : "NOT PASSED") << std::endl;
+    return !is_correct;
+}
+
+int main(int argc, char* argv[]) {
+    int ret = 0;
+    {
+        ret = exec(argc, argv);
+    }
+    return ret;
+}
@@ -0,0 +1,102 @@
+/**
+ * @brief Time-to-live edge expiry test program
+ * @file
+ */
+#include "TestGraph.cuh"
+#include <algorithm>
+#include <tuple>
+#include <vector>
+
+using namespace hornets_nest;
+
+using timestamp_t = int;
+using HornetGraph = ::hornet::gpu::Hornet<vid_t, ::hornet::EMPTY,
+                                          ::hornet::TypeList<timestamp_t>>;
+using HornetInit  = ::hornet::HornetInit<vid_t, ::hornet::EMPTY,
+                                         ::hornet::TypeList<timestamp_t>>;
+using HostGraph   = ::hornet::host::HostGraph<vid_t,
+                                              ::hornet::TypeList<timestamp_t>>;
+using EdgeTuple   = std::tuple<vid_t, vid_t, timestamp_t>;
+
+struct CopyEdges {
+    vid_t*       d_src;
+    vid_t*       d_dst;
+    timestamp_t* d_times;
+    int*         d_count;
+
+    OPERATOR(Vertex& vertex, Edge& edge) {
+        int i = atomicAdd(d_count, 1);
+        d_src[i]   = vertex.id();
+        d_dst[i]   = edge.dst_id();
+        d_times[i] = edge.template field<0>();
+    }
+};
+
+//sorted edges of a graph or of a snapshot
+template <typename HornetClass>
+std::vector<EdgeTuple> getEdges(HornetClass& hornet) {
+    load_balancing::BinarySearch load_balancing(hornet);
+    thrust::device_vector<vid_t>       d_src(hornet.nE());
+    thrust::device_vector<vid_t>       d_dst(hornet.nE());
+    thrust::device_vector<timestamp_t> d_times(hornet.nE());
+    thrust::device_vector<int>         d_count(1, 0);
+    forAllEdges(hornet, CopyEdges { d_src.data().get(), d_dst.data().get(),
+                                    d_times.data().get(),
+                                    d_count.data().get() },
+                load_balancing);
+
+    int num_edges = d_count[0];
+    std::vector<vid_t>       src(num_edges), dst(num_edges);
+    std::vector<timestamp_t> times(num_edges);
+    thrust::copy(d_src.begin(), d_src.begin() + num_edges, src.begin());
+    thrust::copy(d_dst.begin(), d_dst.begin() + num_edges, dst.begin());
+    thrust::copy(d_times.begin(), d_times.begin() + num_edges, times.begin());
+    std::vector<EdgeTuple> edges;
+    for (int i = 0; i < num_edges; i++)
+        edges.emplace_back(src[i], dst[i], times[i]);
+    std::sort(edges.begin(), edges.end());
+    return edges;
+}
+
+int exec(int argc, char* argv[]) {
+    const vid_t nV = 256;
+    std::vector<degree_t>    offsets;
+    std::vector<vid_t>       edges;
+    std::vector<timestamp_t> times;
+    skewedGraph(nV, 13, 1, offsets, edges, times,
+                [](vid_t v, degree_t k, vid_t) {
+                    return (v * 31 + k * 17) % 100;
+                });
+    HornetInit hornet_init(nV, edges.size(), offsets.data(), edges.data());
+    hornet_init.insertEdgeData(times.data());
+    HornetGraph hornet(hornet_init);
+    HostGraph   host(hornet_init);
+
+    bool is_correct = true;
+    {
+        //the snapshot keeps the edges expired after it
+        auto snapshot = hornet.snapshot();
+        auto edges    = getEdges(snapshot);
+        is_correct &= edges.size() == static_cast<size_t>(hornet.nE());
+        is_correct &= hornet.expire_before(20) == host.expire_before(20);
+        is_correct &= equal(hornet, host) && getEdges(snapshot) == edges &&
+                      getEdges(hornet) != edges;
+    }
+    //sliding window
+    for (timestamp_t t : { 20, 50, 90, 101 }) {
+        is_correct &= hornet.expire_before(t) == host.expire_before(t);
+        is_correct &= equal(hornet, host);
+    }
+    is_correct &= hornet.nE() == 0;
+
+    std::cout << (is_correct ? "PASSED" : "NOT PASSED") << std::endl;
+    return !is_correct;
+}
+
+int main(int argc, char* argv[]) {
+    int ret = 0;
+    {
+        ret = exec(argc, argv);
+    }
+    return ret;
+}
@@ -0,0 +1,127 @@
+/**
+ * @brief Hornet to HornetStatic export test program
+ * @file
+ */
+#include "TestGraph.cuh"
+#include <vector>
+
+using namespace hornets_nest;
+
+using weight_t    = float;
+using HornetGraph = ::hornet::gpu::Hornet<vid_t, ::hornet::EMPTY,
+                                          ::hornet::TypeList<weight_t>>;
+using HornetCSR   = HornetGraph::HornetStaticT;
+using HornetInit  = ::hornet::HornetInit<vid_t, ::hornet::EMPTY,
+                                         ::hornet::TypeList<weight_t>>;
+using BatchUpdate = ::hornet::gpu::BatchUpdate<vid_t,
+                                               ::hornet::TypeList<weight_t>>;
+using UpdatePtr   = ::hornet::BatchUpdatePtr<vid_t,
+                                             ::hornet::TypeList<weight_t>,
+                                             ::hornet::DeviceType::HOST>;
+using HostGraph   = ::hornet::host::HostGraph<vid_t,
+                                              ::hornet::TypeList<weight_t>>;
+using HostCSR     = HostGraph::HostCSRT;
+
+//duplicate edges have the same weight
+weight_t weight(vid_t src, vid_t dst) {
+    return ((src * 31 + dst * 17) % 100) / 100.0f;
+}
+
+struct CopyAdjacency {
+    const degree_t* d_offsets;
+    vid_t*          d_dst;
+    weight_t*       d_weights;
+    bool*           d_error;
+
+    OPERATOR(Vertex& vertex) {
+        degree_t begin = d_offsets[vertex.id()];
+        if (vertex.degree() != d_offsets[vertex.id() + 1] - begin) {
+            *d_error = true;
+            return;
+        }
+        for (degree_t i = 0; i < vertex.degree(); i++) {
+            auto edge = vertex.edge(i);
+            d_dst[begin + i]     = edge.dst_id();
+            d_weights[begin + i] = edge.template field<0>();
+        }
+    }
+};
+
+//same edges, in the same order, for every adjacency list
+bool equal(HornetCSR& graph, HostCSR& csr) {
+    if (graph.nV() != csr.nV() || graph.nE() != csr.nE())
+        return false;
+    rmm::device_vector<degree_t> d_offsets(csr.csr_offsets(),
+                                           csr.csr_offsets() + csr.nV() + 1);
+    rmm::device_vector<vid_t>    d_dst(csr.nE());
+    rmm::device_vector<weight_t> d_weights(csr.nE());
+    rmm::device_vector<bool>     d_error(1, false);
+    forAllVertices(graph, CopyAdjacency { d_offsets.data().get(),
+                                          d_dst.data().get(),
+                                          d_weights.data().get(),
+                                          d_error.data().get() });
+    std::vector<vid_t>    dst(csr.nE());
+    std::vector<weight_t> weights(csr.nE());
+    thrust::copy(d_dst.begin(), d_dst.end(), dst.begin());
+    thrust::copy(d_weights.begin(), d_weights.end(), weights.begin());
+    return !d_error[0] &&
+           dst == std::vector<vid_t>(csr.edge_field<0>(),
+                                     csr.edge_field<0>() + csr.nE()) &&
+           weights == std::vector<weight_t>(csr.edge_field<1>(),
+                                            csr.edge_field<1>() + csr.nE());
+}
+
+int exec(int argc, char* argv[]) {
+    const vid_t nV = 256;
+    std::vector<degree_t> offsets;
+    std::vector<vid_t>    edges;
+    std::vector<weight_t> weights;
+    skewedGraph(nV, 37, 1, offsets, edges, weights,
+                [](vid_t v, degree_t, vid_t dst) { return weight(v, dst); });
+    HornetInit hornet_init(nV, edges.size(), offsets.data(), edges.data());
+    hornet_init.insertEdgeData(weights.data());
+    HornetGraph hornet(hornet_init);
+    HostGraph   host(hornet_init);
+
+    //adjacency lists in the order of the edge blocks
+    bool is_correct = true;
+    {
+        auto    static_graph = hornet.freeze();
+        HostCSR expected     = host.freeze();
+        is_correct &= equal(static_graph, expected);
+    }
+
+    std::vector<vid_t>    src, dst;
+    std::vector<weight_t> batch_weights;
+    for (int i = 0; i < 1000; i++) {
+        src.push_back((i * 7) % nV);
+        dst.push_back((i * 13 + 5) % nV);
+        batch_weights.push_back(weight(src.back(), dst.back()));
+    }
+    UpdatePtr   ptr(src.size(), src.data(), dst.data(), batch_weights.data());
+    BatchUpdate batch(ptr);
+    hornet.insert(batch);
+    host.insert(ptr);
+
+    //sorted copy, the dynamic graph is not changed
+    degree_t nE           = hornet.nE();
+    auto     static_graph = hornet.freeze(true);
+    HostCSR  expected     = host.freeze(true);
+    is_correct &= equal(static_graph, expected) && hornet.nE() == nE;
+
+    //host-to-host: HostGraph -> CSR -> HornetStatic
+    auto      h_init = expected.init();
+    HornetCSR from_host(h_init);
+    is_correct &= equal(from_host, expected);
+
+    std::cout << (is_correct ? "PASSED" : "NOT PASSED") << std::endl;
+    return !is_correct;
+}
+
+int main(int argc, char* argv[]) {
+    int ret = 0;
+    {
+        ret = exec(argc, argv);
+    }
+    return ret;
+}
@@ -0,0 +1,130 @@
+/**
+ * @brief Sparse, dense and automatic frontier test program
+ * @file
+ */
+#include "Static/BreadthFirstSearch/TopDown2.cuh"
+#include <Device/Util/Timer.cuh>
+#include <Graph/GraphStd.hpp>
+#include <algorithm>
+#include <atomic>
+#include <vector>
+
+using namespace timer;
+using namespace hornets_nest;
+
+struct CountVertices {
+    int* d_count;
+
+    OPERATOR(Vertex& vertex) {
+        atomicAdd(d_count, 1);
+    }
+};
+
+std::vector<dist_t> hostBFS(const graph::GraphStd<vid_t, eoff_t>& graph,
+                            vid_t source, FrontierPolicy policy) {
+    auto offsets = graph.csr_out_offsets();
+    auto edges   = graph.csr_out_edges();
+    std::vector<std::atomic<dist_t>> distances(graph.nV());
+    for (auto& distance : distances)
+        distance = INF;
+    distances[source] = 0;
+
+    host::Frontier<vid_t> frontier(graph.nV(), graph.nV());
+    frontier.set_policy(policy);
+    frontier.insert(&source, 1);
+    for (dist_t level = 1; frontier.size() > 0; level++) {
+        frontier.forEach([&](vid_t v) {
+            for (auto i = offsets[v]; i < offsets[v + 1]; i++) {
+                auto expected = INF;
+                if (distances[edges[i]].compare_exchange_strong(expected,
+                                                                level))
+                    frontier.insert(edges[i]);
+            }
+        });
+        frontier.swap();
+    }
+    return std::vector<dist_t>(distances.begin(), distances.end());
+}
+
+std::vector<dist_t> deviceBFS(HornetDynamicGraph& hornet, vid_t source,
+                              FrontierPolicy policy, bool& is_correct) {
+    thrust::device_vector<dist_t> d_distances(hornet.nV(), INF);
+    thrust::device_vector<int>    d_count(1);
+    d_distances[source] = 0;
+
+    Frontier<vid_t> frontier(hornet, 2);
+    load_balancing::BinarySearch load_balancing(hornet);
+    frontier.set_policy(policy);
+    frontier.insert(source);
+
+    Timer<DEVICE> TM;
+    TM.start();
+    int num_dense = 0;
+    for (dist_t level = 1; frontier.size() > 0; level++) {
+        //the bitmap and the queue visits must agree on the level size
+        d_count[0] = 0;
+        forAllVertices(hornet, frontier,
+                       CountVertices { d_count.data().get() });
+        is_correct &= d_count[0] == frontier.size();
+
+        forAllEdges(hornet, frontier,
+                    BFSOperatorAtomic { level, d_distances.data().get(),
+                                        frontier },
+                    load_balancing);
+        frontier.swap();
+        num_dense += frontier.mode() == FrontierMode::DENSE;
+    }
+    TM.stop();
+    std::cout << "levels (dense): " << num_dense << "  ";
+    TM.print("BFS");
+
+    std::vector<dist_t> distances(hornet.nV());
+    thrust::copy(d_distances.begin(), d_distances.end(), distances.begin());
+    return distances;
+}
+
+int exec(int argc, char* argv[]) {
+    using namespace graph::parsing_prop;
+
+    graph::GraphStd<vid_t, eoff_t> graph;
+    graph.read(argv[1], PRINT_INFO | SORT);
+    vid_t source = argc > 2 ? std::stoi(argv[2]) : graph.max_out_degree_id();
+
+    HornetInit hornet_init(graph.nV(), graph.nE(), graph.csr_out_offsets(),
+                           graph.csr_out_edges());
+    HornetDynamicGraph hornet_graph(hornet_init);
+
+    auto reference = hostBFS(graph, source, FrontierPolicy::SPARSE);
+    bool is_correct = true;
+    for (auto policy : { FrontierPolicy::SPARSE, FrontierPolicy::DENSE,
+                         FrontierPolicy::AUTO }) {
+        is_correct &= hostBFS(graph, source, policy) == reference;
+        auto distances = deviceBFS(hornet_graph, source, policy, is_correct);
+        is_correct &= distances == reference;
+    }
+
+    //a sparse level with duplicates shrinks when converted to dense
+    Frontier<vid_t> frontier(hornet_graph, 1);
+    std::vector<vid_t> items { 3, 3, 5, 64, 5 };
+    frontier.insert(items.data(), items.size());
+    frontier.convert(FrontierMode::DENSE);
+    is_correct &= frontier.size() == 3 &&
+                  frontier.mode() == FrontierMode::DENSE;
+    frontier.convert(FrontierMode::SPARSE);
+    std::vector<vid_t> compacted(frontier.size());
+    gpu::copyToHost(frontier.device_input_ptr(), frontier.size(),
+                    compacted.data());
+    std::sort(compacted.begin(), compacted.end());
+    is_correct &= compacted == std::vector<vid_t> { 3, 5, 64 };
+
+    std::cout << (is_correct ? "PASSED" : "NOT PASSED") << std::endl;
+    return !is_correct;
+}
+
+int main(int argc, char* argv[]) {
+    int ret = 0;
+    {
+        ret = exec(argc, argv);
+    }
+    return ret;
+}
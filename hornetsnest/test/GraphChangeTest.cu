@@ -0,0 +1,138 @@
+/**
+ * @brief Graph version and change notification test program
+ * @file
+ */
+#include "TestGraph.cuh"
+#include <Graph/GraphStd.hpp>
+#include <Util/BatchFunctions.hpp>
+#include <algorithm>
+#include <set>
+#include <utility>
+#include <vector>
+
+using namespace hornets_nest;
+
+using HornetGraph = ::hornet::gpu::Hornet<vid_t>;
+using HornetInit  = ::hornet::HornetInit<vid_t>;
+using BatchUpdate = ::hornet::gpu::BatchUpdate<vid_t>;
+using UpdatePtr   = ::hornet::BatchUpdatePtr<vid_t, ::hornet::EMPTY,
+                                             ::hornet::DeviceType::HOST>;
+using GraphChange = ::hornet::GraphChange<vid_t, int>;
+
+/*
+ * keeps a host copy of the degrees up to date from the change summaries only
+ */
+class DegreeTracker : public ::hornet::GraphSubscriber<vid_t, int> {
+public:
+    explicit DegreeTracker(HornetGraph& hornet) :
+                            degrees(getDegrees(hornet)),
+                            version(hornet.version()),
+                            _hornet(hornet) {}
+
+    void graphChanged(const GraphChange& change) override {
+        is_monotonic &= change.version > version;
+        version = change.version;
+        num_notifications++;
+
+        std::vector<vid_t> sources(change.num_sources);
+        std::vector<int>   deltas(change.num_sources);
+        gpu::copyToHost(change.d_sources, change.num_sources, sources.data());
+        gpu::copyToHost(change.d_degree_deltas, change.num_sources,
+                        deltas.data());
+        for (int i = 0; i < change.num_sources; i++)
+            degrees[sources[i]] += deltas[i];
+
+        //notified after the update lock is released: the snapshot does not
+        //deadlock and sees the changed graph
+        auto snapshot = _hornet.snapshot();
+        is_consistent &= snapshot.version() == change.version &&
+                         getDegrees(snapshot) == degrees;
+
+        //the batch edges are valid only during the notification
+        std::vector<vid_t> src(change.num_edges), dst(change.num_edges);
+        gpu::copyToHost(change.d_batch_src, change.num_edges, src.data());
+        gpu::copyToHost(change.d_batch_dst, change.num_edges, dst.data());
+        edges.clear();
+        for (int i = 0; i < change.num_edges; i++)
+            edges.emplace_back(src[i], dst[i]);
+    }
+
+    std::vector<int> degrees;
+    std::vector<std::pair<vid_t, vid_t>> edges;
+    size_t           version;
+    int              num_notifications { 0 };
+    bool             is_monotonic      { true };
+    bool             is_consistent     { true };
+
+private:
+    HornetGraph& _hornet;
+};
+
+int exec(int argc, char* argv[]) {
+    using namespace graph::parsing_prop;
+
+    graph::GraphStd<vid_t, eoff_t> graph;
+    graph.read(argv[1], PRINT_INFO | SORT);
+    int batch_size  = argc > 2 ? std::stoi(argv[2]) : 10000;
+    int num_batches = argc > 3 ? std::stoi(argv[3]) : 4;
+
+    HornetInit hornet_init(graph.nV(), graph.nE(), graph.csr_out_offsets(),
+                           graph.csr_out_edges());
+    HornetGraph hornet_graph(hornet_init);
+
+    DegreeTracker tracker(hornet_graph);
+    hornet_graph.subscribe(&tracker);
+
+    std::vector<vid_t> batch_src(batch_size), batch_dst(batch_size);
+    bool is_correct = true;
+    for (int i = 0; i < num_batches; i++) {
+        bool is_insert = (i % 2 == 0);
+        int  size      = batch_size;
+        generateBatch(graph, size, batch_src.data(), batch_dst.data(),
+                      is_insert ? BatchGenType::INSERT : BatchGenType::REMOVE);
+        BatchUpdate batch(UpdatePtr(size, batch_src.data(), batch_dst.data()));
+
+        auto nE = hornet_graph.nE();
+        if (is_insert)
+            hornet_graph.insert(batch, true, true);
+        else
+            hornet_graph.erase(batch, true);
+
+        const auto& change = hornet_graph.last_change();
+        std::cout << (is_insert ? "insert" : "erase ") << " batch  edges: "
+                  << change.num_edges << "  sources: " << change.num_sources
+                  << "  reallocated: " << change.num_reallocated << "\n";
+        is_correct &= change.version == hornet_graph.version() &&
+                      std::abs(hornet_graph.nE() - nE) == change.num_edges;
+        is_correct &= tracker.degrees == getDegrees(hornet_graph);
+
+        //the reported edges are (src, dst) pairs of the batch, by source
+        std::set<std::pair<vid_t, vid_t>> batch_edges;
+        for (int j = 0; j < size; j++)
+            batch_edges.emplace(batch_src[j], batch_dst[j]);
+        is_correct &= tracker.edges.size() ==
+                      static_cast<size_t>(change.num_edges);
+        is_correct &= std::is_sorted(tracker.edges.begin(),
+                                     tracker.edges.end(),
+                          [](const std::pair<vid_t, vid_t>& a,
+                             const std::pair<vid_t, vid_t>& b) {
+                              return a.first < b.first;
+                          });
+        for (const auto& edge : tracker.edges)
+            is_correct &= batch_edges.count(edge) == 1;
+    }
+    hornet_graph.unsubscribe(&tracker);
+    is_correct &= tracker.num_notifications == num_batches &&
+                  tracker.is_monotonic && tracker.is_consistent;
+
+    std::cout << (is_correct ? "PASSED" : "NOT PASSED") << std::endl;
+    return !is_correct;
+}
+
+int main(int argc, char* argv[]) {
+    int ret = 0;
+    {
+        ret = exec(argc, argv);
+    }
+    return ret;
+}
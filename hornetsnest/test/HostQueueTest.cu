@@ -0,0 +1,133 @@
+/**
+ * @brief Host concurrent two-level queue test program
+ * @file
+ */
+#include "HornetAlg.hpp"
+#include <Device/Util/Timer.cuh>
+#include <Graph/GraphStd.hpp>
+#include <algorithm>
+#include <atomic>
+#include <limits>
+#include <vector>
+
+using namespace timer;
+using namespace hornets_nest;
+
+using dist_t = int;
+const dist_t INF = std::numeric_limits<dist_t>::max();
+
+/*
+ * the visited bitmap of the queue replaces the atomic test on the distances
+ */
+std::vector<dist_t> bfsDedup(const graph::GraphStd<vid_t, eoff_t>& graph,
+                             vid_t source) {
+    auto offsets = graph.csr_out_offsets();
+    auto edges   = graph.csr_out_edges();
+    std::vector<dist_t> distances(graph.nV(), INF);
+
+    host::TwoLevelQueue<vid_t> queue(graph.nV(), graph.nV());
+    queue.insert(&source, 1);
+    for (dist_t level = 0; queue.size() > 0; level++) {
+        queue.forEach([&](vid_t v) {
+            distances[v] = level;
+            for (auto i = offsets[v]; i < offsets[v + 1]; i++)
+                queue.insert(edges[i]);
+        });
+        queue.swap();
+    }
+    return distances;
+}
+
+std::vector<dist_t> bfsAtomic(const graph::GraphStd<vid_t, eoff_t>& graph,
+                              vid_t source) {
+    auto offsets = graph.csr_out_offsets();
+    auto edges   = graph.csr_out_edges();
+    std::vector<std::atomic<dist_t>> distances(graph.nV());
+    for (auto& distance : distances)
+        distance = INF;
+    distances[source] = 0;
+
+    host::TwoLevelQueue<vid_t> queue(graph.nV());
+    queue.insert(&source, 1);
+    for (dist_t level = 1; queue.size() > 0; level++) {
+        queue.forEach([&](vid_t v) {
+            for (auto i = offsets[v]; i < offsets[v + 1]; i++) {
+                auto expected = INF;
+                if (distances[edges[i]].compare_exchange_strong(expected,
+                                                                level))
+                    queue.insert(edges[i]);
+            }
+        });
+        queue.swap();
+    }
+    return std::vector<dist_t>(distances.begin(), distances.end());
+}
+
+std::vector<dist_t> bfsSequential(const graph::GraphStd<vid_t, eoff_t>& graph,
+                                  vid_t source) {
+    auto offsets = graph.csr_out_offsets();
+    auto edges   = graph.csr_out_edges();
+    std::vector<dist_t> distances(graph.nV(), INF);
+    std::vector<vid_t>  queue { source };
+    distances[source] = 0;
+    for (size_t j = 0; j < queue.size(); j++) {
+        auto v = queue[j];
+        for (auto i = offsets[v]; i < offsets[v + 1]; i++) {
+            if (distances[edges[i]] == INF) {
+                distances[edges[i]] = distances[v] + 1;
+                queue.push_back(edges[i]);
+            }
+        }
+    }
+    return distances;
+}
+
+int exec(int argc, char* argv[]) {
+    using namespace graph::parsing_prop;
+
+    graph::GraphStd<vid_t, eoff_t> graph;
+    graph.read(argv[1], PRINT_INFO | SORT);
+    vid_t source = argc > 2 ? std::stoi(argv[2]) : graph.max_out_degree_id();
+
+    Timer<HOST> TM;
+    TM.start();
+    auto reference = bfsSequential(graph, source);
+    TM.stop();
+    TM.print("Sequential BFS");
+
+    TM.start();
+    auto distances = bfsAtomic(graph, source);
+    TM.stop();
+    TM.print("Parallel BFS (atomic distances)");
+    bool is_correct = distances == reference;
+
+    TM.start();
+    distances = bfsDedup(graph, source);
+    TM.stop();
+    TM.print("Parallel BFS (visited bitmap)");
+    is_correct &= distances == reference;
+
+    //every insertion from every thread reaches the next level exactly once
+    const int num_items = 1 << 20;
+    host::TwoLevelQueue<int> queue(num_items);
+    #pragma omp parallel for
+    for (int i = 0; i < num_items; i++)
+        queue.insert(i);
+    queue.swap();
+    std::vector<int> items(queue.input_ptr(), queue.input_ptr() + queue.size());
+    std::sort(items.begin(), items.end());
+    is_correct &= queue.size() == num_items && queue.output_size() == 0;
+    for (int i = 0; i < queue.size(); i++)
+        is_correct &= items[i] == i;
+
+    std::cout << (is_correct ? "PASSED" : "NOT PASSED") << std::endl;
+    return !is_correct;
+}
+
+int main(int argc, char* argv[]) {
+    int ret = 0;
+    {
+        ret = exec(argc, argv);
+    }
+    return ret;
+}
@@ -0,0 +1,109 @@
+/**
+ * @brief Cached full-graph traversal test program
+ * @file
+ */
+#include "HornetAlg.hpp"
+#include <Device/Util/Timer.cuh>
+#include <Graph/GraphStd.hpp>
+#include <Util/BatchFunctions.hpp>
+
+using namespace timer;
+using namespace hornets_nest;
+
+using HornetGraph = ::hornet::gpu::Hornet<vid_t>;
+using HornetInit  = ::hornet::HornetInit<vid_t>;
+using BatchUpdate = ::hornet::gpu::BatchUpdate<vid_t>;
+using UpdatePtr   = ::hornet::BatchUpdatePtr<vid_t, ::hornet::EMPTY,
+                                             ::hornet::DeviceType::HOST>;
+
+using count_t = unsigned long long;
+
+struct CountEdges {
+    count_t* d_count;
+
+    OPERATOR(Vertex& vertex, Edge& edge) {
+        atomicAdd(d_count, count_t(1));
+    }
+};
+
+template<typename LoadBalancing>
+bool checkSweeps(const char* name, HornetGraph& hornet,
+                 const LoadBalancing& load_balancing, int num_sweeps) {
+    thrust::device_vector<count_t> d_count(1, 0);
+    Timer<DEVICE> TM;
+    TM.start();
+    forAllEdges(hornet, CountEdges { d_count.data().get() }, load_balancing);
+    TM.stop();
+    std::cout << name << "  first sweep: " << TM.duration() << " ms";
+
+    TM.start();
+    for (int i = 1; i < num_sweeps; i++) {
+        forAllEdges(hornet, CountEdges { d_count.data().get() },
+                    load_balancing);
+    }
+    TM.stop();
+    std::cout << "  next sweeps (avg): "
+              << TM.duration() / std::max(num_sweeps - 1, 1) << " ms\n";
+    return d_count[0] == static_cast<count_t>(hornet.nE()) * num_sweeps;
+}
+
+int exec(int argc, char* argv[]) {
+    using namespace graph::parsing_prop;
+
+    graph::GraphStd<vid_t, eoff_t> graph;
+    graph.read(argv[1], PRINT_INFO | SORT);
+    int batch_size = argc > 2 ? std::stoi(argv[2]) : 10000;
+    int num_sweeps = argc > 3 ? std::stoi(argv[3]) : 20;
+
+    HornetInit hornet_init(graph.nV(), graph.nE(), graph.csr_out_offsets(),
+                           graph.csr_out_edges());
+    HornetGraph hornet_graph(hornet_init);
+    HornetGraph other_graph(hornet_init);
+
+    load_balancing::BinarySearch binary_search(hornet_graph);
+    load_balancing::MergePath    merge_path(hornet_graph);
+
+    //versions are unique among the graphs and change only with the structure
+    auto version = hornet_graph.version();
+    bool is_correct = version != other_graph.version();
+    is_correct &= checkSweeps("BinarySearch", hornet_graph, binary_search,
+                              num_sweeps);
+    is_correct &= checkSweeps("MergePath   ", hornet_graph, merge_path,
+                              num_sweeps);
+    is_correct &= hornet_graph.version() == version;
+
+    std::vector<vid_t> batch_src(batch_size), batch_dst(batch_size);
+    for (int i = 0; i < 2; i++) {
+        bool is_insert = (i == 0);
+        int  size      = batch_size;
+        generateBatch(graph, size, batch_src.data(), batch_dst.data(),
+                      is_insert ? BatchGenType::INSERT : BatchGenType::REMOVE);
+        BatchUpdate batch(UpdatePtr(size, batch_src.data(), batch_dst.data()));
+        if (is_insert)
+            hornet_graph.insert(batch, true, true);
+        else
+            hornet_graph.erase(batch, true);
+        std::cout << (is_insert ? "insert" : "erase ") << " batch  nE: "
+                  << hornet_graph.nE() << "\n";
+
+        is_correct &= hornet_graph.version() > version;
+        version = hornet_graph.version();
+        //the cached prefix sums are stale: the sweeps must see the new edges
+        is_correct &= checkSweeps("BinarySearch", hornet_graph, binary_search,
+                                  num_sweeps);
+        is_correct &= checkSweeps("MergePath   ", hornet_graph, merge_path,
+                                  num_sweeps);
+        is_correct &= checkSweeps("BinarySearch", other_graph, binary_search,
+                                  1);
+    }
+    std::cout << (is_correct ? "PASSED" : "NOT PASSED") << std::endl;
+    return !is_correct;
+}
+
+int main(int argc, char* argv[]) {
+    int ret = 0;
+    {
+        ret = exec(argc, argv);
+    }
+    return ret;
+}
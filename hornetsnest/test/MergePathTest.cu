@@ -0,0 +1,152 @@
+/**
+ * @brief Load balancing benchmark on graphs with extreme degree skew
+ * @file
+ */
+#include "HornetAlg.hpp"
+#include "LoadBalancing/MergePath.cuh"
+#include <Device/Util/Timer.cuh>
+#include <numeric>
+#include <random>
+#include <vector>
+#include <omp.h>
+
+using namespace timer;
+using namespace hornets_nest;
+
+using HornetGraph = ::hornet::gpu::Hornet<vid_t>;
+using HornetInit  = ::hornet::HornetInit<vid_t>;
+
+using checksum_t = unsigned long long;
+
+HOST_DEVICE checksum_t edgeHash(vid_t src, vid_t dst) {
+    return static_cast<checksum_t>(src) * 31 + dst + 1;
+}
+
+struct EdgeChecksum {
+    checksum_t* d_checksum;
+
+    OPERATOR(Vertex& vertex, Edge& edge) {
+        atomicAdd(d_checksum, edgeHash(vertex.id(), edge.dst_id()));
+    }
+};
+
+template<typename LoadBalancing>
+bool traverse(const char* name, HornetGraph& hornet, const vid_t* d_frontier,
+              int frontier_size, const LoadBalancing& load_balancing,
+              checksum_t* d_checksum, checksum_t expected) {
+    Timer<DEVICE> TM;
+    gpu::memsetZero(d_checksum);
+    TM.start();
+    if (d_frontier == nullptr)
+        forAllEdges(hornet, EdgeChecksum { d_checksum }, load_balancing);
+    else {
+        forAllEdges(hornet, d_frontier, frontier_size,
+                    EdgeChecksum { d_checksum }, load_balancing);
+    }
+    TM.stop();
+    TM.print(name);
+
+    checksum_t checksum;
+    gpu::copyToHost(d_checksum, 1, &checksum);
+    return checksum == expected;
+}
+
+int exec(int argc, char* argv[]) {
+    int nV         = argc > 1 ? std::stoi(argv[1]) : (1 << 20);
+    int num_hubs   = argc > 2 ? std::stoi(argv[2]) : 4;
+    int max_degree = argc > 3 ? std::stoi(argv[3]) : 4;
+
+    //a few hubs adjacent to every vertex, all the others with tiny degree
+    std::mt19937 gen(0);
+    std::uniform_int_distribution<int>   degree_dist(0, max_degree);
+    std::uniform_int_distribution<vid_t> vertex_dist(0, nV - 1);
+    std::vector<int>   h_offsets(nV + 1, 0);
+    std::vector<vid_t> h_edges;
+    for (vid_t v = 0; v < nV; v++) {
+        if (v < num_hubs) {
+            for (vid_t u = 0; u < nV; u++)
+                h_edges.push_back(u);
+        }
+        else {
+            int degree = degree_dist(gen);
+            for (int i = 0; i < degree; i++)
+                h_edges.push_back(vertex_dist(gen));
+        }
+        h_offsets[v + 1] = h_edges.size();
+    }
+    int nE = h_edges.size();
+    std::cout << "nV: " << nV << "  nE: " << nE << "  hubs: " << num_hubs
+              << "\n";
+
+    checksum_t expected = 0, expected_frontier = 0;
+    std::vector<vid_t> h_frontier;
+    for (vid_t v = 0; v < nV; v++) {
+        checksum_t sum = 0;
+        for (int i = h_offsets[v]; i < h_offsets[v + 1]; i++)
+            sum += edgeHash(v, h_edges[i]);
+        expected += sum;
+        if (v % 2 == 0) {
+            h_frontier.push_back(v);
+            expected_frontier += sum;
+        }
+    }
+
+    HornetInit hornet_init(nV, nE, h_offsets.data(), h_edges.data());
+    HornetGraph hornet(hornet_init);
+
+    thrust::device_vector<vid_t>      d_frontier(h_frontier);
+    thrust::device_vector<checksum_t> d_checksum(1);
+    auto checksum_ptr = d_checksum.data().get();
+    int frontier_size = h_frontier.size();
+
+    load_balancing::BinarySearch binary_search(hornet);
+    load_balancing::VertexBased1 vertex_based;
+    load_balancing::MergePath    merge_path(hornet);
+
+    bool is_correct = true;
+    std::cout << "\nFull graph:\n";
+    is_correct &= traverse("BinarySearch:       ", hornet, nullptr, nV,
+                           binary_search, checksum_ptr, expected);
+    is_correct &= traverse("VertexBased1:       ", hornet, nullptr, nV,
+                           vertex_based, checksum_ptr, expected);
+    is_correct &= traverse("MergePath:          ", hornet, nullptr, nV,
+                           merge_path, checksum_ptr, expected);
+    is_correct &= traverse("MergePath (cached): ", hornet, nullptr, nV,
+                           merge_path, checksum_ptr, expected);
+
+    std::cout << "\nFrontier (" << frontier_size << " vertices):\n";
+    auto frontier_ptr = d_frontier.data().get();
+    is_correct &= traverse("BinarySearch:       ", hornet, frontier_ptr,
+                           frontier_size, binary_search, checksum_ptr,
+                           expected_frontier);
+    is_correct &= traverse("VertexBased1:       ", hornet, frontier_ptr,
+                           frontier_size, vertex_based, checksum_ptr,
+                           expected_frontier);
+    is_correct &= traverse("MergePath:          ", hornet, frontier_ptr,
+                           frontier_size, merge_path, checksum_ptr,
+                           expected_frontier);
+
+    std::cout << "\nHost CSR:\n";
+    Timer<HOST> TM_host;
+    std::vector<checksum_t> partial(omp_get_max_threads(), 0);
+    TM_host.start();
+    load_balancing::MergePath::applyHost(h_offsets.data(), nV,
+        [&](int v, int e) {
+            partial[omp_get_thread_num()] += edgeHash(v, h_edges[e]);
+        });
+    TM_host.stop();
+    TM_host.print("MergePath (OpenMP): ");
+    is_correct &= std::accumulate(partial.begin(), partial.end(),
+                                  checksum_t(0)) == expected;
+
+    std::cout << (is_correct ? "PASSED" : "NOT PASSED") << std::endl;
+    return !is_correct;
+}
+
+int main(int argc, char* argv[]) {
+    int ret = 0;
+    {
+        ret = exec(argc, argv);
+    }
+    return ret;
+}
@@ -0,0 +1,94 @@
+/**
+ * @brief Multi-source betweenness centrality test program
+ * @file
+ */
+#include "Static/BetweennessCentrality/approximate_bc.cuh"
+#include "Static/BetweennessCentrality/multi_source_bc.cuh"
+#include <Device/Util/Timer.cuh>
+#include <Graph/GraphStd.hpp>
+
+using namespace timer;
+using namespace hornets_nest;
+
+bool compareScores(const bc_t* expected, const bc_t* scores, vid_t nV) {
+    for (vid_t v = 0; v < nV; v++) {
+        if (std::abs(expected[v] - scores[v]) >
+                1e-6 * std::max(1.0, std::abs(expected[v]))) {
+            std::cout << "vertex " << v << "  expected: " << expected[v]
+                      << "  found: " << scores[v] << "\n";
+            return false;
+        }
+    }
+    return true;
+}
+
+void printRate(const char* name, int num_roots, float ms) {
+    std::cout << name << ms << " ms  " << num_roots * 1000.0f / ms
+              << " roots/s\n";
+}
+
+int exec(int argc, char* argv[]) {
+    using namespace graph::structure_prop;
+    using namespace graph::parsing_prop;
+
+    graph::GraphStd<vid_t, eoff_t> graph(UNDIRECTED);
+    graph.read(argv[1], PRINT_INFO | SORT);
+    vid_t num_roots = argc > 2 ? std::stoi(argv[2]) : 256;
+
+    HornetInit hornet_init(graph.nV(), graph.nE(), graph.csr_out_offsets(),
+                           graph.csr_out_edges());
+    HornetGraph hornet_graph(hornet_init);
+
+    vid_t* roots;
+    ApproximateBC::generateRandomRootsUniform(graph.nV(), num_roots, &roots, 1);
+
+    Timer<DEVICE> TM;
+    ApproximateBC per_root(hornet_graph, roots, num_roots);
+    TM.start();
+    per_root.run();
+    TM.stop();
+    printRate("Per-root loop:      ", num_roots, TM.duration());
+
+    MultiSourceBC batch32(hornet_graph, roots, num_roots);
+    TM.start();
+    batch32.run();
+    TM.stop();
+    printRate("Multi-source (32):  ", num_roots, TM.duration());
+
+    MultiSourceBC64 batch64(hornet_graph, roots, num_roots);
+    TM.start();
+    batch64.run();
+    TM.stop();
+    printRate("Multi-source (64):  ", num_roots, TM.duration());
+
+    Timer<HOST> TM_host;
+    host::MultiSourceBC host_bc(graph.csr_out_offsets(), graph.csr_out_edges(),
+                                graph.nV(), roots, num_roots);
+    TM_host.start();
+    host_bc.run();
+    TM_host.stop();
+    printRate("Host:               ", num_roots, TM_host.duration());
+
+    std::vector<bc_t> h_expected(graph.nV()), h_scores(graph.nV());
+    gpu::copyToHost(per_root.getBCScores(), graph.nV(), h_expected.data());
+    bool is_correct = compareScores(h_expected.data(),
+                                    host_bc.getBCScores(), graph.nV());
+    gpu::copyToHost(batch32.getBCScores(), graph.nV(), h_scores.data());
+    is_correct &= compareScores(h_expected.data(), h_scores.data(),
+                                graph.nV());
+    gpu::copyToHost(batch64.getBCScores(), graph.nV(), h_scores.data());
+    is_correct &= compareScores(h_expected.data(), h_scores.data(),
+                                graph.nV());
+
+    delete[] roots;
+    std::cout << (is_correct ? "PASSED" : "NOT PASSED") << std::endl;
+    return !is_correct;
+}
+
+int main(int argc, char* argv[]) {
+    int ret = 0;
+    {
+        ret = exec(argc, argv);
+    }
+    return ret;
+}
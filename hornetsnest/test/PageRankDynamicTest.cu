@@ -0,0 +1,82 @@
+/**
+ * @brief Dynamic PageRank test program
+ * @file
+ */
+#include "Dynamic/PageRank/PageRank.cuh"
+#include <Device/Util/Timer.cuh>
+#include <Graph/GraphStd.hpp>
+#include <Util/BatchFunctions.hpp>
+
+using namespace timer;
+using namespace hornets_nest;
+
+using UpdatePtr = ::hornet::BatchUpdatePtr<vid_t, ::hornet::EMPTY,
+                                           ::hornet::DeviceType::HOST>;
+
+void printStats(PageRankDynamic& page_rank, int nV) {
+    int saved = page_rank.cold_start_iteration_count() -
+                page_rank.get_iteration_count();
+    std::cout << "sweeps: " << page_rank.get_iteration_count()
+              << "  cold start iterations: "
+              << page_rank.cold_start_iteration_count()
+              << "  saved: " << saved
+              << "  pushed vertices: " << page_rank.pushed_vertices()
+              << " (cold start: "
+              << static_cast<long>(nV) * page_rank.cold_start_iteration_count()
+              << ")\n";
+}
+
+int exec(int argc, char* argv[]) {
+    using namespace graph::parsing_prop;
+
+    graph::GraphStd<vid_t, eoff_t> graph;
+    graph.read(argv[1], PRINT_INFO | SORT);
+    int batch_size  = argc > 2 ? std::stoi(argv[2]) : 1000;
+    int num_batches = argc > 3 ? std::stoi(argv[3]) : 4;
+
+    HornetInit hornet_init(graph.nV(), graph.nE(), graph.csr_out_offsets(),
+                           graph.csr_out_edges());
+    HornetGraph hornet_graph(hornet_init);
+
+    PageRankDynamic page_rank(hornet_graph, 1000, 0.001f, 0.85f);
+    Timer<DEVICE> TM;
+    TM.start();
+    page_rank.run();
+    TM.stop();
+    TM.print("Cold start:");
+
+    std::vector<vid_t> batch_src(batch_size), batch_dst(batch_size);
+    bool is_correct = true;
+    for (int i = 0; i < num_batches && is_correct; i++) {
+        bool is_insert = (i % 2 == 0);
+        int  size      = batch_size;
+        generateBatch(graph, size, batch_src.data(), batch_dst.data(),
+                      is_insert ? BatchGenType::INSERT : BatchGenType::REMOVE);
+        BatchUpdate batch(UpdatePtr(size, batch_src.data(), batch_dst.data()));
+
+        TM.start();
+        if (is_insert) {
+            hornet_graph.insert(batch, true, true);
+            page_rank.batchUpdateInserted(batch);
+        } else {
+            page_rank.batchUpdateDeleted(batch);
+            hornet_graph.erase(batch);
+        }
+        TM.stop();
+        std::cout << (is_insert ? "insert" : "erase ") << " batch " << i
+                  << "  ";
+        TM.print("time:");
+        is_correct &= page_rank.validate();
+        printStats(page_rank, graph.nV());
+    }
+    std::cout << (is_correct ? "PASSED" : "NOT PASSED") << std::endl;
+    return !is_correct;
+}
+
+int main(int argc, char* argv[]) {
+    int ret = 0;
+    {
+        ret = exec(argc, argv);
+    }
+    return ret;
+}
@@ -0,0 +1,127 @@
+/**
+ * @brief Personalized PageRank test program
+ * @file
+ */
+#include "Static/PersonalizedPageRank/PersonalizedPageRank.cuh"
+#include <Device/Util/Timer.cuh>
+#include <Graph/GraphStd.hpp>
+#include <numeric>
+#include <random>
+
+using namespace timer;
+using namespace hornets_nest;
+
+const int BATCH_WIDTH = 32;
+
+/*
+ * power iteration on the host, dangling vertices keep their mass
+ */
+std::vector<double> hostPpr(const graph::GraphStd<vid_t, eoff_t>& graph,
+                            vid_t seed, double alpha) {
+    const eoff_t* offsets = graph.csr_out_offsets();
+    const vid_t*  edges   = graph.csr_out_edges();
+    std::vector<double> ppr(graph.nV(), 0), next(graph.nV());
+    ppr[seed] = 1;
+    for (int iter = 0; iter < 300; iter++) {
+        std::fill(next.begin(), next.end(), 0);
+        next[seed] = alpha;
+        for (vid_t v = 0; v < graph.nV(); v++) {
+            auto degree = offsets[v + 1] - offsets[v];
+            if (degree == 0) {
+                next[v] += (1 - alpha) * ppr[v];
+                continue;
+            }
+            for (auto j = offsets[v]; j < offsets[v + 1]; j++)
+                next[edges[j]] += (1 - alpha) * ppr[v] / degree;
+        }
+        ppr.swap(next);
+    }
+    return ppr;
+}
+
+template<int WIDTH>
+bool checkLane(const PersonalizedPageRankT<WIDTH>& ppr, int lane,
+               const std::vector<double>& exact, int nV) {
+    std::vector<ppr_t> scores(nV), residuals(nV);
+    ppr.copyScoresToHost(lane, scores.data());
+    ppr.copyResidualsToHost(lane, residuals.data());
+    double residual_sum = std::accumulate(residuals.begin(),
+                                          residuals.end(), 0.0);
+    for (vid_t v = 0; v < nV; v++) {
+        double error = exact[v] - scores[v];
+        if (error < -1e-4 || error > residual_sum + 1e-4) {
+            std::cout << "lane " << lane << "  vertex " << v << "  exact: "
+                      << exact[v] << "  push: " << scores[v] << "\n";
+            return false;
+        }
+    }
+    return true;
+}
+
+int exec(int argc, char* argv[]) {
+    using namespace graph::parsing_prop;
+
+    graph::GraphStd<vid_t, eoff_t> graph;
+    graph.read(argv[1], PRINT_INFO | SORT);
+    ppr_t alpha   = 0.15f;
+    ppr_t epsilon = argc > 2 ? std::stof(argv[2]) : 1e-6f;
+    int   checked = argc > 3 ? std::stoi(argv[3]) : 4;
+
+    HornetInit hornet_init(graph.nV(), graph.nE(), graph.csr_out_offsets(),
+                           graph.csr_out_edges());
+    HornetGraph hornet_graph(hornet_init);
+
+    std::mt19937 gen(0);
+    std::uniform_int_distribution<vid_t> distribution(0, graph.nV() - 1);
+    std::vector<vid_t> seeds(BATCH_WIDTH);
+    for (auto& seed : seeds)
+        seed = distribution(gen);
+
+    Timer<DEVICE> TM;
+    bool is_correct = true;
+
+    PersonalizedPageRank single(hornet_graph, alpha, epsilon);
+    float single_time = 0;
+    for (int i = 0; i < BATCH_WIDTH; i++) {
+        single.set_seeds(&seeds[i], 1);
+        TM.start();
+        single.run();
+        TM.stop();
+        single_time += TM.duration();
+        if (i < checked) {
+            is_correct &= single.validate();
+            is_correct &= checkLane(single, 0, hostPpr(graph, seeds[i], alpha),
+                                    graph.nV());
+        }
+    }
+
+    PersonalizedPageRankBatch<BATCH_WIDTH> batch(hornet_graph, alpha, epsilon);
+    batch.set_seeds(seeds.data(), BATCH_WIDTH);
+    TM.start();
+    batch.run();
+    TM.stop();
+    is_correct &= batch.validate();
+    for (int lane = 0; lane < checked; lane++) {
+        is_correct &= checkLane(batch, lane,
+                                hostPpr(graph, seeds[lane], alpha),
+                                graph.nV());
+    }
+
+    std::cout << "Single seed:  " << single_time << " ms  "
+              << BATCH_WIDTH * 1000.0f / single_time << " queries/s\n"
+              << "Batched (" << BATCH_WIDTH << "): " << TM.duration()
+              << " ms  " << BATCH_WIDTH * 1000.0f / TM.duration()
+              << " queries/s  sweeps: " << batch.sweeps()
+              << "  pushed vertices: " << batch.pushed_vertices() << "\n";
+
+    std::cout << (is_correct ? "PASSED" : "NOT PASSED") << std::endl;
+    return !is_correct;
+}
+
+int main(int argc, char* argv[]) {
+    int ret = 0;
+    {
+        ret = exec(argc, argv);
+    }
+    return ret;
+}
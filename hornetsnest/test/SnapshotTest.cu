@@ -0,0 +1,139 @@
+/**
+ * @brief Graph snapshot test program
+ * @file
+ */
+#include "TestGraph.cuh"
+#include <Device/Util/Timer.cuh>
+#include <Graph/GraphStd.hpp>
+#include <Util/BatchFunctions.hpp>
+#include <vector>
+
+using namespace timer;
+using namespace hornets_nest;
+
+using HornetGraph = ::hornet::gpu::Hornet<vid_t>;
+using HornetInit  = ::hornet::HornetInit<vid_t>;
+using BatchUpdate = ::hornet::gpu::BatchUpdate<vid_t>;
+using UpdatePtr   = ::hornet::BatchUpdatePtr<vid_t, ::hornet::EMPTY,
+                                             ::hornet::DeviceType::HOST>;
+
+struct EdgeChecksum {
+    unsigned long long* d_checksums;
+
+    OPERATOR(Vertex& vertex, Edge& edge) {
+        unsigned long long dst = edge.dst_id();
+        atomicAdd(d_checksums + vertex.id(), dst * dst + 1);
+    }
+};
+
+//degree and sum of the adjacency list of every vertex
+template<typename HornetClass>
+std::vector<unsigned long long> getState(HornetClass& hornet) {
+    load_balancing::BinarySearch load_balancing(hornet);
+    thrust::device_vector<unsigned long long> d_checksums(hornet.nV(), 0);
+    forAllEdges(hornet, EdgeChecksum { d_checksums.data().get() },
+                load_balancing);
+
+    auto h_degrees = getDegrees(hornet);
+    std::vector<unsigned long long> state(hornet.nV());
+    thrust::copy(d_checksums.begin(), d_checksums.end(), state.begin());
+    for (int i = 0; i < hornet.nV(); i++)
+        state[i] = state[i] * 31 + h_degrees[i];
+    return state;
+}
+
+int exec(int argc, char* argv[]) {
+    using namespace graph::parsing_prop;
+
+    graph::GraphStd<vid_t, eoff_t> graph;
+    graph.read(argv[1], PRINT_INFO | SORT);
+    int batch_size = argc > 2 ? std::stoi(argv[2]) : 100000;
+
+    HornetInit hornet_init(graph.nV(), graph.nE(), graph.csr_out_offsets(),
+                           graph.csr_out_edges());
+    HornetGraph hornet_graph(hornet_init);
+    HornetGraph reference(hornet_init);
+
+    int erase_size  = batch_size;
+    int insert_size = batch_size;
+    std::vector<vid_t> erase_src(batch_size), erase_dst(batch_size);
+    std::vector<vid_t> insert_src(batch_size), insert_dst(batch_size);
+    generateBatch(graph, erase_size, erase_src.data(), erase_dst.data(),
+                  BatchGenType::REMOVE);
+    generateBatch(graph, insert_size, insert_src.data(), insert_dst.data(),
+                  BatchGenType::INSERT);
+
+    auto initial_state = getState(reference);
+
+    Timer<DEVICE> TM;
+    TM.start();
+    auto snapshot = hornet_graph.snapshot();
+    TM.stop();
+    TM.print("snapshot");
+
+    bool is_correct = hornet_graph.num_snapshots() == 1 &&
+                      snapshot.version() == hornet_graph.version() &&
+                      snapshot.nE() == hornet_graph.nE();
+
+    //erase (copy-on-write) and insert while the snapshot is alive
+    BatchUpdate erase_batch(UpdatePtr(erase_size, erase_src.data(),
+                                      erase_dst.data()));
+    TM.start();
+    hornet_graph.erase(erase_batch, true);
+    TM.stop();
+    TM.print("erase with snapshot");
+
+    BatchUpdate insert_batch(UpdatePtr(insert_size, insert_src.data(),
+                                       insert_dst.data()));
+    auto update = hornet_graph.insert_async(insert_batch, 0, true, true);
+    //the snapshot can be read while the update is applied
+    auto snapshot_state = getState(snapshot);
+    update.wait();
+
+    is_correct &= snapshot_state == initial_state;
+    is_correct &= getState(snapshot) == initial_state;
+    is_correct &= snapshot.nE() == reference.nE();
+    is_correct &= hornet_graph.num_retired_blocks() > 0;
+
+    //same updates without snapshots
+    BatchUpdate ref_erase(UpdatePtr(erase_size, erase_src.data(),
+                                    erase_dst.data()));
+    BatchUpdate ref_insert(UpdatePtr(insert_size, insert_src.data(),
+                                     insert_dst.data()));
+    reference.erase(ref_erase, true);
+    reference.insert(ref_insert, true, true);
+    is_correct &= reference.num_retired_blocks() == 0;
+    is_correct &= hornet_graph.nE() == reference.nE() &&
+                  getState(hornet_graph) == getState(reference);
+
+    std::cout << "retired blocks: " << hornet_graph.num_retired_blocks()
+              << "\n";
+    snapshot.release();
+    is_correct &= hornet_graph.num_snapshots() == 0 &&
+                  hornet_graph.num_retired_blocks() == 0;
+
+    //keep-sorted insert: the adjacency lists are merged in place
+    hornet_graph.set_keep_sorted(true);
+    {
+        auto sorted_snapshot = hornet_graph.snapshot();
+        auto sorted_state    = getState(hornet_graph);
+        BatchUpdate reinsert(UpdatePtr(erase_size, erase_src.data(),
+                                       erase_dst.data()));
+        hornet_graph.insert(reinsert, true, true);
+        is_correct &= getState(sorted_snapshot) == sorted_state &&
+                      getState(hornet_graph) != sorted_state;
+    }
+    is_correct &= hornet_graph.num_snapshots() == 0 &&
+                  hornet_graph.num_retired_blocks() == 0;
+
+    std::cout << (is_correct ? "PASSED" : "NOT PASSED") << std::endl;
+    return !is_correct;
+}
+
+int main(int argc, char* argv[]) {
+    int ret = 0;
+    {
+        ret = exec(argc, argv);
+    }
+    return ret;
+}
@@ -0,0 +1,160 @@
+/**
+ * @brief Sorted adjacency list update test program
+ * @file
+ */
+#include "HornetAlg.hpp"
+#include <Core/BatchUpdate/SortedMerge.hpp>
+#include <Device/Util/Timer.cuh>
+#include <Graph/GraphStd.hpp>
+#include <Util/BatchFunctions.hpp>
+#include <algorithm>
+#include <vector>
+
+using namespace timer;
+using namespace hornets_nest;
+
+using HornetGraph = ::hornet::gpu::Hornet<vid_t>;
+using HornetInit  = ::hornet::HornetInit<vid_t>;
+using BatchUpdate = ::hornet::gpu::BatchUpdate<vid_t>;
+using UpdatePtr   = ::hornet::BatchUpdatePtr<vid_t, ::hornet::EMPTY,
+                                             ::hornet::DeviceType::HOST>;
+
+//position-dependent checksum of every adjacency list, 0 if not sorted
+struct SortedChecksum {
+    unsigned long long* d_checksums;
+
+    OPERATOR(Vertex& vertex) {
+        unsigned long long checksum = 1;
+        for (degree_t i = 0; i < vertex.degree(); i++) {
+            vid_t dst = vertex.edge(i).dst_id();
+            if (i > 0 && vertex.edge(i - 1).dst_id() > dst) {
+                checksum = 0;
+                break;
+            }
+            checksum += (dst + 1ull) * (i + 1ull);
+        }
+        d_checksums[vertex.id()] = checksum;
+    }
+};
+
+std::vector<unsigned long long> getChecksums(HornetGraph& hornet) {
+    thrust::device_vector<unsigned long long> d_checksums(hornet.nV());
+    forAllVertices(hornet, SortedChecksum { d_checksums.data().get() });
+    std::vector<unsigned long long> h_checksums(hornet.nV());
+    thrust::copy(d_checksums.begin(), d_checksums.end(), h_checksums.begin());
+    return h_checksums;
+}
+
+std::vector<unsigned long long>
+getChecksums(const std::vector<std::vector<vid_t>>& lists) {
+    std::vector<unsigned long long> checksums(lists.size());
+    for (size_t v = 0; v < lists.size(); v++) {
+        unsigned long long checksum = 1;
+        for (size_t i = 0; i < lists[v].size(); i++)
+            checksum += (lists[v][i] + 1ull) * (i + 1ull);
+        checksums[v] = checksum;
+    }
+    return checksums;
+}
+
+//distinct destinations of the batch for every source
+std::vector<std::vector<vid_t>>
+groupBatch(int nV, int batch_size, const vid_t* src, const vid_t* dst) {
+    std::vector<std::vector<vid_t>> groups(nV);
+    for (int i = 0; i < batch_size; i++)
+        groups[src[i]].push_back(dst[i]);
+    for (auto& group : groups) {
+        std::sort(group.begin(), group.end());
+        group.erase(std::unique(group.begin(), group.end()), group.end());
+    }
+    return groups;
+}
+
+int exec(int argc, char* argv[]) {
+    using namespace graph::parsing_prop;
+
+    graph::GraphStd<vid_t, eoff_t> graph;
+    graph.read(argv[1], PRINT_INFO | SORT);
+    int batch_size = argc > 2 ? std::stoi(argv[2]) : 100000;
+    int nV = graph.nV();
+
+    HornetInit hornet_init(graph.nV(), graph.nE(), graph.csr_out_offsets(),
+                           graph.csr_out_edges());
+    HornetGraph hornet_graph(hornet_init);
+    hornet_graph.set_keep_sorted(true);
+
+    //host reference
+    std::vector<std::vector<vid_t>> lists(nV);
+    auto offsets = graph.csr_out_offsets();
+    auto edges   = graph.csr_out_edges();
+    for (vid_t v = 0; v < nV; v++)
+        lists[v].assign(edges + offsets[v], edges + offsets[v + 1]);
+
+    bool is_correct = hornet_graph.is_keep_sorted() &&
+                      getChecksums(hornet_graph) == getChecksums(lists);
+
+    int erase_size  = batch_size;
+    int insert_size = batch_size;
+    std::vector<vid_t> erase_src(batch_size), erase_dst(batch_size);
+    std::vector<vid_t> insert_src(batch_size), insert_dst(batch_size);
+    generateBatch(graph, erase_size, erase_src.data(), erase_dst.data(),
+                  BatchGenType::REMOVE);
+    generateBatch(graph, insert_size, insert_src.data(), insert_dst.data(),
+                  BatchGenType::INSERT);
+
+    BatchUpdate erase_batch(UpdatePtr(erase_size, erase_src.data(),
+                                      erase_dst.data()));
+    Timer<DEVICE> TM;
+    TM.start();
+    hornet_graph.erase(erase_batch, true);
+    TM.stop();
+    TM.print("sorted erase");
+
+    auto erased = groupBatch(nV, erase_size, erase_src.data(),
+                             erase_dst.data());
+    for (vid_t v = 0; v < nV; v++) {
+        auto degree = ::hornet::host::erase_sorted_adjacency(lists[v].data(),
+                static_cast<int>(lists[v].size()), erased[v].data(),
+                static_cast<int>(erased[v].size()));
+        lists[v].resize(degree);
+    }
+    is_correct &= getChecksums(hornet_graph) == getChecksums(lists);
+
+    BatchUpdate insert_batch(UpdatePtr(insert_size, insert_src.data(),
+                                       insert_dst.data()));
+    TM.start();
+    hornet_graph.insert(insert_batch, true, true);
+    TM.stop();
+    TM.print("sorted insert");
+
+    //the edges already in the graph are not inserted
+    auto inserted = groupBatch(nV, insert_size, insert_src.data(),
+                               insert_dst.data());
+    int nE = 0;
+    for (vid_t v = 0; v < nV; v++) {
+        auto& batch = inserted[v];
+        batch.erase(std::remove_if(batch.begin(), batch.end(),
+                [&](vid_t dst) {
+                    return std::binary_search(lists[v].begin(),
+                                              lists[v].end(), dst);
+                }), batch.end());
+        int degree = lists[v].size();
+        lists[v].resize(degree + batch.size());
+        ::hornet::host::merge_sorted_adjacency(lists[v].data(), degree,
+                batch.data(), static_cast<int>(batch.size()));
+        nE += lists[v].size();
+    }
+    is_correct &= hornet_graph.nE() == nE &&
+                  getChecksums(hornet_graph) == getChecksums(lists);
+
+    std::cout << (is_correct ? "PASSED" : "NOT PASSED") << std::endl;
+    return !is_correct;
+}
+
+int main(int argc, char* argv[]) {
+    int ret = 0;
+    {
+        ret = exec(argc, argv);
+    }
+    return ret;
+}
@@ -0,0 +1,77 @@
+/**
+ * @brief Streaming workload generator test program
+ * @file
+ */
+#include "HornetAlg.hpp"
+#include <Device/Util/Timer.cuh>
+#include <Util/StreamGenerator.hpp>
+
+using namespace timer;
+using namespace hornets_nest;
+
+using HornetGraph = ::hornet::gpu::Hornet<vid_t>;
+using BatchUpdate = ::hornet::gpu::BatchUpdate<vid_t>;
+using UpdatePtr   = ::hornet::BatchUpdatePtr<vid_t, ::hornet::EMPTY,
+                                             ::hornet::DeviceType::HOST>;
+
+UpdatePtr toUpdatePtr(EdgeBatch& edges) {
+    return UpdatePtr(edges.size(), edges.src.data(), edges.dst.data());
+}
+
+int exec(int argc, char* argv[]) {
+    int scale      = argc > 1 ? std::stoi(argv[1]) : 16;
+    int batch_size = argc > 2 ? std::stoi(argv[2]) : 10000;
+    vid_t nV = 1 << scale;
+
+    //same seed, same graph
+    Timer<HOST> TM;
+    TM.start();
+    auto rmat = generateRMat(scale, 16 * nV, 42);
+    TM.stop();
+    TM.print("R-MAT");
+    auto rmat2 = generateRMat(scale, 16 * nV, 42);
+    auto rmat3 = generateRMat(scale, 16 * nV, 43);
+    bool is_correct = rmat.src == rmat2.src && rmat.dst == rmat2.dst &&
+                      rmat.src != rmat3.src;
+
+    HornetGraph hornet_graph(nV);
+    BatchUpdate rmat_batch(toUpdatePtr(rmat));
+    hornet_graph.insert(rmat_batch, true, true);
+    is_correct &= hornet_graph.nE() > 0 && hornet_graph.nE() <= rmat.size();
+
+    //mixed stream with expiry on an empty graph: the graph follows the
+    //live edges of the stream
+    UpdateStreamConfig config;
+    config.seed         = 7;
+    config.insert_ratio = 0.7;
+    config.window       = 4;
+    UpdateStream stream(nV, config);
+    HornetGraph stream_graph(nV);
+    for (int i = 0; i < 10; i++) {
+        auto update = stream.next(batch_size);
+        if (update.deletions.size() != 0) {
+            BatchUpdate erase_batch(toUpdatePtr(update.deletions));
+            stream_graph.erase(erase_batch);
+        }
+        BatchUpdate insert_batch(toUpdatePtr(update.insertions));
+        stream_graph.insert(insert_batch);
+        is_correct &= stream_graph.nE() == stream.num_live_edges();
+    }
+
+    PreferentialAttachmentStream pa_stream(4, 3, 7);
+    auto pa_edges = pa_stream.next(nV - 4);
+    is_correct &= pa_stream.nV() == nV && pa_edges.size() == 3 * (nV - 4);
+
+    std::cout << "R-MAT edges: " << hornet_graph.nE()
+              << "  stream edges: " << stream.num_live_edges() << "\n";
+    std::cout << (is_correct ? "PASSED" : "NOT PASSED") << std::endl;
+    return !is_correct;
+}
+
+int main(int argc, char* argv[]) {
+    int ret = 0;
+    {
+        ret = exec(argc, argv);
+    }
+    return ret;
+}
@@ -0,0 +1,86 @@
+/**
+ * @brief Induced and edge-filtered subgraph extraction test program
+ * @file
+ */
+#include "TestGraph.cuh"
+#include <Graph/GraphStd.hpp>
+#include <Util/Subgraph.hpp>
+#include <thrust/copy.h>
+#include <vector>
+
+using namespace hornets_nest;
+
+using HornetGraph = ::hornet::gpu::Hornet<vid_t>;
+using HornetInit  = ::hornet::HornetInit<vid_t>;
+using HornetCSR   = ::hornet::gpu::HornetStatic<vid_t>;
+using SubgraphT   = HornetGraph::SubgraphT;
+
+struct ForwardEdge {
+    template <typename Vertex, typename Edge>
+    __device__ __forceinline__
+    bool operator()(Vertex& vertex, Edge& edge) const {
+        return vertex.id() < edge.dst_id() && edge.dst_id() % 3 == 0;
+    }
+};
+
+template <typename T>
+std::vector<T> toHost(const T* d_ptr, size_t size) {
+    std::vector<T> h_vector(size);
+    thrust::copy(thrust::device_pointer_cast(d_ptr),
+                 thrust::device_pointer_cast(d_ptr) + size, h_vector.begin());
+    return h_vector;
+}
+
+bool equal(SubgraphT& sub, const HostSubgraph& host) {
+    return sub.nV() == host.nV() && sub.nE() == host.nE() &&
+           toHost(sub.csr_offsets(), sub.nV() + 1) == host.offsets &&
+           toHost(sub.csr_edges(), sub.nE()) == host.edges &&
+           toHost(sub.id_map().data().get(), sub.id_map().size()) ==
+               host.id_map;
+}
+
+int exec(int argc, char* argv[]) {
+    const vid_t nV = 256;
+    std::vector<degree_t> offsets;
+    std::vector<vid_t>    edges;
+    skewedGraph(nV, 13, 1, offsets, edges);
+    HornetInit  hornet_init(nV, edges.size(), offsets.data(), edges.data());
+    HornetGraph hornet(hornet_init);
+    graph::GraphStd<> graph(offsets.data(), nV, edges.data(), edges.size());
+
+    //unsorted, with duplicates
+    std::vector<vid_t> tenant;
+    for (vid_t v = nV - 1; v >= 0; v -= 3)
+        tenant.push_back(v);
+    tenant.push_back(tenant.front());
+
+    bool is_correct = true;
+    for (bool relabel : { true, false }) {
+        auto sub = hornet.induced_subgraph(tenant.data(), tenant.size(),
+                                           relabel);
+        is_correct &= equal(sub, inducedSubgraph(graph, tenant, relabel));
+
+        auto filtered = hornet.filter_edges(ForwardEdge(), relabel);
+        is_correct &= equal(filtered, filterEdges(graph,
+                                [](vert_t src, vert_t dst) {
+                                    return src < dst && dst % 3 == 0;
+                                }, relabel));
+    }
+
+    //compact CSR without a host copy
+    auto sub  = hornet.induced_subgraph(tenant.data(), tenant.size());
+    auto init = sub.init();
+    HornetCSR hornet_csr(init, ::hornet::DeviceType::DEVICE);
+    is_correct &= hornet_csr.nV() == sub.nV() && hornet_csr.nE() == sub.nE();
+
+    std::cout << (is_correct ? "PASSED" : "NOT PASSED") << std::endl;
+    return !is_correct;
+}
+
+int main(int argc, char* argv[]) {
+    int ret = 0;
+    {
+        ret = exec(argc, argv);
+    }
+    return ret;
+}
@@ -0,0 +1,121 @@
+/**
+ * @brief Graph fixtures and checks shared by the test programs
+ * @file
+ */
+#ifndef HORNETS_NEST_TEST_GRAPH_CUH
+#define HORNETS_NEST_TEST_GRAPH_CUH
+
+#include "HornetAlg.hpp"
+#include <Core/HostGraph.cuh>
+#include <Graph/GraphStd.hpp>
+#include <Util/BatchFunctions.hpp>
+#include <vector>
+
+namespace hornets_nest {
+
+/**
+ * @brief CSR graph with skewed degrees: every 16th vertex has 200 edges, so
+ *        that erasing moves it to smaller blocks, the others `(v * 7) % 23`
+ * @details the k-th edge of `v` points to `(v + k * stride + shift) % nV`
+ *          and its value is `value(v, k, dst)`
+ */
+template <typename T, typename ValueOp>
+void skewedGraph(vid_t nV, degree_t stride, degree_t shift,
+                 std::vector<degree_t>& offsets, std::vector<vid_t>& edges,
+                 std::vector<T>& values, const ValueOp& value) {
+    offsets = { 0 };
+    edges.clear();
+    values.clear();
+    for (vid_t v = 0; v < nV; v++) {
+        degree_t degree = v % 16 == 0 ? 200 : (v * 7) % 23;
+        for (degree_t k = 0; k < degree; k++) {
+            edges.push_back((v + k * stride + shift) % nV);
+            values.push_back(value(v, k, edges.back()));
+        }
+        offsets.push_back(edges.size());
+    }
+}
+
+inline void skewedGraph(vid_t nV, degree_t stride, degree_t shift,
+                        std::vector<degree_t>& offsets,
+                        std::vector<vid_t>& edges) {
+    std::vector<char> values;
+    skewedGraph(nV, stride, shift, offsets, edges, values,
+                [](vid_t, degree_t, vid_t) { return 0; });
+}
+
+///same edges, in the same order, for every adjacency list
+template <typename T>
+bool equal(::hornet::gpu::Hornet<vid_t, ::hornet::EMPTY,
+                                 ::hornet::TypeList<T>>& hornet,
+           const ::hornet::host::HostGraph<vid_t, ::hornet::TypeList<T>>& host) {
+    using HostEdge = typename ::hornet::host::HostGraph<vid_t,
+                                        ::hornet::TypeList<T>>::EdgeT;
+    using HostCOO  = ::hornet::COO<::hornet::DeviceType::HOST, vid_t,
+                                   ::hornet::TypeList<T>>;
+    if (hornet.nE() != host.nE())
+        return false;
+    std::vector<std::vector<HostEdge>> adjacency(host.nV());
+    auto    d_coo = hornet.getCOO();
+    HostCOO h_coo(d_coo);
+    for (degree_t i = 0; i < h_coo.size(); i++) {
+        adjacency[h_coo.srcPtr()[i]].emplace_back(h_coo.dstPtr()[i],
+                h_coo.template edgeMetaPtr<0>()[i]);
+    }
+    for (vid_t v = 0; v < host.nV(); v++) {
+        if (adjacency[v] != host.adjacency(v))
+            return false;
+    }
+    return true;
+}
+
+/**
+ * @brief random batch of an undirected graph: every edge is stored in both
+ *        directions
+ * @details the self-loops are dropped: they do not close any triangle and
+ *          are ignored by the core maintenance
+ */
+inline void symmetricBatch(const graph::GraphStd<vid_t, eoff_t>& graph,
+                           int batch_size, const BatchGenType& batch_type,
+                           std::vector<vid_t>& batch_src,
+                           std::vector<vid_t>& batch_dst) {
+    batch_src.resize(batch_size * 2);
+    batch_dst.resize(batch_size * 2);
+    generateBatch(graph, batch_size, batch_src.data(), batch_dst.data(),
+                  batch_type);
+    int size = 0;
+    for (int i = 0; i < batch_size; i++) {
+        if (batch_src[i] == batch_dst[i])
+            continue;
+        batch_src[size] = batch_src[i];
+        batch_dst[size] = batch_dst[i];
+        size++;
+    }
+    batch_src.resize(size * 2);
+    batch_dst.resize(size * 2);
+    for (int i = 0; i < size; i++) {
+        batch_src[size + i] = batch_dst[i];
+        batch_dst[size + i] = batch_src[i];
+    }
+}
+
+struct GetDegree {
+    int* d_degrees;
+
+    OPERATOR(Vertex& vertex) {
+        d_degrees[vertex.id()] = vertex.degree();
+    }
+};
+
+///degree of every vertex of a graph or of a snapshot
+template <typename HornetClass>
+std::vector<int> getDegrees(HornetClass& hornet) {
+    thrust::device_vector<int> d_degrees(hornet.nV());
+    forAllVertices(hornet, GetDegree { d_degrees.data().get() });
+    std::vector<int> h_degrees(hornet.nV());
+    thrust::copy(d_degrees.begin(), d_degrees.end(), h_degrees.begin());
+    return h_degrees;
+}
+
+} // namespace hornets_nest
+#endif
@@ -0,0 +1,113 @@
+/**
+ * @brief Top-K selection test program
+ * @file
+ */
+#include "HornetAlg.hpp"
+#include <Device/Primitives/CubWrapper.cuh>
+#include <Device/Util/Timer.cuh>
+#include <thrust/sequence.h>
+#include <algorithm>
+#include <functional>
+#include <random>
+#include <vector>
+
+using namespace timer;
+using namespace hornets_nest;
+
+int exec(int argc, char* argv[]) {
+    int num_items = argc > 1 ? std::stoi(argv[1]) : (1 << 24);
+    int k         = argc > 2 ? std::stoi(argv[2]) : 100;
+
+    //few distinct values: many ties at the threshold
+    std::mt19937_64 gen(0);
+    std::uniform_int_distribution<int> distribution(0, num_items / 8);
+    std::vector<double> h_keys(num_items);
+    for (auto& key : h_keys)
+        key = distribution(gen) * 0.5 - num_items / 32;
+
+    thrust::device_vector<double> d_keys(h_keys);
+    thrust::device_vector<int>    d_ids(k);
+    thrust::device_vector<double> d_sorted(num_items);
+    thrust::device_vector<int>    d_all_ids(num_items);
+    thrust::device_vector<int>    d_sorted_ids(num_items);
+    thrust::sequence(d_all_ids.begin(), d_all_ids.end());
+
+    std::vector<double> sorted(h_keys);
+    std::sort(sorted.begin(), sorted.end(), std::greater<double>());
+    double expected = sorted[k - 1];
+
+    Timer<DEVICE> TM;
+    TopK<double> top_k(num_items);
+    TM.start();
+    double threshold = top_k.select(d_keys.data().get(),
+                                    static_cast<const int*>(nullptr),
+                                    num_items, k, d_ids.data().get());
+    TM.stop();
+    TM.print("Device top-k:");
+
+    TM.start();
+    xlib::CubSortByKey<double, int>::srun(d_keys.data().get(),
+                                          d_all_ids.data().get(), num_items,
+                                          d_sorted.data().get(),
+                                          d_sorted_ids.data().get());
+    TM.stop();
+    TM.print("Device full sort:");
+
+    Timer<HOST> TM_host;
+    std::vector<int> h_ids(k);
+    TM_host.start();
+    double h_threshold = host::topK(h_keys.data(),
+                                    static_cast<const int*>(nullptr),
+                                    num_items, k, h_ids.data());
+    TM_host.stop();
+    TM_host.print("Host top-k:");
+
+    //the selected keys must be the K largest ones
+    std::vector<int> d_selected(k);
+    gpu::copyToHost(d_ids.data().get(), k, d_selected.data());
+    auto check = [&](const std::vector<int>& ids) {
+        std::vector<double> selected;
+        for (auto id : ids)
+            selected.push_back(h_keys[id]);
+        std::sort(selected.begin(), selected.end(), std::greater<double>());
+        return std::equal(selected.begin(), selected.end(), sorted.begin());
+    };
+    bool is_correct = threshold == expected && h_threshold == expected &&
+                      check(d_selected) && check(h_ids);
+
+    //-0.0 and +0.0 are the same key: the two largest and two zeros
+    std::vector<float> h_zeros = { 1, -0.0f, 0.0f, 2, -0.0f, -1, 0.0f };
+    thrust::device_vector<float> d_zeros(h_zeros);
+    thrust::device_vector<int>   d_zero_ids(4, -1);
+    TopK<float> top_k_zeros;
+    float zero = top_k_zeros.select(d_zeros.data().get(),
+                                    static_cast<const int*>(nullptr),
+                                    static_cast<int>(h_zeros.size()), 4,
+                                    d_zero_ids.data().get());
+    std::vector<int> zero_ids(4);
+    gpu::copyToHost(d_zero_ids.data().get(), 4, zero_ids.data());
+    std::sort(zero_ids.begin(), zero_ids.end());
+    is_correct &= zero == 0 && zero_ids.front() >= 0 &&
+                  zero_ids.back() < static_cast<int>(h_zeros.size()) &&
+                  std::unique(zero_ids.begin(), zero_ids.end()) ==
+                  zero_ids.end();
+    if (is_correct) {
+        std::vector<float> zero_keys;
+        for (auto id : zero_ids)
+            zero_keys.push_back(h_zeros[id]);
+        std::sort(zero_keys.begin(), zero_keys.end(), std::greater<float>());
+        is_correct &= zero_keys == std::vector<float> { 2, 1, 0, 0 };
+    }
+
+    std::cout << "K-th largest: " << threshold << "\n"
+              << (is_correct ? "PASSED" : "NOT PASSED") << std::endl;
+    return !is_correct;
+}
+
+int main(int argc, char* argv[]) {
+    int ret = 0;
+    {
+        ret = exec(argc, argv);
+    }
+    return ret;
+}
@@ -0,0 +1,172 @@
+/**
+ * @brief Update trace record/replay program
+ * @file
+ *
+ * record <trace> [scale] [batch_size] [num_batches] [seed]
+ *      applies a mixed update stream to a Hornet and records it
+ * replay <trace> <nV> [gpu|host|both]
+ *      applies the trace to the device and/or host graph, with per-batch
+ *      latency percentiles, throughput and memory growth
+ */
+#include "HornetAlg.hpp"
+#include <Core/HostGraph.cuh>
+#include <Core/UpdateTrace.cuh>
+#include <Device/Util/Timer.cuh>
+#include <Util/BenchmarkReport.hpp>
+#include <Util/StreamGenerator.hpp>
+#include <algorithm>
+#include <numeric>
+#include <string>
+#include <vector>
+
+using namespace timer;
+using namespace hornets_nest;
+
+using HornetGraph = ::hornet::gpu::Hornet<vid_t>;
+using HostGraph   = ::hornet::host::HostGraph<vid_t>;
+using BatchUpdate = ::hornet::gpu::BatchUpdate<vid_t>;
+using UpdatePtr   = ::hornet::BatchUpdatePtr<vid_t, ::hornet::EMPTY,
+                                             ::hornet::DeviceType::HOST>;
+using TraceWriter = ::hornet::UpdateTraceWriter<vid_t>;
+using TraceReader = ::hornet::UpdateTraceReader<vid_t>;
+using ::hornet::TraceOp;
+
+UpdatePtr toUpdatePtr(EdgeBatch& edges) {
+    return UpdatePtr(edges.size(), edges.src.data(), edges.dst.data());
+}
+
+struct ReplayStats {
+    std::vector<float> latency;     //ms
+    size_t             num_edges   { 0 };
+    size_t             init_memory { 0 };
+    size_t             peak_memory { 0 };
+
+    void print(const char* backend) {
+        if (latency.empty())
+            return;
+        auto sorted = latency;
+        std::sort(sorted.begin(), sorted.end());
+        float total = std::accumulate(sorted.begin(), sorted.end(), 0.0f);
+        std::cout << backend << "  batches: " << sorted.size()
+                  << "  p50: " << percentile(sorted, 0.50) << " ms"
+                  << "  p95: " << percentile(sorted, 0.95) << " ms"
+                  << "  p99: " << percentile(sorted, 0.99) << " ms"
+                  << "  throughput: " << num_edges / (total / 1000.0f)
+                  << " edges/s  memory: " << init_memory << " -> "
+                  << peak_memory << " B\n";
+    }
+};
+
+int record(const std::string& filename, int scale, int batch_size,
+           int num_batches, uint64_t seed) {
+    vid_t nV = 1 << scale;
+    UpdateStreamConfig config;
+    config.seed   = seed;
+    config.window = 8;
+    UpdateStream stream(nV, config);
+
+    HornetGraph hornet_graph(nV);
+    TraceWriter writer(filename);
+    hornet_graph.record_updates(&writer);
+    for (int i = 0; i < num_batches; i++) {
+        auto update = stream.next(batch_size);
+        if (update.deletions.size() != 0) {
+            BatchUpdate erase_batch(toUpdatePtr(update.deletions));
+            hornet_graph.erase(erase_batch);
+        }
+        BatchUpdate insert_batch(toUpdatePtr(update.insertions));
+        hornet_graph.insert(insert_batch);
+    }
+    hornet_graph.record_updates(nullptr);
+
+    bool is_correct = hornet_graph.nE() == stream.num_live_edges() &&
+                      writer.num_batches() > 0;
+    std::cout << "nV: " << nV << "  nE: " << hornet_graph.nE()
+              << "  recorded batches: " << writer.num_batches() << "\n";
+    std::cout << (is_correct ? "PASSED" : "NOT PASSED") << std::endl;
+    return !is_correct;
+}
+
+int replay(const std::string& filename, vid_t nV, const std::string& backend) {
+    bool use_gpu  = backend != "host";
+    bool use_host = backend != "gpu";
+    HornetGraph hornet_graph(nV);
+    HostGraph   host_graph(nV);
+    ReplayStats gpu_stats, host_stats;
+    gpu_stats.init_memory  = gpu_stats.peak_memory  = hornet_graph.memory_bytes();
+    host_stats.init_memory = host_stats.peak_memory = host_graph.memory_bytes();
+
+    TraceReader reader(filename);
+    TraceReader::Batch batch;
+    bool is_correct = true;
+    Timer<DEVICE> TM;
+    Timer<HOST>   TM_host;
+    while (reader.next(batch)) {
+        if (use_gpu) {
+            //the device copy of the batch is not part of the latency
+            BatchUpdate update(batch.ptr());
+            TM.start();
+            if (batch.op == TraceOp::INSERT) {
+                hornet_graph.insert(update, batch.removeBatchDuplicates,
+                                    batch.removeGraphDuplicates);
+            } else {
+                hornet_graph.erase(update, batch.removeBatchDuplicates);
+            }
+            TM.stop();
+            gpu_stats.latency.push_back(TM.duration());
+            gpu_stats.num_edges  += batch.nE;
+            gpu_stats.peak_memory = std::max(gpu_stats.peak_memory,
+                                             hornet_graph.memory_bytes());
+        }
+        if (use_host) {
+            TM_host.start();
+            if (batch.op == TraceOp::INSERT) {
+                host_graph.insert(batch.ptr(), batch.removeBatchDuplicates,
+                                  batch.removeGraphDuplicates);
+            } else {
+                host_graph.erase(batch.ptr(), batch.removeBatchDuplicates);
+            }
+            TM_host.stop();
+            host_stats.latency.push_back(TM_host.duration());
+            host_stats.num_edges  += batch.nE;
+            host_stats.peak_memory = std::max(host_stats.peak_memory,
+                                              host_graph.memory_bytes());
+        }
+        if (use_gpu && use_host)
+            is_correct &= hornet_graph.nE() == host_graph.nE();
+    }
+    gpu_stats.print("gpu ");
+    host_stats.print("host");
+    std::cout << (is_correct ? "PASSED" : "NOT PASSED") << std::endl;
+    return !is_correct;
+}
+
+int exec(int argc, char* argv[]) {
+    if (argc < 3) {
+        std::cerr << "usage: " << argv[0] << " record <trace> [scale] "
+                  << "[batch_size] [num_batches] [seed]\n       " << argv[0]
+                  << " replay <trace> <nV> [gpu|host|both]\n";
+        return 1;
+    }
+    std::string mode     = argv[1];
+    std::string filename = argv[2];
+    if (mode == "record") {
+        int scale       = argc > 3 ? std::stoi(argv[3]) : 16;
+        int batch_size  = argc > 4 ? std::stoi(argv[4]) : 10000;
+        int num_batches = argc > 5 ? std::stoi(argv[5]) : 32;
+        uint64_t seed   = argc > 6 ? std::stoull(argv[6]) : 0;
+        return record(filename, scale, batch_size, num_batches, seed);
+    }
+    if (mode == "replay" && argc > 3)
+        return replay(filename, std::stoi(argv[3]), argc > 4 ? argv[4] : "both");
+    std::cerr << "unknown mode: " << mode << "\n";
+    return 1;
+}
+
+int main(int argc, char* argv[]) {
+    int ret = 0;
+    {
+        ret = exec(argc, argv);
+    }
+    return ret;
+}
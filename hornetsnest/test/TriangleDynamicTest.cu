@@ -0,0 +1,74 @@
+/**
+ * @brief Dynamic triangle counting test program
+ * @file
+ */
+#include "TestGraph.cuh"
+#include <StandardAPI.hpp>
+#include <Util/CommandLineParam.hpp>
+
+#include "Dynamic/TriangleCounting/TriangleDynamic.cuh"
+
+using namespace timer;
+using namespace hornets_nest;
+
+using UpdatePtr = ::hornet::BatchUpdatePtr<vid_t, ::hornet::EMPTY,
+                                           ::hornet::DeviceType::HOST>;
+
+int exec(int argc, char* argv[]) {
+    using namespace graph::structure_prop;
+    using namespace graph::parsing_prop;
+
+    graph::GraphStd<vid_t, eoff_t> graph(UNDIRECTED);
+    graph.read(argv[1], PRINT_INFO | SORT);
+    int batch_size = argc > 2 ? std::stoi(argv[2]) : 1000;
+
+    HornetInit hornet_init(graph.nV(), graph.nE(), graph.csr_out_offsets(),
+                           graph.csr_out_edges());
+    HornetGraph hornet_graph(hornet_init);
+
+    TriangleCountingDynamic tc(hornet_graph);
+    tc.run();
+    std::cout << "Initial triangles: " << tc.countTriangles() << "\n";
+
+    std::vector<vid_t> batch_src, batch_dst;
+    Timer<DEVICE> TM;
+    bool is_correct = true;
+
+    symmetricBatch(graph, batch_size, BatchGenType::INSERT,
+                   batch_src, batch_dst);
+    BatchUpdate insert_batch(UpdatePtr(batch_src.size(), batch_src.data(),
+                                       batch_dst.data()));
+    hornet_graph.insert(insert_batch, true, true);
+    hornet_graph.sort();
+
+    TM.start();
+    tc.insert(insert_batch);
+    TM.stop();
+    TM.print("Insertion update:");
+    std::cout << "Triangles after insertion: " << tc.countTriangles() << "\n";
+    is_correct &= tc.validate();
+
+    symmetricBatch(graph, batch_size, BatchGenType::REMOVE,
+                   batch_src, batch_dst);
+    BatchUpdate erase_batch(UpdatePtr(batch_src.size(), batch_src.data(),
+                                      batch_dst.data()));
+    TM.start();
+    tc.erase(erase_batch);
+    TM.stop();
+    TM.print("Deletion update:");
+    hornet_graph.erase(erase_batch);
+    hornet_graph.sort();
+    std::cout << "Triangles after deletion: " << tc.countTriangles() << "\n";
+    is_correct &= tc.validate();
+
+    std::cout << (is_correct ? "PASSED" : "NOT PASSED") << std::endl;
+    return !is_correct;
+}
+
+int main(int argc, char* argv[]) {
+    int ret = 0;
+    {
+        ret = exec(argc, argv);
+    }
+    return ret;
+}
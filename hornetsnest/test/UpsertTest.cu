@@ -0,0 +1,116 @@
+/**
+ * @brief Edge upsert test program
+ * @file
+ */
+#include "HornetAlg.hpp"
+#include <map>
+#include <utility>
+#include <vector>
+
+using namespace hornets_nest;
+
+using weight_t    = int;
+using HornetGraph = ::hornet::gpu::Hornet<vid_t, ::hornet::EMPTY,
+                                          ::hornet::TypeList<weight_t>>;
+using HornetInit  = ::hornet::HornetInit<vid_t, ::hornet::EMPTY,
+                                         ::hornet::TypeList<weight_t>>;
+using BatchUpdate = ::hornet::gpu::BatchUpdate<vid_t,
+                                               ::hornet::TypeList<weight_t>>;
+using UpdatePtr   = ::hornet::BatchUpdatePtr<vid_t,
+                                             ::hornet::TypeList<weight_t>,
+                                             ::hornet::DeviceType::HOST>;
+using HostCOO     = ::hornet::COO<::hornet::DeviceType::HOST, vid_t,
+                                  ::hornet::TypeList<weight_t>>;
+using EdgeMap     = std::map<std::pair<vid_t, vid_t>, weight_t>;
+using GraphChange = ::hornet::GraphChange<vid_t, degree_t>;
+
+EdgeMap getEdges(HornetGraph& hornet) {
+    auto    d_coo = hornet.getCOO();
+    HostCOO h_coo(d_coo);
+    EdgeMap edges;
+    for (degree_t i = 0; i < h_coo.size(); i++) {
+        edges[{ h_coo.srcPtr()[i], h_coo.dstPtr()[i] }] =
+            h_coo.edgeMetaPtr<0>()[i];
+    }
+    return edges;
+}
+
+/*
+ * counts the updated and the inserted edges of the change summaries
+ */
+class ChangeCounter : public ::hornet::GraphSubscriber<vid_t, degree_t> {
+public:
+    void graphChanged(const GraphChange& change) override {
+        if (change.type == ::hornet::GraphChangeType::UPDATE)
+            num_updated += change.num_edges;
+        else if (change.type == ::hornet::GraphChangeType::INSERT)
+            num_inserted += change.num_edges;
+    }
+
+    int num_updated  { 0 };
+    int num_inserted { 0 };
+};
+
+template <typename ReduceOp>
+void upsert(HornetGraph& hornet, std::vector<vid_t> src,
+            std::vector<vid_t> dst, std::vector<weight_t> weight,
+            const ReduceOp& op) {
+    UpdatePtr ptr(src.size(), src.data(), dst.data(), weight.data());
+    BatchUpdate batch(ptr);
+    hornet.upsert(batch, op);
+}
+
+int exec(int argc, char* argv[]) {
+    //0 -> 1 (1), 0 -> 2 (2), 1 -> 2 (3)
+    vid_t    offsets[] = { 0, 2, 3, 3 };
+    vid_t    edges[]   = { 1, 2, 2 };
+    weight_t weights[] = { 1, 2, 3 };
+    HornetInit hornet_init(3, 3, offsets, edges);
+    hornet_init.insertEdgeData(weights);
+    HornetGraph hornet(hornet_init);
+    ChangeCounter counter;
+    hornet.subscribe(&counter);
+
+    //existing edges are combined, new edges are inserted
+    upsert(hornet, { 0, 1, 1 }, { 1, 0, 2 }, { 10, 5, 4 },
+           ::hornet::UpsertSum());
+    EdgeMap expected = { { { 0, 1 }, 11 }, { { 0, 2 }, 2 },
+                         { { 1, 0 }, 5 },  { { 1, 2 }, 7 } };
+    bool is_correct = hornet.nE() == 4 && getEdges(hornet) == expected;
+    //the weight-only updates of 0 -> 1 and 1 -> 2 are reported
+    is_correct &= counter.num_updated == 2 && counter.num_inserted == 1;
+
+    upsert(hornet, { 0, 0 }, { 2, 1 }, { 1, 20 }, ::hornet::UpsertMax());
+    expected[{ 0, 1 }] = 20;
+    is_correct &= hornet.nE() == 4 && getEdges(hornet) == expected;
+
+    //duplicates of the batch: one edge is inserted, the last value wins
+    upsert(hornet, { 1, 2, 2 }, { 2, 0, 0 }, { 0, 8, 3 },
+           ::hornet::UpsertReplace());
+    expected[{ 1, 2 }] = 0;
+    expected[{ 2, 0 }] = 3;
+    is_correct &= hornet.nE() == 5 && getEdges(hornet) == expected;
+
+    //repeated interactions are all counted, new and existing edges
+    upsert(hornet, { 0, 2, 0, 0, 1, 1 }, { 1, 1, 1, 2, 1, 1 },
+           { 1, 4, 2, 5, 6, 7 }, ::hornet::UpsertSum());
+    expected[{ 0, 1 }] = 23;
+    expected[{ 0, 2 }] = 7;
+    expected[{ 1, 1 }] = 13;
+    expected[{ 2, 1 }] = 4;
+    is_correct &= hornet.nE() == 7 && getEdges(hornet) == expected;
+    hornet.unsubscribe(&counter);
+    is_correct &= counter.num_updated == 2 + 2 + 1 + 2 &&
+                  counter.num_inserted == 1 + 0 + 1 + 2;
+
+    std::cout << (is_correct ? "PASSED" : "NOT PASSED") << std::endl;
+    return !is_correct;
+}
+
+int main(int argc, char* argv[]) {
+    int ret = 0;
+    {
+        ret = exec(argc, argv);
+    }
+    return ret;
+}
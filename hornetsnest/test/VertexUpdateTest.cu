@@ -0,0 +1,119 @@
+/**
+ * @brief Vertex insertion and deletion test program
+ * @file
+ */
+#include "TestGraph.cuh"
+#include <Graph/GraphStd.hpp>
+#include <vector>
+
+using namespace hornets_nest;
+
+using HornetGraph = ::hornet::gpu::Hornet<vid_t>;
+using HornetInit  = ::hornet::HornetInit<vid_t>;
+using BatchUpdate = ::hornet::gpu::BatchUpdate<vid_t>;
+using UpdatePtr   = ::hornet::BatchUpdatePtr<vid_t, ::hornet::EMPTY,
+                                             ::hornet::DeviceType::HOST>;
+
+struct CountErasedNeighbors {
+    const bool* d_is_erased;
+    int*        d_count;
+
+    OPERATOR(Vertex& vertex, Edge& edge) {
+        if (d_is_erased[vertex.id()] || d_is_erased[edge.dst_id()])
+            atomicAdd(d_count, 1);
+    }
+};
+
+int exec(int argc, char* argv[]) {
+    using namespace graph::parsing_prop;
+
+    graph::GraphStd<vid_t, eoff_t> graph;
+    graph.read(argv[1], PRINT_INFO | SORT);
+    int num_erased = argc > 2 ? std::stoi(argv[2]) : 64;
+
+    HornetInit hornet_init(graph.nV(), graph.nE(), graph.csr_out_offsets(),
+                           graph.csr_out_edges());
+    HornetGraph hornet_graph(hornet_init);
+    int nV = graph.nV();
+
+    //the last vertex and every stride-th vertex
+    std::vector<vid_t> erased;
+    std::vector<bool>  is_erased(nV, false);
+    int stride = std::max(nV / num_erased, 2);
+    for (vid_t v = 1; v < nV - 1; v += stride)
+        erased.push_back(v);
+    erased.push_back(nV - 1);
+    for (auto v : erased)
+        is_erased[v] = true;
+
+    int num_incident = 0;
+    auto offsets = graph.csr_out_offsets();
+    auto edges   = graph.csr_out_edges();
+    for (vid_t v = 0; v < nV; v++) {
+        for (auto i = offsets[v]; i < offsets[v + 1]; i++)
+            num_incident += is_erased[v] || is_erased[edges[i]];
+    }
+
+    auto version = hornet_graph.version();
+    hornet_graph.erase_vertices(erased.data(), erased.size());
+
+    //the last id is dropped from the range, the others are recycled
+    bool is_correct = hornet_graph.nV() < nV &&
+                      hornet_graph.version() > version &&
+                      hornet_graph.nE() == graph.nE() - num_incident;
+    int new_nV = hornet_graph.nV();
+    int num_free = 0;
+    for (auto v : erased)
+        num_free += v < new_nV;
+    is_correct &= hornet_graph.num_free_vertices() == num_free;
+
+    auto degrees = getDegrees(hornet_graph);
+    for (auto v : erased) {
+        if (v < new_nV)
+            is_correct &= degrees[v] == 0;
+    }
+    thrust::device_vector<bool> d_is_erased(is_erased.begin(),
+                                            is_erased.begin() + new_nV);
+    thrust::device_vector<int> d_count(1, 0);
+    forAllEdges(hornet_graph, CountErasedNeighbors { d_is_erased.data().get(),
+                                                     d_count.data().get() },
+                load_balancing::BinarySearch(hornet_graph));
+    is_correct &= d_count[0] == 0;
+
+    //the free ids are reused in increasing order, then the range grows
+    int num_inserted = num_free + 2 * nV;
+    auto ids = hornet_graph.insert_vertices(num_inserted);
+    is_correct &= static_cast<int>(ids.size()) == num_inserted &&
+                  hornet_graph.num_free_vertices() == 0 &&
+                  hornet_graph.nV() == new_nV + num_inserted - num_free &&
+                  hornet_graph.vertex_capacity() >= hornet_graph.nV();
+    for (int i = 0, j = 0; i < static_cast<int>(erased.size()); i++) {
+        if (erased[i] < new_nV)
+            is_correct &= ids[j++] == erased[i];
+    }
+    is_correct &= ids.back() == hornet_graph.nV() - 1;
+
+    //edges of the new vertices
+    std::vector<vid_t> batch_src { ids.front(), ids.back(), ids.back() };
+    std::vector<vid_t> batch_dst { ids.back(),  0,          ids.front() };
+    BatchUpdate batch(UpdatePtr(batch_src.size(), batch_src.data(),
+                                batch_dst.data()));
+    hornet_graph.insert(batch, true, true);
+    degrees = getDegrees(hornet_graph);
+    is_correct &= degrees[ids.front()] == 1 && degrees[ids.back()] == 2 &&
+                  hornet_graph.nE() == graph.nE() - num_incident + 3;
+
+    std::cout << "erased vertices: " << erased.size()
+              << "  incident edges: " << num_incident
+              << "  capacity: " << hornet_graph.vertex_capacity() << "\n";
+    std::cout << (is_correct ? "PASSED" : "NOT PASSED") << std::endl;
+    return !is_correct;
+}
+
+int main(int argc, char* argv[]) {
+    int ret = 0;
+    {
+        ret = exec(argc, argv);
+    }
+    return ret;
+}
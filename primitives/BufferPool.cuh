@@ -14,21 +14,272 @@
  * limitations under the License.
  */
 #pragma once
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <utility>
 #include <vector>
+#if defined(__CUDACC__)
 #include <rmm/device_buffer.hpp>
+#endif
 
-class BufferPool {
-  std::vector<rmm::device_buffer> _data;
+#if defined(__CUDACC__)
+struct DevicePoolBackend {
+  using Buffer = rmm::device_buffer;
 
+  static Buffer make(size_t bytes) {
+    return Buffer(bytes, rmm::cuda_stream_view{});
+  }
+
+  static void* data(Buffer& buffer) { return buffer.data(); }
+};
+#endif
+
+struct HostPoolBackend {
+  using Buffer = std::unique_ptr<unsigned char[]>;
+
+  static const size_t ALIGNMENT = 256;
+
+  static Buffer make(size_t bytes) {
+    return Buffer(new unsigned char[bytes + ALIGNMENT]);
+  }
+
+  static void* data(Buffer& buffer) {
+    auto address = reinterpret_cast<std::uintptr_t>(buffer.get());
+    return reinterpret_cast<void*>((address + ALIGNMENT - 1) &
+                                   ~(ALIGNMENT - 1));
+  }
+};
+
+/**
+ * @brief Arena of device (or host) buffers
+ * @details Small buffers are carved out of large slabs, larger ones get a
+ *          slab of their own. Allocations are released in LIFO order with
+ *          `mark()`/`release_to()`, which rolls the top of the slabs back:
+ *          the same sequence of allocations after a release gets the same
+ *          buffers again. Memory goes back to the backend only with
+ *          `shrink_to_fit()` or on destruction, so an algorithm which
+ *          allocates and releases the same buffers at every `run()` has a
+ *          flat memory profile.
+ */
+template <typename Backend>
+class BasicBufferPool {
   public :
 
+  using Mark = size_t;
+
+  static const size_t ALIGNMENT         = 256;
+  static const size_t DEFAULT_SLAB_SIZE = 1 << 20;
+
+  explicit BasicBufferPool(size_t slab_size = DEFAULT_SLAB_SIZE);
+
+  BasicBufferPool(const BasicBufferPool&)            = delete;
+  BasicBufferPool& operator=(const BasicBufferPool&) = delete;
+
+  /**
+   * @brief the buffers keep their address; the moved-from pool is empty
+   */
+  BasicBufferPool(BasicBufferPool&& other) noexcept;
+  BasicBufferPool& operator=(BasicBufferPool&& other) noexcept;
+
   template <typename P>
   void allocate(P** ptr, size_t num_items);
+
+  /**
+   * @brief position of the next allocation, for `release_to`
+   */
+  Mark mark() const noexcept;
+
+  /**
+   * @brief releases all the buffers allocated after `mark`
+   */
+  void release_to(Mark mark);
+
+  /**
+   * @brief releases all the buffers
+   */
+  void clear();
+
+  /**
+   * @brief returns the slabs to the backend when no buffer is in use
+   */
+  void shrink_to_fit();
+
+  size_t bytes_in_use()   const noexcept;
+  size_t bytes_reserved() const noexcept;
+  size_t high_water_mark() const noexcept;
+  void   reset_high_water_mark() noexcept;
+
+  /**
+   * @brief releases the buffers allocated during its lifetime
+   */
+  class Scope {
+    public :
+    explicit Scope(BasicBufferPool& pool) : _pool(pool), _mark(pool.mark()) {}
+    ~Scope() { _pool.release_to(_mark); }
+
+    Scope(const Scope&)            = delete;
+    Scope& operator=(const Scope&) = delete;
+
+    private :
+    BasicBufferPool& _pool;
+    Mark             _mark;
+  };
+
+  private :
+
+  struct Slab {
+    typename Backend::Buffer buffer;
+    size_t                   size;
+    size_t                   used;
+  };
+
+  struct Allocation {
+    void*  ptr;
+    size_t bytes;
+    size_t slab;
+    size_t offset;
+  };
+
+  std::vector<Slab>       _slabs;
+  std::vector<Allocation> _live;
+
+  size_t _slab_size;
+  size_t _in_use   { 0 };
+  size_t _reserved { 0 };
+  size_t _peak     { 0 };
+
+  Allocation carve(size_t bytes);
 };
 
+#if defined(__CUDACC__)
+using BufferPool = BasicBufferPool<DevicePoolBackend>;
+#endif
+using HostBufferPool = BasicBufferPool<HostPoolBackend>;
+
+//==============================================================================
+
+template <typename Backend>
+BasicBufferPool<Backend>::BasicBufferPool(size_t slab_size) :
+                                              _slab_size(slab_size) {}
+
+template <typename Backend>
+BasicBufferPool<Backend>::BasicBufferPool(BasicBufferPool&& other) noexcept :
+                                              _slab_size(other._slab_size) {
+  *this = std::move(other);
+}
+
+template <typename Backend>
+BasicBufferPool<Backend>&
+BasicBufferPool<Backend>::operator=(BasicBufferPool&& other) noexcept {
+  if (this == &other)
+    return *this;
+  _slabs     = std::move(other._slabs);
+  _live      = std::move(other._live);
+  _slab_size = other._slab_size;
+  _in_use    = other._in_use;
+  _reserved  = other._reserved;
+  _peak      = other._peak;
+  //a moved-from vector is only valid: empty it with the counters
+  other._slabs.clear();
+  other._live.clear();
+  other._in_use   = 0;
+  other._reserved = 0;
+  other._peak     = 0;
+  return *this;
+}
+
+template <typename Backend>
 template <typename P>
 void
-BufferPool::allocate(P** ptr, size_t num_items) {
-  _data.emplace_back(num_items*sizeof(P), cuda_stream_view{});
-  *ptr = static_cast<P*>(_data.back().data());
+BasicBufferPool<Backend>::allocate(P** ptr, size_t num_items) {
+  size_t bytes = std::max(num_items * sizeof(P), size_t(1));
+  bytes = (bytes + ALIGNMENT - 1) & ~(ALIGNMENT - 1);
+
+  _live.push_back(carve(bytes));
+
+  _in_use += bytes;
+  _peak    = std::max(_peak, _in_use);
+  *ptr = static_cast<P*>(_live.back().ptr);
+}
+
+template <typename Backend>
+typename BasicBufferPool<Backend>::Allocation
+BasicBufferPool<Backend>::carve(size_t bytes) {
+  //best fit: the slab with the least free space at the top
+  size_t index = _slabs.size();
+  for (size_t i = 0; i < _slabs.size(); i++) {
+    size_t space = _slabs[i].size - _slabs[i].used;
+    if (space >= bytes && (index == _slabs.size() ||
+                           space < _slabs[index].size - _slabs[index].used))
+      index = i;
+  }
+  //large buffers get a slab of their own
+  if (index == _slabs.size()) {
+    size_t size = std::max(bytes, _slab_size);
+    _slabs.push_back(Slab { Backend::make(size), size, 0 });
+    _reserved += size;
+  }
+  Slab& slab = _slabs[index];
+  auto  base = static_cast<unsigned char*>(Backend::data(slab.buffer));
+  Allocation allocation { base + slab.used, bytes, index, slab.used };
+  slab.used += bytes;
+  return allocation;
+}
+
+template <typename Backend>
+typename BasicBufferPool<Backend>::Mark
+BasicBufferPool<Backend>::mark() const noexcept {
+  return _live.size();
+}
+
+template <typename Backend>
+void
+BasicBufferPool<Backend>::release_to(Mark mark) {
+  while (_live.size() > mark) {
+    Allocation allocation = _live.back();
+    _live.pop_back();
+    _in_use -= allocation.bytes;
+    //LIFO order: the buffer is always on top of its slab
+    _slabs[allocation.slab].used = allocation.offset;
+  }
+}
+
+template <typename Backend>
+void
+BasicBufferPool<Backend>::clear() {
+  release_to(0);
+}
+
+template <typename Backend>
+void
+BasicBufferPool<Backend>::shrink_to_fit() {
+  if (!_live.empty())
+    return;
+  _slabs.clear();
+  _reserved = 0;
+}
+
+template <typename Backend>
+size_t
+BasicBufferPool<Backend>::bytes_in_use() const noexcept {
+  return _in_use;
+}
+
+template <typename Backend>
+size_t
+BasicBufferPool<Backend>::bytes_reserved() const noexcept {
+  return _reserved;
+}
+
+template <typename Backend>
+size_t
+BasicBufferPool<Backend>::high_water_mark() const noexcept {
+  return _peak;
+}
+
+template <typename Backend>
+void
+BasicBufferPool<Backend>::reset_high_water_mark() noexcept {
+  _peak = _in_use;
 }
@@ -81,6 +81,12 @@ public:
                 int                num_vertices,
                 const Operator&    op) const noexcept;
 
+    /**
+     * @brief Traverse all the edges of the graph
+     * @details the degree prefix sum is cached and recomputed only when the
+     *          graph version changes: repeated sweeps on an unchanged graph
+     *          launch a single kernel without device-host synchronization
+     */
     template<typename HornetClass, typename Operator>
     void apply(HornetClass& hornet, const Operator& op) const noexcept;
 
@@ -92,6 +98,11 @@ private:
     //int* _d_work { nullptr };
     mutable thrust::device_vector<int> d_work;
     //const size_t _work_size;
+
+    //full-graph traversal, valid while the graph version does not change
+    mutable thrust::device_vector<int> d_graph_work;
+    mutable size_t _graph_version { 0 };
+    mutable int    _graph_work    { 0 };
 };
 
 } // namespace load_balancing
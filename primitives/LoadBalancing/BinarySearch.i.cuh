@@ -101,7 +101,29 @@ void BinarySearch::apply(HornetClass& hornet,
 template<typename HornetClass, typename Operator>
 void BinarySearch::apply(HornetClass& hornet, const Operator& op)
                          const noexcept {
-    apply<HornetClass, Operator, int>(hornet, nullptr, (int) hornet.nV(), op);
+    int num_vertices = hornet.nV();
+    if (num_vertices == 0)
+        return;
+    if (_graph_version != hornet.version()) {
+        d_graph_work.resize(num_vertices + 1);
+        prefixsum.resize(num_vertices + 1);
+        kernel::computeWorkKernel
+            <<< xlib::ceil_div<BLOCK_SIZE>(num_vertices), BLOCK_SIZE >>>
+            (hornet.device(), num_vertices, d_graph_work.data().get());
+        CHECK_CUDA_ERROR
+        prefixsum.run(d_graph_work.data().get(), num_vertices + 1);
+        CHECK_CUDA_ERROR
+        cuMemcpyToHost(d_graph_work.data().get() + num_vertices, _graph_work);
+        _graph_version = hornet.version();
+    }
+    if (_graph_work == 0)
+        return;
+    int ITEMS_PER_BLOCK = xlib::DeviceProperty
+                          ::smem_per_block<int>(BLOCK_SIZE);
+    kernel::binarySearchKernel<BLOCK_SIZE>
+        <<< xlib::ceil_div(_graph_work, ITEMS_PER_BLOCK), BLOCK_SIZE >>>
+        (hornet.device(), d_graph_work.data().get(), num_vertices + 1, op);
+    CHECK_CUDA_ERROR
 }
 
 } // namespace load_balancing
@@ -35,6 +35,8 @@
  *
  * @file
  */
+#pragma once
+
 #include <Device/Primitives/BinarySearchLB.cuh>
 
 namespace hornets_nest {
@@ -0,0 +1,101 @@
+/*
+ * Copyright (c) 2019, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "BasicTypes.hpp"
+#include <Device/Primitives/CubWrapper.cuh>  //xlib::CubExclusiveSum
+#include <thrust/device_vector.h>
+
+namespace hornets_nest {
+namespace load_balancing {
+
+/**
+ * @brief The class implements the Merge-Path load balancing
+ * @details The traversal is seen as the merge of the vertex list with the
+ *          edge list: moving to the next vertex or visiting an edge is one
+ *          step of the path. The path is cut into tiles of the same length,
+ *          so every block (or host thread) gets the same amount of work
+ *          independently of the degree distribution: a high-degree vertex is
+ *          split across many tiles, and many low-degree vertices share one.
+ *          The tile boundaries are found with a binary search on the degree
+ *          prefix sum (`xlib::merge_path_search`).
+ *          For full-graph traversals the prefix sum and the partition are
+ *          cached and rebuilt only when the Hornet version changes, without
+ *          any device-host synchronization.
+ */
+class MergePath {
+public:
+    /**
+     * @brief Default costructor
+     * @param[in] hornet Hornet instance
+     */
+    template<typename HornetClass>
+    explicit MergePath(HornetClass& hornet) noexcept;
+
+    /**
+     * @brief Traverse the edges in a vertex queue (C++11-Style API)
+     * @see BinarySearch::apply
+     */
+    template<typename HornetClass, typename Operator, typename vid_t>
+    void apply(HornetClass&    hornet,
+               const vid_t*    d_input,
+               int             num_vertices,
+               const Operator& op) const noexcept;
+
+    /**
+     * @brief Traverse all the edges of the graph
+     */
+    template<typename HornetClass, typename Operator>
+    void apply(HornetClass& hornet, const Operator& op) const noexcept;
+
+    /**
+     * @brief Traverse the edges of a host CSR graph with OpenMP threads
+     * @details every thread processes one tile of the merge path
+     * @param[in] offsets CSR offsets (`num_vertices + 1` items)
+     * @param[in] op lambda expression `[](int vertex, int edge_offset){}`,
+     *            where `edge_offset` indexes the CSR edge array
+     */
+    template<typename Operator>
+    static void applyHost(const int* offsets, int num_vertices,
+                          const Operator& op) noexcept;
+
+private:
+    static const unsigned      BLOCK_SIZE = 128;
+    static const unsigned ITEMS_PER_THREAD = 8;
+    static const int            TILE_SIZE = BLOCK_SIZE * ITEMS_PER_THREAD;
+
+    mutable xlib::CubExclusiveSum<int> prefixsum;
+
+    //frontier traversal
+    mutable thrust::device_vector<int>  d_offsets;
+    mutable thrust::device_vector<int2> d_partitions;
+
+    //full-graph traversal, valid while the graph version does not change
+    mutable thrust::device_vector<int>  d_graph_offsets;
+    mutable thrust::device_vector<int2> d_graph_partitions;
+    mutable size_t _graph_version { 0 };
+    mutable int    _graph_edges   { 0 };
+
+    template<typename HornetClass, typename vid_t>
+    int partition(HornetClass& hornet, const vid_t* d_input, int num_vertices,
+                  thrust::device_vector<int>&  offsets,
+                  thrust::device_vector<int2>& partitions) const noexcept;
+};
+
+} // namespace load_balancing
+} // namespace hornets_nest
+
+#include "LoadBalancing/MergePath.i.cuh"
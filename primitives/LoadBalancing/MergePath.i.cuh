@@ -0,0 +1,135 @@
+/*
+ * Copyright (c) 2019, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "MergePathKernel.cuh"
+#include "BinarySearchKernel.cuh"            //computeWorkKernel
+#include "StandardAPI.hpp"
+#include <Device/Util/SafeCudaAPI.cuh>       //CHECK_CUDA_ERROR
+#include <Host/Numeric.hpp>                  //xlib::ceil_div
+#include <algorithm>
+#include <omp.h>
+
+namespace hornets_nest {
+namespace load_balancing {
+
+template<typename HornetClass>
+MergePath::MergePath(HornetClass& hornet) noexcept {
+    d_graph_offsets.resize(hornet.nV() + 1);
+    prefixsum.resize(hornet.nV() + 1);
+}
+
+template<typename HornetClass, typename vid_t>
+int MergePath::partition(HornetClass& hornet,
+                         const vid_t* d_input,
+                         int          num_vertices,
+                         thrust::device_vector<int>&  offsets,
+                         thrust::device_vector<int2>& partitions)
+                         const noexcept {
+    offsets.resize(num_vertices + 1);
+    prefixsum.resize(num_vertices + 1);
+    if (d_input != nullptr) {
+    kernel::computeWorkKernel
+        <<< xlib::ceil_div<BLOCK_SIZE>(num_vertices), BLOCK_SIZE >>>
+        (hornet.device(), d_input, num_vertices, offsets.data().get());
+    } else {
+    kernel::computeWorkKernel
+        <<< xlib::ceil_div<BLOCK_SIZE>(num_vertices), BLOCK_SIZE >>>
+        (hornet.device(), num_vertices, offsets.data().get());
+    }
+    CHECK_CUDA_ERROR
+    prefixsum.run(offsets.data().get(), num_vertices + 1);
+    CHECK_CUDA_ERROR
+
+    int num_edges;
+    gpu::copyToHost(offsets.data().get() + num_vertices, 1, &num_edges);
+
+    int num_tiles = xlib::ceil_div<TILE_SIZE>(num_vertices + num_edges);
+    partitions.resize(num_tiles + 1);
+    kernel::mergePathPartitionKernel<TILE_SIZE>
+        <<< xlib::ceil_div<BLOCK_SIZE>(num_tiles + 1), BLOCK_SIZE >>>
+        (offsets.data().get(), num_vertices, num_edges, num_tiles + 1,
+         partitions.data().get());
+    CHECK_CUDA_ERROR
+    return num_edges;
+}
+
+template<typename HornetClass, typename Operator, typename vid_t>
+void MergePath::apply(HornetClass&    hornet,
+                      const vid_t*    d_input,
+                      int             num_vertices,
+                      const Operator& op) const noexcept {
+    if (num_vertices == 0)
+        return;
+    int num_edges = partition(hornet, d_input, num_vertices,
+                              d_offsets, d_partitions);
+    if (num_edges == 0)
+        return;
+    kernel::mergePathKernel<BLOCK_SIZE, ITEMS_PER_THREAD>
+        <<< d_partitions.size() - 1, BLOCK_SIZE >>>
+        (hornet.device(), kernel::QueueVertexId<vid_t> { d_input },
+         d_offsets.data().get(), d_partitions.data().get(), num_vertices, op);
+    CHECK_CUDA_ERROR
+}
+
+template<typename HornetClass, typename Operator>
+void MergePath::apply(HornetClass& hornet, const Operator& op)
+                      const noexcept {
+    if (hornet.nV() == 0)
+        return;
+    if (_graph_version != hornet.version()) {
+        _graph_edges = partition(hornet, static_cast<const int*>(nullptr),
+                                 hornet.nV(), d_graph_offsets,
+                                 d_graph_partitions);
+        _graph_version = hornet.version();
+    }
+    if (_graph_edges == 0)
+        return;
+    kernel::mergePathKernel<BLOCK_SIZE, ITEMS_PER_THREAD>
+        <<< d_graph_partitions.size() - 1, BLOCK_SIZE >>>
+        (hornet.device(), kernel::GraphVertexId(),
+         d_graph_offsets.data().get(), d_graph_partitions.data().get(),
+         hornet.nV(), op);
+    CHECK_CUDA_ERROR
+}
+
+template<typename Operator>
+void MergePath::applyHost(const int* offsets, int num_vertices,
+                          const Operator& op) noexcept {
+    int num_edges  = offsets[num_vertices];
+    int path_size  = num_vertices + num_edges;
+
+    #pragma omp parallel
+    {
+        int num_threads = omp_get_num_threads();
+        int tile_size   = xlib::ceil_div(path_size, num_threads);
+        int begin       = std::min(omp_get_thread_num() * tile_size, path_size);
+        int end         = std::min(begin + tile_size, path_size);
+
+        auto coord = xlib::merge_path_search(offsets + 1, num_vertices,
+                                             xlib::NaturalIterator(),
+                                             num_edges, begin);
+        int v = coord.x;
+        int e = coord.y;
+        for (int i = begin; i < end; i++) {
+            if (v < num_vertices && e < offsets[v + 1])
+                op(v, e++);
+            else
+                v++;
+        }
+    }
+}
+
+} // namespace load_balancing
+} // namespace hornets_nest
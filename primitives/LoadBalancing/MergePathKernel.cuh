@@ -0,0 +1,102 @@
+/*
+ * Copyright (c) 2019, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <Host/Algorithm.hpp>  //xlib::merge_path_search
+
+namespace hornets_nest {
+namespace load_balancing {
+namespace kernel {
+
+/*
+ * (vertex, edge) coordinates of the first path item of each tile
+ */
+template<int TILE_SIZE>
+__global__
+void mergePathPartitionKernel(const int* __restrict__ d_offsets,
+                              int                     num_vertices,
+                              int                     num_edges,
+                              int                     num_partitions,
+                              int2*      __restrict__ d_partitions) {
+    int     id = blockIdx.x * blockDim.x + threadIdx.x;
+    int stride = blockDim.x * gridDim.x;
+    for (auto i = id; i < num_partitions; i += stride) {
+        int diagonal = ::min(i * TILE_SIZE, num_vertices + num_edges);
+        d_partitions[i] = xlib::merge_path_search(d_offsets + 1, num_vertices,
+                                                  xlib::NaturalIterator(),
+                                                  num_edges, diagonal);
+    }
+}
+
+/*
+ * every thread walks ITEMS_PER_THREAD steps of the tile of its block: a step
+ * either visits an edge of the current vertex or moves to the next vertex
+ */
+template<unsigned BLOCK_SIZE, unsigned ITEMS_PER_THREAD,
+         typename HornetDevice, typename VertexId, typename Operator>
+__global__
+void mergePathKernel(HornetDevice              hornet,
+                     VertexId                  vertex_id,
+                     const int*   __restrict__ d_offsets,
+                     const int2*  __restrict__ d_partitions,
+                     int                       num_vertices,
+                     Operator                  op) {
+    int2 start = d_partitions[blockIdx.x];
+    int2 end   = d_partitions[blockIdx.x + 1];
+    int tile_vertices = end.x - start.x;
+    int tile_edges    = end.y - start.y;
+    int tile_size     = tile_vertices + tile_edges;
+
+    int diagonal = threadIdx.x * ITEMS_PER_THREAD;
+    if (diagonal >= tile_size)
+        return;
+    auto coord = xlib::merge_path_search(d_offsets + 1 + start.x,
+                                         tile_vertices,
+                                         xlib::NaturalIterator(start.y),
+                                         tile_edges, diagonal);
+    int v = start.x + coord.x;
+    int e = start.y + coord.y;
+    int steps = ::min(static_cast<int>(ITEMS_PER_THREAD),
+                      tile_size - diagonal);
+
+    for (int i = 0; i < steps; i++) {
+        if (v < num_vertices && e < d_offsets[v + 1]) {
+            const auto& vertex = hornet.vertex(vertex_id(v));
+            const auto&   edge = vertex.edge(e - d_offsets[v]);
+            op(vertex, edge);
+            e++;
+        }
+        else
+            v++;
+    }
+}
+
+template<typename vid_t>
+struct QueueVertexId {
+    const vid_t* d_input;
+
+    __device__ __forceinline__
+    vid_t operator()(int pos) const { return d_input[pos]; }
+};
+
+struct GraphVertexId {
+    __device__ __forceinline__
+    int operator()(int pos) const { return pos; }
+};
+
+} // namespace kernel
+} // namespace load_balancing
+} // namespace hornets_nest
@@ -39,6 +39,7 @@
 #pragma once
 
 #include "Queue/TwoLevelQueue.cuh"
+#include "Queue/Frontier.cuh"
 #include "HostDeviceVar.cuh"
 #include "LoadBalancing/VertexBased.cuh"
 #include "LoadBalancing/BinarySearch.cuh"
@@ -217,6 +218,29 @@ void forAllEdges(HornetClass&                hornet,
 
 //==============================================================================
 
+/**
+ * @brief apply the `Operator` to all vertices of the input level of the
+ *        frontier
+ * @remark a dense level is visited by scanning the bitmap
+ */
+template<typename HornetClass, typename Operator>
+void forAllVertices(HornetClass&                hornet,
+                    const Frontier<typename HornetClass::VertexType>& frontier,
+                    const Operator&             op);
+
+/**
+ * @brief apply the `Operator` to all edges of the vertices of the input level
+ *        of the frontier
+ * @remark a dense level is compacted before the load balancing
+ */
+template<typename HornetClass, typename Operator, typename LoadBalancing>
+void forAllEdges(HornetClass&                hornet,
+                 const Frontier<typename HornetClass::VertexType>& frontier,
+                 const Operator&             op,
+                 const LoadBalancing&        load_balancing);
+
+//==============================================================================
+
 //using BatchUpdate = hornet::BatchUpdate;
 //
 //template<typename HornetClass, typename Operator>
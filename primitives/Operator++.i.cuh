@@ -290,6 +290,26 @@ void forAllVerticesKernel(HornetDevice              hornet,
     }
 }
 
+template<typename HornetDevice, typename Operator, typename vid_t>
+__global__
+void forAllVerticesBitmapKernel(HornetDevice                 hornet,
+                                const unsigned* __restrict__ d_bitmap,
+                                int                          num_words,
+                                Operator                     op) {
+    int     id = blockIdx.x * blockDim.x + threadIdx.x;
+    int stride = gridDim.x * blockDim.x;
+
+    for (int i = id; i < num_words; i += stride) {
+        unsigned word = d_bitmap[i];
+        while (word != 0) {
+            int bit = __ffs(word) - 1;
+            word   &= word - 1;
+            auto vertex = hornet.vertex(static_cast<vid_t>(i * 32 + bit));
+            op(vertex);
+        }
+    }
+}
+
 template<typename HornetDevice, typename Operator, typename vid_t>
 __global__
 void forAllEdgesKernel(HornetDevice               hornet,
@@ -646,4 +666,36 @@ void forAllEdges(HornetClass&                hornet,
     load_balancing.apply(hornet, queue.device_input_ptr(), queue.size(), op);
 }
 
+template<typename HornetClass, typename Operator>
+void forAllVertices(HornetClass&                hornet,
+                    const Frontier<typename HornetClass::VertexType>& frontier,
+                    const Operator&             op) {
+    using vid_t = typename HornetClass::VertexType;
+    auto size = frontier.size();
+    if (size == 0) { return; }
+    if (frontier.mode() == FrontierMode::SPARSE) {
+        detail::forAllVerticesKernel
+            <<< xlib::ceil_div<BLOCK_SIZE_OP2>(size), BLOCK_SIZE_OP2 >>>
+            (hornet.device(), frontier.device_input_ptr(), size, op);
+    }
+    else {
+        auto num_words = xlib::ceil_div<32>(frontier.num_vertices());
+        detail::forAllVerticesBitmapKernel<decltype(hornet.device()),
+                                           Operator, vid_t>
+            <<< xlib::ceil_div<BLOCK_SIZE_OP2>(num_words), BLOCK_SIZE_OP2 >>>
+            (hornet.device(), frontier.device_input_bitmap(), num_words, op);
+    }
+    CHECK_CUDA_ERROR
+}
+
+template<typename HornetClass, typename Operator, typename LoadBalancing>
+void forAllEdges(HornetClass&                hornet,
+                 const Frontier<typename HornetClass::VertexType>& frontier,
+                 const Operator&             op,
+                 const LoadBalancing&        load_balancing) {
+    //the load balancing needs the vertex list: a dense level is compacted
+    auto d_input = frontier.device_input_ptr();
+    load_balancing.apply(hornet, d_input, frontier.size(), op);
+}
+
 } // namespace hornets_nest
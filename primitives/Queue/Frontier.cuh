@@ -0,0 +1,180 @@
+/*
+ * Copyright (c) 2019, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "Queue/FrontierMode.hpp"
+#include "Queue/TwoLevelQueue.cuh"  //ptr2_t
+#include <HostDevice.hpp>
+
+namespace hornets_nest {
+
+/**
+ * @brief Two-level vertex frontier with sparse (queue) and dense (bitmap)
+ *        representations
+ * @details Like `TwoLevelQueue`, the device inserts the vertices of the next
+ *          level in the output level and `swap()` makes it the input level.
+ *          The representation of the output level is chosen at every `swap()`
+ *          from the policy and the size of the new input level. The operators
+ *          must capture the frontier by value after every `swap()`.
+ *          The input level can be read in both representations: the missing
+ *          one is built on demand and cached until the next `swap()`.
+ * @tparam T vertex id type
+ */
+template<typename T>
+class Frontier {
+public:
+    static constexpr float DEFAULT_DENSE_THRESHOLD = 0.05f;
+
+    Frontier() = default;
+
+    /**
+     * @param[in] hornet reference to the hornet instance
+     * @param[in] work_factor number of allocated items of the sparse
+     *            representation for each vertex
+     */
+    template<typename HornetClass>
+    explicit Frontier(const HornetClass& hornet,
+                      const float work_factor = 2.0f) noexcept;
+
+    Frontier(int num_vertices, size_t max_allocated_items) noexcept;
+
+    /**
+     * @brief allocate a default-constructed frontier
+     * @param[in] hornet reference to the hornet instance
+     * @param[in] work_factor number of allocated items of the sparse
+     *            representation for each vertex
+     */
+    template<typename HornetClass>
+    void initialize(const HornetClass& hornet,
+                    const float work_factor = 2.0f) noexcept;
+
+    HOST_DEVICE
+    Frontier(const Frontier<T>& obj) noexcept;
+
+    HOST_DEVICE
+    ~Frontier() noexcept;
+
+    /**
+     * @brief insert a vertex in the output level
+     * @remark the method can be called only on the device
+     */
+    __device__ __forceinline__
+    void insert(const T& item) const noexcept;
+
+    /**
+     * @brief insert a vertex in the output level (device) or in the input
+     *        level (host)
+     */
+    __host__ __device__ __forceinline__
+    void insert(const T& item) noexcept;
+
+    /**
+     * @brief insert a set of vertices in the input level
+     * @remark the method can be called only on the host
+     */
+    void insert(const T* items_array, int num_items) noexcept;
+
+    /**
+     * @brief the output level becomes the input level
+     * @remark the method is synchronized
+     */
+    void swap() noexcept;
+
+    /**
+     * @brief empty both levels
+     */
+    void clear() noexcept;
+
+    /**
+     * @brief number of vertices in the input level
+     * @remark the method is cheap
+     */
+    int size() const noexcept;
+
+    /**
+     * @brief representation in which the input level has been built
+     */
+    FrontierMode mode() const noexcept;
+
+    /**
+     * @brief representation of the output level
+     */
+    FrontierMode output_mode() const noexcept;
+
+    void set_policy(FrontierPolicy policy,
+                    float dense_threshold = DEFAULT_DENSE_THRESHOLD) noexcept;
+
+    /**
+     * @brief change the representation of the input level
+     * @remark `size()` becomes the number of distinct vertices when
+     *         converting a queue with duplicates to the dense representation
+     */
+    void convert(FrontierMode mode) noexcept;
+
+    /**
+     * @brief device pointer to the input level as array of vertices
+     * @remark the method may be expensive: the bitmap is compacted if the
+     *         input level is dense
+     */
+    const T* device_input_ptr() const noexcept;
+
+    /**
+     * @brief device pointer to the input level as bitmap
+     * @remark the method may be expensive: the bitmap is built if the input
+     *         level is sparse
+     */
+    const unsigned* device_input_bitmap() const noexcept;
+
+    /**
+     * @brief membership test on the input level
+     * @warning valid only after `device_input_bitmap()` has been called on
+     *          the host for the current level, e.g. when `mode()` is `DENSE`
+     */
+    __device__ __forceinline__
+    bool contains(const T& item) const noexcept;
+
+    int num_vertices() const noexcept;
+
+private:
+    ///@internal @brief input and output queue pointers
+    ptr2_t<T>        _d_queue_ptrs   { nullptr, nullptr };
+    ///@internal @brief input and output bitmaps
+    ptr2_t<unsigned> _d_bitmap_ptrs  { nullptr, nullptr };
+    ///@internal @brief x: input level size, y: output queue size
+    int2*            _d_counters     { nullptr };
+    mutable int2     _h_counters     { 0, 0 };
+
+    size_t         _max_allocated_items { 0 };
+    int            _num_vertices        { 0 };
+    int            _num_words           { 0 };
+    FrontierMode   _mode                { FrontierMode::SPARSE };
+    FrontierMode   _output_mode         { FrontierMode::SPARSE };
+    FrontierPolicy _policy              { FrontierPolicy::AUTO };
+    float          _dense_threshold     { DEFAULT_DENSE_THRESHOLD };
+    mutable bool   _has_sparse          { true };
+    mutable bool   _has_dense           { false };
+    bool           _kernel_copy         { false };
+
+    void _initialize() noexcept;
+
+    void prepare_output() noexcept;
+
+    int count_input() const noexcept;
+};
+
+} // namespace hornets_nest
+
+#include "Queue/Frontier.i.cuh"
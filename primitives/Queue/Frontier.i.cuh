@@ -0,0 +1,332 @@
+/*
+ * Copyright (c) 2019, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <Device/Util/PTX.cuh>              //xlib::__msb
+#include <Device/Util/SafeCudaAPI.cuh>      //cuMemcpyToDevice
+#include <Host/Numeric.hpp>                 //xlib::ceil_div
+#include "StandardAPI.hpp"
+#include <cassert>
+
+namespace hornets_nest {
+namespace frontier {
+namespace kernel {
+
+template<typename T>
+__global__
+void fillBitmapKernel(const T* __restrict__ d_queue,
+                      int                   size,
+                      unsigned*             d_bitmap) {
+    int     id = blockIdx.x * blockDim.x + threadIdx.x;
+    int stride = blockDim.x * gridDim.x;
+    for (auto i = id; i < size; i += stride) {
+        auto item = d_queue[i];
+        atomicOr(d_bitmap + item / 32, 1u << (item % 32));
+    }
+}
+
+template<typename T>
+__global__
+void compactBitmapKernel(const unsigned* __restrict__ d_bitmap,
+                         int                          num_words,
+                         T*              __restrict__ d_queue,
+                         int*                         d_counter) {
+    int     id = blockIdx.x * blockDim.x + threadIdx.x;
+    int stride = blockDim.x * gridDim.x;
+    for (auto i = id; i < num_words; i += stride) {
+        unsigned word = d_bitmap[i];
+        if (word == 0)
+            continue;
+        int offset = atomicAdd(d_counter, __popc(word));
+        while (word != 0) {
+            int bit = __ffs(word) - 1;
+            word   &= word - 1;
+            d_queue[offset++] = static_cast<T>(i * 32 + bit);
+        }
+    }
+}
+
+template<typename = void>
+__global__
+void popcountKernel(const unsigned* __restrict__ d_bitmap,
+                    int                          num_words,
+                    int*                         d_counter) {
+    int     id = blockIdx.x * blockDim.x + threadIdx.x;
+    int stride = blockDim.x * gridDim.x;
+    int  count = 0;
+    for (auto i = id; i < num_words; i += stride)
+        count += __popc(d_bitmap[i]);
+    if (count != 0)
+        atomicAdd(d_counter, count);
+}
+
+} // namespace kernel
+} // namespace frontier
+
+//------------------------------------------------------------------------------
+
+template<typename T>
+template<typename HornetClass>
+Frontier<T>::Frontier(const HornetClass& hornet,
+                      const float work_factor) noexcept :
+                            _max_allocated_items(hornet.nV() * work_factor),
+                            _num_vertices(hornet.nV()) {
+    _initialize();
+}
+
+template<typename T>
+Frontier<T>::Frontier(int num_vertices, size_t max_allocated_items) noexcept :
+                            _max_allocated_items(max_allocated_items),
+                            _num_vertices(num_vertices) {
+    _initialize();
+}
+
+template<typename T>
+template<typename HornetClass>
+void Frontier<T>::initialize(const HornetClass& hornet,
+                             const float work_factor) noexcept {
+    assert(_d_counters == nullptr && "Frontier already initialized");
+    _max_allocated_items = hornet.nV() * work_factor;
+    _num_vertices        = hornet.nV();
+    _initialize();
+}
+
+template<typename T>
+HOST_DEVICE
+Frontier<T>::Frontier(const Frontier<T>& obj) noexcept :
+                            _d_queue_ptrs(obj._d_queue_ptrs),
+                            _d_bitmap_ptrs(obj._d_bitmap_ptrs),
+                            _d_counters(obj._d_counters),
+                            _h_counters(obj._h_counters),
+                            _max_allocated_items(obj._max_allocated_items),
+                            _num_vertices(obj._num_vertices),
+                            _num_words(obj._num_words),
+                            _mode(obj._mode),
+                            _output_mode(obj._output_mode),
+                            _policy(obj._policy),
+                            _dense_threshold(obj._dense_threshold),
+                            _has_sparse(obj._has_sparse),
+                            _has_dense(obj._has_dense),
+                            _kernel_copy(true) {}
+
+template<typename T>
+HOST_DEVICE
+Frontier<T>::~Frontier() noexcept {
+#if !defined(__CUDA_ARCH__)
+    if (!_kernel_copy && _d_counters != nullptr) {
+        gpu::free(_d_queue_ptrs.first, _max_allocated_items);
+        gpu::free(_d_queue_ptrs.second, _max_allocated_items);
+        gpu::free(_d_bitmap_ptrs.first, _num_words);
+        gpu::free(_d_bitmap_ptrs.second, _num_words);
+        gpu::free(_d_counters, 1);
+    }
+#endif
+}
+
+template<typename T>
+void Frontier<T>::_initialize() noexcept {
+    _num_words = xlib::ceil_div<32>(_num_vertices);
+    gpu::allocate(_d_queue_ptrs.first, _max_allocated_items);
+    gpu::allocate(_d_queue_ptrs.second, _max_allocated_items);
+    gpu::allocate(_d_bitmap_ptrs.first, _num_words);
+    gpu::allocate(_d_bitmap_ptrs.second, _num_words);
+    gpu::allocate(_d_counters, 1);
+    clear();
+}
+
+//------------------------------------------------------------------------------
+
+template<typename T>
+__device__ __forceinline__
+void Frontier<T>::insert(const T& item) const noexcept {
+    if (_output_mode == FrontierMode::DENSE) {
+        atomicOr(_d_bitmap_ptrs.second + item / 32, 1u << (item % 32));
+        return;
+    }
+    unsigned       ballot = __activemask();
+    unsigned elected_lane = xlib::__msb(ballot);
+    int warp_offset;
+    if (xlib::lane_id() == elected_lane)
+        warp_offset = atomicAdd(&_d_counters->y, __popc(ballot));
+    int offset = __popc(ballot & xlib::lanemask_lt()) +
+                 __shfl_sync(ballot, warp_offset, elected_lane);
+    _d_queue_ptrs.second[offset] = item;
+}
+
+template<typename T>
+__device__ __forceinline__
+bool Frontier<T>::contains(const T& item) const noexcept {
+    return _d_bitmap_ptrs.first[item / 32] & (1u << (item % 32));
+}
+
+template<typename T>
+void Frontier<T>::insert(const T* items_array, int num_items) noexcept {
+    convert(FrontierMode::SPARSE);
+    _has_dense = false;
+    assert(_h_counters.x + num_items <= _max_allocated_items &&
+           "Frontier too small");
+    cuMemcpyToDevice(items_array, num_items,
+                     _d_queue_ptrs.first + _h_counters.x);
+    _h_counters.x += num_items;
+    cuMemcpyToDevice(_h_counters, _d_counters);
+    prepare_output();
+}
+
+template<typename T>
+__host__ __device__ __forceinline__
+void Frontier<T>::insert(const T& item) noexcept {
+#if defined(__CUDA_ARCH__)
+    static_cast<const Frontier<T>&>(*this).insert(item);
+#else
+    insert(&item, 1);
+#endif
+}
+
+template<typename T>
+void Frontier<T>::swap() noexcept {
+    _d_queue_ptrs.swap();
+    _d_bitmap_ptrs.swap();
+    _mode       = _output_mode;
+    _has_sparse = _mode == FrontierMode::SPARSE;
+    _has_dense  = _mode == FrontierMode::DENSE;
+
+    if (_mode == FrontierMode::DENSE) {
+        //the output counter is unused in dense mode
+        const int BLOCK_SIZE = 256;
+        frontier::kernel::popcountKernel
+            <<< xlib::ceil_div<BLOCK_SIZE>(_num_words), BLOCK_SIZE >>>
+            (_d_bitmap_ptrs.first, _num_words, &_d_counters->y);
+        CHECK_CUDA_ERROR
+    }
+    swapKernel<<< 1, 1 >>>(_d_counters);
+    cuMemcpyToHost(_d_counters, _h_counters);
+    assert(_h_counters.x <= _max_allocated_items && "Frontier too small");
+    prepare_output();
+}
+
+template<typename T>
+void Frontier<T>::clear() noexcept {
+    _h_counters = { 0, 0 };
+    cuMemset0x00(_d_counters);
+    _mode       = FrontierMode::SPARSE;
+    _has_sparse = true;
+    _has_dense  = false;
+    prepare_output();
+}
+
+template<typename T>
+void Frontier<T>::prepare_output() noexcept {
+    switch (_policy) {
+        case FrontierPolicy::SPARSE: _output_mode = FrontierMode::SPARSE; break;
+        case FrontierPolicy::DENSE:  _output_mode = FrontierMode::DENSE;  break;
+        case FrontierPolicy::AUTO:
+            _output_mode = _h_counters.x > _dense_threshold * _num_vertices ?
+                           FrontierMode::DENSE : FrontierMode::SPARSE;
+    }
+    if (_output_mode == FrontierMode::DENSE)
+        gpu::memsetZero(_d_bitmap_ptrs.second, _num_words);
+}
+
+template<typename T>
+void Frontier<T>::set_policy(FrontierPolicy policy, float dense_threshold)
+                             noexcept {
+    _policy          = policy;
+    _dense_threshold = dense_threshold;
+    //the output level is empty between two levels
+    prepare_output();
+}
+
+//------------------------------------------------------------------------------
+
+template<typename T>
+const T* Frontier<T>::device_input_ptr() const noexcept {
+    if (!_has_sparse) {
+        const int BLOCK_SIZE = 256;
+        gpu::memsetZero(&_d_counters->x);
+        frontier::kernel::compactBitmapKernel
+            <<< xlib::ceil_div<BLOCK_SIZE>(_num_words), BLOCK_SIZE >>>
+            (_d_bitmap_ptrs.first, _num_words,
+             _d_queue_ptrs.first, &_d_counters->x);
+        CHECK_CUDA_ERROR
+        _has_sparse = true;
+    }
+    return _d_queue_ptrs.first;
+}
+
+template<typename T>
+const unsigned* Frontier<T>::device_input_bitmap() const noexcept {
+    if (!_has_dense) {
+        const int BLOCK_SIZE = 256;
+        gpu::memsetZero(_d_bitmap_ptrs.first, _num_words);
+        if (_h_counters.x > 0) {
+            frontier::kernel::fillBitmapKernel
+                <<< xlib::ceil_div<BLOCK_SIZE>(_h_counters.x), BLOCK_SIZE >>>
+                (_d_queue_ptrs.first, _h_counters.x,
+                 _d_bitmap_ptrs.first);
+            CHECK_CUDA_ERROR
+        }
+        _has_dense = true;
+    }
+    return _d_bitmap_ptrs.first;
+}
+
+template<typename T>
+int Frontier<T>::count_input() const noexcept {
+    const int BLOCK_SIZE = 256;
+    gpu::memsetZero(&_d_counters->x);
+    frontier::kernel::popcountKernel
+        <<< xlib::ceil_div<BLOCK_SIZE>(_num_words), BLOCK_SIZE >>>
+        (_d_bitmap_ptrs.first, _num_words, &_d_counters->x);
+    CHECK_CUDA_ERROR
+    cuMemcpyToHost(_d_counters, _h_counters);
+    return _h_counters.x;
+}
+
+template<typename T>
+void Frontier<T>::convert(FrontierMode mode) noexcept {
+    if (mode == _mode)
+        return;
+    if (mode == FrontierMode::DENSE) {
+        device_input_bitmap();
+        count_input();          //duplicates are removed
+        _has_sparse = false;
+    }
+    else
+        device_input_ptr();
+    _mode = mode;
+}
+
+//------------------------------------------------------------------------------
+
+template<typename T>
+int Frontier<T>::size() const noexcept {
+    return _h_counters.x;
+}
+
+template<typename T>
+FrontierMode Frontier<T>::mode() const noexcept {
+    return _mode;
+}
+
+template<typename T>
+FrontierMode Frontier<T>::output_mode() const noexcept {
+    return _output_mode;
+}
+
+template<typename T>
+int Frontier<T>::num_vertices() const noexcept {
+    return _num_vertices;
+}
+
+} // namespace hornets_nest
@@ -0,0 +1,36 @@
+/*
+ * Copyright (c) 2019, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+namespace hornets_nest {
+
+/**
+ * @brief representation of a set of vertices
+ * @details `SPARSE`: array of vertex ids, one atomic increment for each
+ *          insertion (aggregated by warp), may contain duplicates.
+ *          `DENSE`: bitmap of `nV` bits, one `atomicOr` for each insertion,
+ *          no duplicates, cost proportional to `nV / 32` for each level.
+ */
+enum class FrontierMode { SPARSE, DENSE };
+
+/**
+ * @brief how the representation of the next level is selected
+ * @details `AUTO`: dense when the current level covers more than
+ *          `dense_threshold` of the vertices, sparse otherwise
+ */
+enum class FrontierPolicy { AUTO, SPARSE, DENSE };
+
+} // namespace hornets_nest
@@ -0,0 +1,124 @@
+/*
+ * Copyright (c) 2019, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "Queue/FrontierMode.hpp"
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+namespace hornets_nest {
+namespace host {
+
+/**
+ * @brief Host counterpart of `hornets_nest::Frontier`
+ * @details `insert(item)` is thread-safe and targets the output level:
+ *          an atomic increment of the queue size when the output is sparse, an
+ *          atomic `fetch_or` on the bitmap when it is dense. The input level
+ *          is visited in parallel by `forEach()`.
+ * @tparam T vertex id type
+ */
+template<typename T>
+class Frontier {
+public:
+    static constexpr float DEFAULT_DENSE_THRESHOLD = 0.05f;
+
+    Frontier(int num_vertices, size_t max_allocated_items);
+
+    Frontier(const Frontier&) = delete;
+
+    Frontier& operator=(const Frontier&) = delete;
+
+    /**
+     * @brief insert a vertex in the output level
+     * @remark the method is thread-safe
+     */
+    void insert(const T& item) noexcept;
+
+    /**
+     * @brief insert a set of vertices in the input level
+     * @remark the method is not thread-safe
+     */
+    void insert(const T* items_array, int num_items) noexcept;
+
+    void swap() noexcept;
+
+    void clear() noexcept;
+
+    int size() const noexcept;
+
+    FrontierMode mode() const noexcept;
+
+    FrontierMode output_mode() const noexcept;
+
+    void set_policy(FrontierPolicy policy,
+                    float dense_threshold = DEFAULT_DENSE_THRESHOLD) noexcept;
+
+    void convert(FrontierMode mode) noexcept;
+
+    /**
+     * @brief input level as array of vertices
+     * @remark the bitmap is compacted if the input level is dense
+     */
+    const T* input_ptr() const noexcept;
+
+    /**
+     * @brief input level as bitmap of `ceil(nV / 32)` words
+     * @remark the bitmap is built if the input level is sparse
+     */
+    const std::atomic<unsigned>* input_bitmap() const noexcept;
+
+    /**
+     * @brief membership test on the input level
+     * @warning valid only after `input_bitmap()` has been called for the
+     *          current level, e.g. when `mode()` is `DENSE`
+     */
+    bool contains(const T& item) const noexcept;
+
+    /**
+     * @brief apply `op(vertex)` to all vertices of the input level
+     * @remark the method runs in parallel (OpenMP)
+     */
+    template<typename Operator>
+    void forEach(const Operator& op) const;
+
+    int num_vertices() const noexcept;
+
+private:
+    using bitmap_t = std::vector<std::atomic<unsigned>>;
+
+    mutable std::vector<T> _queues[2];
+    mutable bitmap_t       _bitmaps[2];
+    std::atomic<int>       _output_size         { 0 };
+    mutable int            _input_size          { 0 };
+
+    size_t         _max_allocated_items;
+    int            _num_vertices;
+    int            _num_words;
+    FrontierMode   _mode                { FrontierMode::SPARSE };
+    FrontierMode   _output_mode         { FrontierMode::SPARSE };
+    FrontierPolicy _policy              { FrontierPolicy::AUTO };
+    float          _dense_threshold     { DEFAULT_DENSE_THRESHOLD };
+    mutable bool   _has_sparse          { true };
+    mutable bool   _has_dense           { false };
+
+    void prepare_output() noexcept;
+};
+
+} // namespace host
+} // namespace hornets_nest
+
+#include "Queue/HostFrontier.i.hpp"
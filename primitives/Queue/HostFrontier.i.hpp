@@ -0,0 +1,226 @@
+/*
+ * Copyright (c) 2019, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <algorithm>
+#include <cassert>
+#include <omp.h>
+#include <utility>
+
+namespace hornets_nest {
+namespace host {
+
+template<typename T>
+Frontier<T>::Frontier(int num_vertices, size_t max_allocated_items) :
+                            _max_allocated_items(max_allocated_items),
+                            _num_vertices(num_vertices),
+                            _num_words((num_vertices + 31) / 32) {
+    for (int i = 0; i < 2; i++) {
+        _queues[i].resize(max_allocated_items);
+        _bitmaps[i] = bitmap_t(_num_words);
+    }
+    clear();
+}
+
+//------------------------------------------------------------------------------
+
+template<typename T>
+void Frontier<T>::insert(const T& item) noexcept {
+    if (_output_mode == FrontierMode::DENSE) {
+        _bitmaps[1][item / 32].fetch_or(1u << (item % 32),
+                                        std::memory_order_relaxed);
+        return;
+    }
+    auto offset = _output_size.fetch_add(1, std::memory_order_relaxed);
+    assert(static_cast<size_t>(offset) < _max_allocated_items &&
+           "Frontier too small");
+    _queues[1][offset] = item;
+}
+
+template<typename T>
+void Frontier<T>::insert(const T* items_array, int num_items) noexcept {
+    convert(FrontierMode::SPARSE);
+    _has_dense = false;
+    assert(static_cast<size_t>(_input_size + num_items) <=
+           _max_allocated_items &&
+           "Frontier too small");
+    std::copy(items_array, items_array + num_items,
+              _queues[0].begin() + _input_size);
+    _input_size += num_items;
+    prepare_output();
+}
+
+template<typename T>
+void Frontier<T>::swap() noexcept {
+    std::swap(_queues[0], _queues[1]);
+    std::swap(_bitmaps[0], _bitmaps[1]);
+    _mode       = _output_mode;
+    _has_sparse = _mode == FrontierMode::SPARSE;
+    _has_dense  = _mode == FrontierMode::DENSE;
+
+    if (_mode == FrontierMode::DENSE) {
+        int count = 0;
+        #pragma omp parallel for reduction(+ : count)
+        for (int i = 0; i < _num_words; i++)
+            count += __builtin_popcount(_bitmaps[0][i].load(
+                                        std::memory_order_relaxed));
+        _input_size = count;
+    }
+    else
+        _input_size = _output_size.load();
+    _output_size = 0;
+    prepare_output();
+}
+
+template<typename T>
+void Frontier<T>::clear() noexcept {
+    _input_size  = 0;
+    _output_size = 0;
+    _mode        = FrontierMode::SPARSE;
+    _has_sparse  = true;
+    _has_dense   = false;
+    prepare_output();
+}
+
+template<typename T>
+void Frontier<T>::prepare_output() noexcept {
+    switch (_policy) {
+        case FrontierPolicy::SPARSE: _output_mode = FrontierMode::SPARSE; break;
+        case FrontierPolicy::DENSE:  _output_mode = FrontierMode::DENSE;  break;
+        case FrontierPolicy::AUTO:
+            _output_mode = _input_size > _dense_threshold * _num_vertices ?
+                           FrontierMode::DENSE : FrontierMode::SPARSE;
+    }
+    if (_output_mode == FrontierMode::DENSE) {
+        auto& bitmap = _bitmaps[1];
+        #pragma omp parallel for
+        for (int i = 0; i < _num_words; i++)
+            bitmap[i].store(0, std::memory_order_relaxed);
+    }
+}
+
+template<typename T>
+void Frontier<T>::set_policy(FrontierPolicy policy, float dense_threshold)
+                             noexcept {
+    _policy          = policy;
+    _dense_threshold = dense_threshold;
+    prepare_output();
+}
+
+//------------------------------------------------------------------------------
+
+template<typename T>
+const T* Frontier<T>::input_ptr() const noexcept {
+    if (!_has_sparse) {
+        //sequential compaction keeps the vertices sorted
+        int size = 0;
+        for (int i = 0; i < _num_words; i++) {
+            unsigned word = _bitmaps[0][i].load(std::memory_order_relaxed);
+            while (word != 0) {
+                int bit = __builtin_ctz(word);
+                word   &= word - 1;
+                _queues[0][size++] = static_cast<T>(i * 32 + bit);
+            }
+        }
+        _input_size = size;
+        _has_sparse = true;
+    }
+    return _queues[0].data();
+}
+
+template<typename T>
+const std::atomic<unsigned>* Frontier<T>::input_bitmap() const noexcept {
+    if (!_has_dense) {
+        auto& bitmap = _bitmaps[0];
+        const auto& queue = _queues[0];
+        #pragma omp parallel for
+        for (int i = 0; i < _num_words; i++)
+            bitmap[i].store(0, std::memory_order_relaxed);
+        #pragma omp parallel for
+        for (int i = 0; i < _input_size; i++) {
+            bitmap[queue[i] / 32].fetch_or(1u << (queue[i] % 32),
+                                           std::memory_order_relaxed);
+        }
+        _has_dense = true;
+    }
+    return _bitmaps[0].data();
+}
+
+template<typename T>
+void Frontier<T>::convert(FrontierMode mode) noexcept {
+    if (mode == _mode)
+        return;
+    if (mode == FrontierMode::DENSE) {
+        input_bitmap();
+        //the compaction removes the duplicates from the count
+        _has_sparse = false;
+        input_ptr();
+    }
+    else
+        input_ptr();
+    _mode = mode;
+}
+
+template<typename T>
+bool Frontier<T>::contains(const T& item) const noexcept {
+    return _bitmaps[0][item / 32].load(std::memory_order_relaxed) &
+           (1u << (item % 32));
+}
+
+template<typename T>
+template<typename Operator>
+void Frontier<T>::forEach(const Operator& op) const {
+    if (_mode == FrontierMode::SPARSE) {
+        const auto& queue = _queues[0];
+        #pragma omp parallel for
+        for (int i = 0; i < _input_size; i++)
+            op(queue[i]);
+        return;
+    }
+    const auto& bitmap = _bitmaps[0];
+    #pragma omp parallel for schedule(dynamic, 64)
+    for (int i = 0; i < _num_words; i++) {
+        unsigned word = bitmap[i].load(std::memory_order_relaxed);
+        while (word != 0) {
+            int bit = __builtin_ctz(word);
+            word   &= word - 1;
+            op(static_cast<T>(i * 32 + bit));
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+
+template<typename T>
+int Frontier<T>::size() const noexcept {
+    return _input_size;
+}
+
+template<typename T>
+FrontierMode Frontier<T>::mode() const noexcept {
+    return _mode;
+}
+
+template<typename T>
+FrontierMode Frontier<T>::output_mode() const noexcept {
+    return _output_mode;
+}
+
+template<typename T>
+int Frontier<T>::num_vertices() const noexcept {
+    return _num_vertices;
+}
+
+} // namespace host
+} // namespace hornets_nest
@@ -0,0 +1,144 @@
+/*
+ * Copyright (c) 2019, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+namespace hornets_nest {
+namespace host {
+
+/**
+ * @brief Concurrent two-level queue for host (OpenMP) traversals
+ * @details Same interface as `hornets_nest::TwoLevelQueue`. Every OpenMP
+ *          thread appends to its own buffer of `BUFFER_SIZE` items; a full
+ *          buffer is flushed to the output level with a single `fetch_add` on
+ *          the shared cursor, so there is no lock and one atomic operation
+ *          every `BUFFER_SIZE` insertions. `swap()` flushes the partial
+ *          buffers and exchanges the two levels in O(1).
+ *          When built with `num_vertices > 0` the queue keeps a visited bitmap
+ *          and every item is enqueued at most once until `clear()`.
+ * @tparam T type of objects stored in the queue (vertex id with
+ *         deduplication)
+ * @warning `insert(item)` must be called from the master thread or from the
+ *          threads of an OpenMP parallel region
+ */
+template<typename T>
+class TwoLevelQueue {
+public:
+    static const int BUFFER_SIZE = 256;
+
+    /**
+     * @param[in] max_allocated_items number of allocated items for a single
+     *            level of the queue
+     * @param[in] num_vertices size of the visited bitmap, 0 disables the
+     *            deduplication
+     */
+    explicit TwoLevelQueue(size_t max_allocated_items, int num_vertices = 0);
+
+    TwoLevelQueue(const TwoLevelQueue&) = delete;
+
+    TwoLevelQueue& operator=(const TwoLevelQueue&) = delete;
+
+    /**
+     * @brief insert an item in the output level
+     * @remark the method is thread-safe and lock-free
+     */
+    void insert(const T& item) noexcept;
+
+    /**
+     * @brief insert a set of items in the input level
+     * @remark the method is not thread-safe
+     */
+    void insert(const T* items_array, int num_items) noexcept;
+
+    /**
+     * @brief flush the thread buffers and swap input and output level
+     * @remark the method must be called outside parallel regions
+     */
+    void swap() noexcept;
+
+    /**
+     * @brief empty both levels and the visited bitmap
+     */
+    void clear() noexcept;
+
+    /**
+     * @brief flush the thread buffers to the output level
+     * @remark the method must be called outside parallel regions
+     */
+    void sync() noexcept;
+
+    int size() const noexcept;
+
+    /**
+     * @warning the items still in the thread buffers are not counted before
+     *          `sync()`
+     */
+    int output_size() const noexcept;
+
+    const T* input_ptr() const noexcept;
+
+    const T* output_ptr() const noexcept;
+
+    /**
+     * @brief `true` if the item has been inserted since the last `clear()`
+     * @remark available only with deduplication
+     */
+    bool is_visited(const T& item) const noexcept;
+
+    /**
+     * @brief apply `op(item)` to all items of the input level
+     * @remark the method runs in parallel (OpenMP)
+     */
+    template<typename Operator>
+    void forEach(const Operator& op) const;
+
+    /**
+     * @brief total enqueue items
+     */
+    int enqueue_items() const noexcept;
+
+    void print() const noexcept;
+
+private:
+    static const int CACHE_LINE = 64;
+
+    //one cache line per thread: `size` is written at every insertion.
+    //std::vector does not honor over-alignment before C++17, the padding
+    //keeps the buffers of two threads apart for any base address
+    struct alignas(CACHE_LINE) ThreadBuffer {
+        int  size;
+        T    items[BUFFER_SIZE];
+        char padding[CACHE_LINE];
+    };
+
+    std::vector<T>                     _queues[2];
+    std::vector<ThreadBuffer>          _buffers;
+    std::vector<std::atomic<unsigned>> _visited;
+    std::atomic<int>                   _cursor        { 0 };
+    int                                _input_size    { 0 };
+    int                                _enqueue_items { 0 };
+    size_t                             _max_allocated_items;
+
+    void flush(ThreadBuffer& buffer) noexcept;
+};
+
+} // namespace host
+} // namespace hornets_nest
+
+#include "Queue/HostTwoLevelQueue.i.hpp"
@@ -0,0 +1,157 @@
+/*
+ * Copyright (c) 2019, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <algorithm>
+#include <cassert>
+#include <iostream>
+#include <omp.h>
+
+namespace hornets_nest {
+namespace host {
+
+template<typename T>
+TwoLevelQueue<T>::TwoLevelQueue(size_t max_allocated_items, int num_vertices) :
+                            _queues { std::vector<T>(max_allocated_items),
+                                      std::vector<T>(max_allocated_items) },
+                            _buffers(omp_get_max_threads()),
+                            _visited((num_vertices + 31) / 32),
+                            _max_allocated_items(max_allocated_items) {
+    clear();
+}
+
+//------------------------------------------------------------------------------
+
+template<typename T>
+void TwoLevelQueue<T>::insert(const T& item) noexcept {
+    if (!_visited.empty()) {
+        unsigned mask = 1u << (item % 32);
+        if (_visited[item / 32].fetch_or(mask, std::memory_order_relaxed) &
+            mask)
+            return;
+    }
+    assert(omp_get_thread_num() < static_cast<int>(_buffers.size()));
+    auto& buffer = _buffers[omp_get_thread_num()];
+    buffer.items[buffer.size++] = item;
+    if (buffer.size == BUFFER_SIZE)
+        flush(buffer);
+}
+
+template<typename T>
+void TwoLevelQueue<T>::flush(ThreadBuffer& buffer) noexcept {
+    int offset = _cursor.fetch_add(buffer.size, std::memory_order_relaxed);
+    assert(static_cast<size_t>(offset + buffer.size) <=
+           _max_allocated_items && "TwoLevelQueue too small");
+    std::copy(buffer.items, buffer.items + buffer.size,
+              _queues[1].data() + offset);
+    buffer.size = 0;
+}
+
+template<typename T>
+void TwoLevelQueue<T>::insert(const T* items_array, int num_items) noexcept {
+    assert(static_cast<size_t>(_input_size + num_items) <=
+           _max_allocated_items && "TwoLevelQueue too small");
+    int size = _input_size;
+    for (int i = 0; i < num_items; i++) {
+        const auto& item = items_array[i];
+        if (!_visited.empty()) {
+            unsigned mask = 1u << (item % 32);
+            if (_visited[item / 32].fetch_or(mask) & mask)
+                continue;
+        }
+        _queues[0][size++] = item;
+    }
+    _enqueue_items += size - _input_size;
+    _input_size     = size;
+}
+
+template<typename T>
+void TwoLevelQueue<T>::sync() noexcept {
+    for (auto& buffer : _buffers) {
+        if (buffer.size > 0)
+            flush(buffer);
+    }
+}
+
+template<typename T>
+void TwoLevelQueue<T>::swap() noexcept {
+    sync();
+    _queues[0].swap(_queues[1]);
+    _input_size     = _cursor.exchange(0);
+    _enqueue_items += _input_size;
+}
+
+template<typename T>
+void TwoLevelQueue<T>::clear() noexcept {
+    for (auto& buffer : _buffers)
+        buffer.size = 0;
+    for (auto& word : _visited)
+        word.store(0, std::memory_order_relaxed);
+    _cursor        = 0;
+    _input_size    = 0;
+    _enqueue_items = 0;
+}
+
+//------------------------------------------------------------------------------
+
+template<typename T>
+int TwoLevelQueue<T>::size() const noexcept {
+    return _input_size;
+}
+
+template<typename T>
+int TwoLevelQueue<T>::output_size() const noexcept {
+    return _cursor.load();
+}
+
+template<typename T>
+const T* TwoLevelQueue<T>::input_ptr() const noexcept {
+    return _queues[0].data();
+}
+
+template<typename T>
+const T* TwoLevelQueue<T>::output_ptr() const noexcept {
+    return _queues[1].data();
+}
+
+template<typename T>
+bool TwoLevelQueue<T>::is_visited(const T& item) const noexcept {
+    assert(!_visited.empty());
+    return _visited[item / 32].load(std::memory_order_relaxed) &
+           (1u << (item % 32));
+}
+
+template<typename T>
+template<typename Operator>
+void TwoLevelQueue<T>::forEach(const Operator& op) const {
+    const auto& queue = _queues[0];
+    #pragma omp parallel for
+    for (int i = 0; i < _input_size; i++)
+        op(queue[i]);
+}
+
+template<typename T>
+int TwoLevelQueue<T>::enqueue_items() const noexcept {
+    return _enqueue_items;
+}
+
+template<typename T>
+void TwoLevelQueue<T>::print() const noexcept {
+    for (int i = 0; i < _input_size; i++)
+        std::cout << _queues[0][i] << " ";
+    std::cout << "\n";
+}
+
+} // namespace host
+} // namespace hornets_nest
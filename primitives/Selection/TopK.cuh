@@ -0,0 +1,165 @@
+/*
+ * Copyright (c) 2019, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <thrust/device_vector.h>
+#include <HostDevice.hpp>
+#include <type_traits>
+
+namespace hornets_nest {
+
+/**
+ * @brief Order-preserving mapping of keys to unsigned integers
+ * @details `encode(a) < encode(b)` iff `a < b` and `encode(a) == encode(b)`
+ *          iff `a == b` (-0.0 and +0.0 have the same key), so the k-th
+ *          largest key is found one radix digit at a time
+ * @remark NaN keys are not allowed
+ */
+template<typename T, typename = void>
+struct RadixKey;
+
+template<typename T>
+struct RadixKey<T, typename std::enable_if<std::is_integral<T>::value>::type> {
+    using UnsignedT = typename std::make_unsigned<T>::type;
+
+    HOST_DEVICE
+    static UnsignedT encode(T value);
+
+    HOST_DEVICE
+    static T decode(UnsignedT key);
+};
+
+template<>
+struct RadixKey<float> {
+    using UnsignedT = unsigned;
+
+    HOST_DEVICE
+    static UnsignedT encode(float value);
+
+    HOST_DEVICE
+    static float decode(UnsignedT key);
+};
+
+template<>
+struct RadixKey<double> {
+    using UnsignedT = unsigned long long;
+
+    HOST_DEVICE
+    static UnsignedT encode(double value);
+
+    HOST_DEVICE
+    static double decode(UnsignedT key);
+};
+
+//==============================================================================
+
+/**
+ * @brief k-selection on the device (radix-select)
+ * @details The K-th largest key is found with one histogram pass for each
+ *          8-bit digit, from the most significant one. Only the keys which
+ *          share the digits already fixed are counted; when they are a small
+ *          fraction of the input they are compacted in an internal buffer
+ *          (bucket-select), so that later passes only read the candidates.
+ *          Unlike a full sort, no key is moved more than once.
+ * @tparam T key type (integral, `float` or `double`, without NaNs)
+ */
+template<typename T>
+class TopK {
+public:
+    /**
+     * @brief Default costructor
+     * @param[in] max_items largest input expected. The buffers grow on
+     *            demand, the parameter only avoids reallocations
+     */
+    explicit TopK(size_t max_items = 0) noexcept;
+
+    /**
+     * @brief K-th largest key of the input
+     * @param[in] d_keys device array of keys
+     * @param[in] num_items number of keys
+     * @param[in] k rank of the key to find (1 is the largest)
+     * @return the K-th largest key
+     * @remark `1 <= k <= num_items`
+     */
+    T kthLargest(const T* d_keys, int num_items, int k);
+
+    /**
+     * @brief K-th smallest key of the input
+     * @see kthLargest
+     */
+    T kthSmallest(const T* d_keys, int num_items, int k);
+
+    /**
+     * @brief Selects the K largest keys
+     * @param[in]  d_keys device array of keys
+     * @param[in]  d_ids device array of the ids associated to the keys, if
+     *             `nullptr` the id is the position of the key
+     * @param[in]  num_items number of keys
+     * @param[in]  k number of keys to select
+     * @param[out] d_output_ids device array of (at least) `k` ids. The ids are
+     *             not ordered; ties at the threshold are broken arbitrarily
+     * @return the K-th largest key (the selection threshold)
+     */
+    template<typename id_t>
+    T select(const T* d_keys, const id_t* d_ids, int num_items, int k,
+             id_t* d_output_ids);
+
+private:
+    using UnsignedT = typename RadixKey<T>::UnsignedT;
+
+    static const int      RADIX_BITS = 8;
+    static const int      RADIX      = 1 << RADIX_BITS;
+    static const unsigned BLOCK_SIZE = 256;
+    ///@internal @brief candidates are compacted below `num_items / COMPACT`
+    static const int      COMPACT    = 16;
+
+    thrust::device_vector<T>   d_candidates[2];
+    thrust::device_vector<int> d_histogram;
+    thrust::device_vector<int> d_counters;
+
+    ///@internal @brief tie keys (== threshold) which belong to the top-k
+    int _num_ties { 0 };
+
+    UnsignedT radixSelect(const T* d_keys, int num_items, int k);
+};
+
+//==============================================================================
+
+namespace host {
+
+/**
+ * @brief K-th largest key of a host array
+ * @details every thread keeps the K largest keys of its chunk
+ *          (`std::nth_element`), the threshold is selected among them
+ * @remark `1 <= k <= num_items`
+ */
+template<typename T>
+T kthLargest(const T* keys, int num_items, int k);
+
+/**
+ * @brief Selects the K largest keys of a host array
+ * @param[out] output_ids array of (at least) `k` ids, not ordered
+ * @return the K-th largest key
+ * @see TopK::select
+ */
+template<typename T, typename id_t>
+T topK(const T* keys, const id_t* ids, int num_items, int k,
+       id_t* output_ids);
+
+} // namespace host
+} // namespace hornets_nest
+
+#include "Selection/TopK.i.cuh"
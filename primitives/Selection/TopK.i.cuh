@@ -0,0 +1,238 @@
+/*
+ * Copyright (c) 2019, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "TopKKernel.cuh"
+#include "StandardAPI.hpp"
+#include <Device/Util/DeviceProperties.cuh>  //xlib::DeviceProperty
+#include <Device/Util/SafeCudaAPI.cuh>       //CHECK_CUDA_ERROR
+#include <Host/Numeric.hpp>                  //xlib::ceil_div
+#include <thrust/fill.h>
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <functional>
+#include <vector>
+#include <omp.h>
+
+namespace hornets_nest {
+
+template<typename T>
+HOST_DEVICE
+typename RadixKey<T, typename std::enable_if<std::is_integral<T>::value>::type>
+    ::UnsignedT
+RadixKey<T, typename std::enable_if<std::is_integral<T>::value>::type>
+::encode(T value) {
+    const UnsignedT SIGN = std::is_signed<T>::value ?
+                           UnsignedT(1) << (sizeof(T) * 8 - 1) : 0;
+    return static_cast<UnsignedT>(value) ^ SIGN;
+}
+
+template<typename T>
+HOST_DEVICE
+T RadixKey<T, typename std::enable_if<std::is_integral<T>::value>::type>
+::decode(UnsignedT key) {
+    const UnsignedT SIGN = std::is_signed<T>::value ?
+                           UnsignedT(1) << (sizeof(T) * 8 - 1) : 0;
+    return static_cast<T>(key ^ SIGN);
+}
+
+// negative floating point values are stored as sign-magnitude: all their bits
+// are flipped, while only the sign bit is flipped for the positive ones.
+// -0.0 is encoded as +0.0: the selection compares the keys, they are equal
+HOST_DEVICE
+unsigned RadixKey<float>::encode(float value) {
+    unsigned bits;
+    memcpy(&bits, &value, sizeof(float));
+    if (bits == 0x80000000u)
+        bits = 0;
+    return bits ^ ((bits & 0x80000000u) ? 0xFFFFFFFFu : 0x80000000u);
+}
+
+HOST_DEVICE
+float RadixKey<float>::decode(unsigned key) {
+    unsigned bits = key ^ ((key & 0x80000000u) ? 0x80000000u : 0xFFFFFFFFu);
+    float value;
+    memcpy(&value, &bits, sizeof(float));
+    return value;
+}
+
+HOST_DEVICE
+unsigned long long RadixKey<double>::encode(double value) {
+    const unsigned long long SIGN = 1ull << 63;
+    unsigned long long bits;
+    memcpy(&bits, &value, sizeof(double));
+    if (bits == SIGN)                   //-0.0
+        bits = 0;
+    return bits ^ ((bits & SIGN) ? ~0ull : SIGN);
+}
+
+HOST_DEVICE
+double RadixKey<double>::decode(unsigned long long key) {
+    const unsigned long long SIGN = 1ull << 63;
+    unsigned long long bits = key ^ ((key & SIGN) ? SIGN : ~0ull);
+    double value;
+    memcpy(&value, &bits, sizeof(double));
+    return value;
+}
+
+//==============================================================================
+
+template<typename T>
+TopK<T>::TopK(size_t max_items) noexcept : d_histogram(RADIX),
+                                           d_counters(2) {
+    d_candidates[0].reserve(max_items / COMPACT);
+    d_candidates[1].reserve(max_items / COMPACT);
+}
+
+template<typename T>
+typename TopK<T>::UnsignedT
+TopK<T>::radixSelect(const T* d_keys, int num_items, int k) {
+    const int NUM_BITS   = sizeof(UnsignedT) * 8;
+    const int MAX_BLOCKS = xlib::DeviceProperty::resident_threads() /
+                           BLOCK_SIZE;
+    int h_histogram[RADIX];
+
+    UnsignedT prefix   = 0;
+    UnsignedT mask     = 0;
+    const T* d_input   = d_keys;
+    int num_candidates = num_items;
+    int buffer         = 0;
+
+    for (int shift = NUM_BITS - RADIX_BITS; shift >= 0; shift -= RADIX_BITS) {
+        int num_blocks = std::min(xlib::ceil_div<BLOCK_SIZE>(num_candidates),
+                                  MAX_BLOCKS);
+        thrust::fill(d_histogram.begin(), d_histogram.end(), 0);
+        top_k::kernel::histogramKernel<BLOCK_SIZE, RADIX>
+            <<< num_blocks, BLOCK_SIZE >>>
+            (d_input, num_candidates, prefix, mask, shift,
+             d_histogram.data().get());
+        CHECK_CUDA_ERROR
+        gpu::copyToHost(d_histogram.data().get(), RADIX, h_histogram);
+
+        // the bucket of the K-th largest key, from the largest digit
+        int digit = RADIX - 1;
+        while (h_histogram[digit] < k) {
+            k -= h_histogram[digit];
+            digit--;
+        }
+        prefix |= static_cast<UnsignedT>(digit) << shift;
+        mask   |= static_cast<UnsignedT>(RADIX - 1) << shift;
+
+        int bucket_size = h_histogram[digit];
+        if (shift > 0 && bucket_size <= num_candidates / COMPACT) {
+            auto& d_output = d_candidates[buffer];
+            if (d_output.size() < static_cast<size_t>(bucket_size))
+                d_output.resize(bucket_size);
+            thrust::fill(d_counters.begin(), d_counters.end(), 0);
+            top_k::kernel::compactKernel
+                <<< num_blocks, BLOCK_SIZE >>>
+                (d_input, num_candidates, prefix, mask,
+                 d_output.data().get(), d_counters.data().get());
+            CHECK_CUDA_ERROR
+            d_input        = d_output.data().get();
+            num_candidates = bucket_size;
+            buffer        ^= 1;
+        }
+    }
+    // keys equal to the threshold which are part of the top-k
+    _num_ties = k;
+    return prefix;
+}
+
+template<typename T>
+T TopK<T>::kthLargest(const T* d_keys, int num_items, int k) {
+    assert(k >= 1 && k <= num_items && "TopK: k out of range");
+    return RadixKey<T>::decode(radixSelect(d_keys, num_items, k));
+}
+
+template<typename T>
+T TopK<T>::kthSmallest(const T* d_keys, int num_items, int k) {
+    return kthLargest(d_keys, num_items, num_items - k + 1);
+}
+
+template<typename T>
+template<typename id_t>
+T TopK<T>::select(const T* d_keys, const id_t* d_ids, int num_items, int k,
+                  id_t* d_output_ids) {
+    T threshold = kthLargest(d_keys, num_items, k);
+
+    thrust::fill(d_counters.begin(), d_counters.end(), 0);
+    top_k::kernel::selectKernel
+        <<< xlib::ceil_div<BLOCK_SIZE>(num_items), BLOCK_SIZE >>>
+        (d_keys, d_ids, num_items, threshold, k - _num_ties, _num_ties,
+         d_output_ids, d_counters.data().get());
+    CHECK_CUDA_ERROR
+    return threshold;
+}
+
+//==============================================================================
+
+namespace host {
+
+template<typename T>
+T kthLargest(const T* keys, int num_items, int k) {
+    assert(k >= 1 && k <= num_items && "kthLargest: k out of range");
+    int num_threads = std::min(omp_get_max_threads(),
+                               std::max(num_items / k, 1));
+    int chunk_size  = xlib::ceil_div(num_items, num_threads);
+    std::vector<std::vector<T>> local_top(num_threads);
+
+    #pragma omp parallel for num_threads(num_threads)
+    for (int i = 0; i < num_threads; i++) {
+        int begin = i * chunk_size;
+        int end   = std::min(begin + chunk_size, num_items);
+        if (begin >= end)
+            continue;
+        auto& top = local_top[i];
+        top.assign(keys + begin, keys + end);
+        if (static_cast<int>(top.size()) > k) {
+            std::nth_element(top.begin(), top.begin() + (k - 1), top.end(),
+                             std::greater<T>());
+            top.resize(k);
+        }
+    }
+    std::vector<T> candidates;
+    for (const auto& top : local_top)
+        candidates.insert(candidates.end(), top.begin(), top.end());
+
+    std::nth_element(candidates.begin(), candidates.begin() + (k - 1),
+                     candidates.end(), std::greater<T>());
+    return candidates[k - 1];
+}
+
+template<typename T, typename id_t>
+T topK(const T* keys, const id_t* ids, int num_items, int k,
+       id_t* output_ids) {
+    T threshold = kthLargest(keys, num_items, k);
+
+    int num_greater = 0;
+    #pragma omp parallel for reduction(+ : num_greater)
+    for (int i = 0; i < num_items; i++)
+        num_greater += (keys[i] > threshold);
+
+    int greater_pos = 0;
+    int tie_pos     = num_greater;
+    for (int i = 0; i < num_items; i++) {
+        id_t id = ids != nullptr ? ids[i] : static_cast<id_t>(i);
+        if (keys[i] > threshold)
+            output_ids[greater_pos++] = id;
+        else if (keys[i] == threshold && tie_pos < k)
+            output_ids[tie_pos++] = id;
+    }
+    return threshold;
+}
+
+} // namespace host
+} // namespace hornets_nest
@@ -0,0 +1,103 @@
+/*
+ * Copyright (c) 2019, NVIDIA CORPORATION.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+namespace hornets_nest {
+namespace top_k {
+namespace kernel {
+
+/*
+ * histogram of the digit at `shift` of the keys matching `prefix` on `mask`
+ */
+template<unsigned BLOCK_SIZE, int RADIX, typename T, typename UnsignedT>
+__global__
+void histogramKernel(const T*   __restrict__ d_keys,
+                     int                     num_items,
+                     UnsignedT               prefix,
+                     UnsignedT               mask,
+                     int                     shift,
+                     int*       __restrict__ d_histogram) {
+    __shared__ int histogram[RADIX];
+    for (int i = threadIdx.x; i < RADIX; i += BLOCK_SIZE)
+        histogram[i] = 0;
+    __syncthreads();
+
+    int     id = blockIdx.x * BLOCK_SIZE + threadIdx.x;
+    int stride = gridDim.x * BLOCK_SIZE;
+    for (int i = id; i < num_items; i += stride) {
+        auto key = RadixKey<T>::encode(d_keys[i]);
+        if ((key & mask) == prefix)
+            atomicAdd(histogram + ((key >> shift) & (RADIX - 1)), 1);
+    }
+    __syncthreads();
+
+    for (int i = threadIdx.x; i < RADIX; i += BLOCK_SIZE) {
+        if (histogram[i] != 0)
+            atomicAdd(d_histogram + i, histogram[i]);
+    }
+}
+
+template<typename T, typename UnsignedT>
+__global__
+void compactKernel(const T* __restrict__ d_keys,
+                   int                   num_items,
+                   UnsignedT             prefix,
+                   UnsignedT             mask,
+                   T*       __restrict__ d_output,
+                   int*     __restrict__ d_counter) {
+    int     id = blockIdx.x * blockDim.x + threadIdx.x;
+    int stride = gridDim.x * blockDim.x;
+    for (int i = id; i < num_items; i += stride) {
+        auto value = d_keys[i];
+        if ((RadixKey<T>::encode(value) & mask) == prefix)
+            d_output[atomicAdd(d_counter, 1)] = value;
+    }
+}
+
+/*
+ * d_counters[0]: keys above the threshold, d_counters[1]: ties
+ */
+template<typename T, typename id_t>
+__global__
+void selectKernel(const T*    __restrict__ d_keys,
+                  const id_t* __restrict__ d_ids,
+                  int                      num_items,
+                  T                        threshold,
+                  int                      num_greater,
+                  int                      num_ties,
+                  id_t*       __restrict__ d_output_ids,
+                  int*        __restrict__ d_counters) {
+    int     id = blockIdx.x * blockDim.x + threadIdx.x;
+    int stride = gridDim.x * blockDim.x;
+    for (int i = id; i < num_items; i += stride) {
+        auto key = d_keys[i];
+        if (key > threshold) {
+            id_t value = d_ids != nullptr ? d_ids[i] : static_cast<id_t>(i);
+            d_output_ids[atomicAdd(d_counters, 1)] = value;
+        }
+        else if (key == threshold) {
+            int pos = atomicAdd(d_counters + 1, 1);
+            if (pos < num_ties) {
+                id_t value = d_ids != nullptr ? d_ids[i] : static_cast<id_t>(i);
+                d_output_ids[num_greater + pos] = value;
+            }
+        }
+    }
+}
+
+} // namespace kernel
+} // namespace top_k
+} // namespace hornets_nest